@@ -54,28 +54,60 @@ namespace CMEngine::Editor
 			
 		Asset::AssetManager& assetManager = m_Core.AssetManager();
 
+		/* Written by Tools/AssetPacker, (from the assets directory) and loaded from instead of the loose files if present. */
+		constexpr std::wstring_view PackName = ENGINE_EDITOR_RESOURCES_DIRECTORYW L".cmpak";
+
+		if (std::filesystem::exists(PackName))
+			assetManager.MountPack(PackName, ENGINE_EDITOR_RESOURCES_DIRECTORYW);
+
 		constexpr std::string_view MeshName = ENGINE_EDITOR_RESOURCES_MODEL_DIRECTORY "/test_cube.glb";
 
 		/* TODO: Fix weird DeadlyImportError exception... */
-		Asset::AssetID modelID;
-		Asset::Result result = assetManager.LoadModel(MeshName, modelID);
+		Asset::ImportOptions importOptions;
+		importOptions.QuantizeVertices = true;
+		importOptions.BuildMeshlets = true;
+
+		/* Imported in the background, so the game objects are only drawn once their mesh is registered. */
+		assetManager.LoadModelAsync(
+			MeshName,
+			importOptions,
+			[this, gameObj1, gameObj2](Asset::Result result, Asset::AssetID modelID)
+			{
+				CM_ENGINE_ASSERT(result.Succeeded());
+
+				if (!result)
+					return;
+
+				m_ModelID = modelID;
+
+				ECS::ECS& ecs = m_Core.ECS();
+				Asset::AssetManager& assetManager = m_Core.AssetManager();
+
+				ConstView<Asset::Model> model;
+				assetManager.GetModel(modelID, model);
 
-		CM_ENGINE_ASSERT(result.Succeeded());
+				CM_ENGINE_ASSERT(model.NonNull());
 
-		ConstView<Asset::Model> model;
-		assetManager.GetModel(modelID, model);
+				Asset::AssetID meshID = model->Meshes.at(0);
+				Asset::AssetID materialID = model->Materials.at(0);
 
-		CM_ENGINE_ASSERT(model.NonNull());
+				ConstView<Asset::Mesh> meshAsset;
+				assetManager.GetMesh(meshID, meshAsset);
 
-		Asset::AssetID meshID = model->Meshes.at(0);
-		Asset::AssetID materialID = model->Materials.at(0);
+				CM_ENGINE_ASSERT(meshAsset.NonNull());
 
-		ConstView<Asset::Mesh> meshAsset;
-		assetManager.GetMesh(meshID, meshAsset);
+				assetManager.DumpMesh(meshID);
 
-		CM_ENGINE_ASSERT(meshAsset.NonNull());
+				ecs.EmplaceComponent<MeshComponent>(gameObj1, meshID);
+				ecs.EmplaceComponent<MeshComponent>(gameObj2, meshID);
+				ecs.EmplaceComponent<MaterialComponent>(gameObj1, materialID);
+				ecs.EmplaceComponent<MaterialComponent>(gameObj2, materialID);
 
-		assetManager.DumpMesh(meshID);
+				auto mesh = ecs.GetComponent<MeshComponent>(gameObj1);
+
+				m_Core.Renderer().GetBatchRenderer().SubmitMesh(mesh);
+			}
+		);
 
 		/* Default construct components to avoid extra copying... */
 		ecs.EmplaceComponent<CameraComponent>(cameraEntity);
@@ -183,14 +215,7 @@ namespace CMEngine::Editor
 		gObj1Transform.CreateModelMatrix();
 		gObj2Transform.CreateModelMatrix();
 
-		ecs.EmplaceComponent<MeshComponent>(gameObj1, meshID);
-		ecs.EmplaceComponent<MeshComponent>(gameObj2, meshID);
-		ecs.EmplaceComponent<MaterialComponent>(gameObj1, materialID);
-		ecs.EmplaceComponent<MaterialComponent>(gameObj2, materialID);
-
-		auto mesh = ecs.GetComponent<MeshComponent>(gameObj1);
-
-		m_Core.Renderer().GetBatchRenderer().SubmitMesh(mesh);
+		ecs.EmplaceComponent<OccluderComponent>(gameObj1);
 
 		Scene::SceneManager& sceneManager = m_Core.SceneManager();
 
@@ -221,19 +246,16 @@ namespace CMEngine::Editor
 		constexpr std::wstring_view TexturePath = ENGINE_EDITOR_RESOURCES_TEXTURE_DIRECTORYW L"/basic_texture.png";
 		std::filesystem::path texturePath(TexturePath);
 
-		Asset::AssetID textureID;
-		result = assetManager.LoadTexture(texturePath, textureID);
-		CM_ENGINE_ASSERT(result.Succeeded());
-
-		ConstView<Asset::Texture> textureAsset;
-		assetManager.GetTexture(textureID, textureAsset);
-		CM_ENGINE_ASSERT(textureAsset.NonNull());
+		assetManager.LoadTextureAsync(
+			texturePath,
+			[this, gameObj2](Asset::Result result, Asset::AssetID textureID)
+			{
+				CM_ENGINE_ASSERT(result.Succeeded());
 
-		Resource<ITexture> texture = platform.GetGraphics().CreateTexture(
-			std::span<std::byte>(textureAsset->pBuffer.get(), textureAsset->SizeBytes)
+				if (result)
+					m_Core.ECS().EmplaceComponent<TextureComponent>(gameObj2, textureID);
+			}
 		);
-
-		ecs.EmplaceComponent<TextureComponent>(gameObj2, textureID, std::move(texture));
 	}
 
 	Editor::~Editor() noexcept
@@ -242,6 +264,9 @@ namespace CMEngine::Editor
 		auto& eventSystem = m_Core.EventSystem();
 		eventSystem.Unsubscribe(m_KeyPressedID);
 		eventSystem.Unsubscribe(m_KeyReleasedID);
+
+		/* It's meshes and materials are only evictable once nothing references the model... */
+		m_Core.AssetManager().Release(m_ModelID);
 	}
 
 
@@ -318,6 +343,16 @@ namespace CMEngine::Editor
 
 			renderer.ImGuiEndWindow();
 
+			/* The camera must be up to date before batching, as it's frustum is used to cull submitted instances. */
+			Scene::CameraSystem& cameraSystem = sceneManager.GetCameraSystem();
+			View<CameraComponent> mainCamera = cameraSystem.GetMainCamera();
+
+			if (mainCamera.NonNull() && mainCamera->Dirty())
+			{
+				mainCamera->UpdateMatrices();
+				renderer.SetCamera(*mainCamera);
+			}
+
 			Renderer::BatchRenderer& batchRenderer = renderer.GetBatchRenderer();
 
 			batchRenderer.BeginBatch();
@@ -326,13 +361,18 @@ namespace CMEngine::Editor
 			for (const auto& node : scene.Graph().Root().Nodes)
 				if (node.Type == Scene::Node::NodeType::GameObject)
 				{
-					MeshComponent mesh = ecs.GetComponent<MeshComponent>(node.Entity);
+					View<MeshComponent> mesh = ecs.TryGetComponent<MeshComponent>(node.Entity);
+
+					/* Still loading... */
+					if (mesh.Null())
+						continue;
+
 					MaterialComponent material = ecs.GetComponent<MaterialComponent>(node.Entity);
 					View<TextureComponent> texture = ecs.TryGetComponent<TextureComponent>(node.Entity);
 
 					batchRenderer.SubmitInstance(
 						node.Entity,
-						mesh.ID,
+						mesh->ID,
 						material.ID,
 						texture.NonNull() ? texture->ID : Asset::AssetID()
 					);
@@ -340,15 +380,171 @@ namespace CMEngine::Editor
 
 			batchRenderer.EndBatch();
 
-			Scene::CameraSystem& cameraSystem = sceneManager.GetCameraSystem();
-			View<CameraComponent> mainCamera = cameraSystem.GetMainCamera();
+			if (renderer.ImGuiWindow("Culling"))
+			{
+				const Renderer::FrustumCuller& culler = batchRenderer.GetCuller();
 
-			if (mainCamera.NonNull() && mainCamera->Dirty())
+				std::string frustumStr = std::format("Frustum: {} / {} visible", culler.NumVisible(), culler.Count());
+				renderer.ImGuiText(frustumStr);
+
+				const Renderer::OcclusionStats& occlusion = batchRenderer.GetOcclusionStats();
+
+				std::string occludersStr = std::format("Occluders: {} ({} triangles)", occlusion.NumOccluders, occlusion.NumOccluderTriangles);
+				std::string occlusionStr = std::format("Occlusion: {} / {} visible", occlusion.NumVisible(), occlusion.NumTested);
+				std::string occlusionTimeStr = std::format("Rasterize: {:.3f} ms, Test: {:.3f} ms", occlusion.RasterizeMillis, occlusion.TestMillis);
+
+				renderer.ImGuiText(occludersStr);
+				renderer.ImGuiText(occlusionStr);
+				renderer.ImGuiText(occlusionTimeStr);
+
+				const Renderer::ClusterCullStats& clusters = batchRenderer.GetClusterCullStats();
+
+				std::string clustersStr = std::format(
+					"Clusters: {} / {} visible ({} frustum, {} cone culled)",
+					clusters.NumVisible(), clusters.NumTested, clusters.NumFrustumCulled, clusters.NumConeCulled
+				);
+
+				std::string clusterDrawsStr = std::format("Cluster draws: {} ({} instances)", clusters.NumRanges, clusters.NumInstances);
+
+				renderer.ImGuiText(clustersStr);
+				renderer.ImGuiText(clusterDrawsStr);
+
+				const Renderer::LODStats& lods = batchRenderer.GetLODStats();
+
+				std::string lodInstancesStr = "LOD instances:";
+				for (uint32_t numInstances : lods.NumInstances)
+					lodInstancesStr += std::format(" {}", numInstances);
+
+				std::string lodTrianglesStr = std::format("LOD triangles: {} / {}", lods.NumTriangles, lods.NumFullTriangles);
+
+				renderer.ImGuiText(lodInstancesStr);
+				renderer.ImGuiText(lodTrianglesStr);
+
+				const Renderer::RenderQueueStats& queues = batchRenderer.GetRenderQueueStats();
+
+				std::string queuesStr = std::format(
+					"Queues: {} opaque, {} transparent ({} runs)",
+					queues.NumOpaque, queues.NumTransparent, queues.NumTransparentRuns
+				);
+
+				renderer.ImGuiText(queuesStr);
+			}
+
+			renderer.ImGuiEndWindow();
+
+			if (renderer.ImGuiWindow("State Cache"))
 			{
-				mainCamera->UpdateMatrices();
-				renderer.SetCamera(*mainCamera);
+				/* Flush happens after this window, so these are the previous frame's counters. */
+				const Renderer::StateCacheStats& stats = renderer.GetStateCache().LastFrameStats();
+
+				std::string totalStr = std::format("Issued: {}, Elided: {}", stats.TotalIssued(), stats.TotalElided());
+				renderer.ImGuiText(totalStr);
+
+				std::string materialsStr = std::format("Materials: {} ({} table uploads)", batchRenderer.NumMaterials(), batchRenderer.NumMaterialUploads());
+				renderer.ImGuiText(materialsStr);
+
+				const Renderer::TextureTable& textures = batchRenderer.GetTextureTable();
+				std::string texturesStr = std::format(
+					"Textures: {} in {} arrays ({} rebuilds)",
+					textures.NumTextures(),
+					textures.NumPages(),
+					textures.NumRebuilds()
+				);
+
+				renderer.ImGuiText(texturesStr);
+
+				const Renderer::RenderGraphStats& graph = renderer.GetRenderGraph().Stats();
+				std::string graphStr = std::format(
+					"Render graph: {} / {} passes, {} transients in {} buffers ({} compiles)",
+					graph.NumPasses - graph.NumCulledPasses,
+					graph.NumPasses,
+					graph.NumTransients,
+					graph.NumPhysicalBuffers,
+					graph.NumCompiles
+				);
+
+				renderer.ImGuiText(graphStr);
+
+				const Renderer::CommandListStats& lists = batchRenderer.GetCommandListStats();
+				std::string listsStr = std::format(
+					"Command lists: {} ({} commands, {} draws), Record: {:.3f} ms, Replay: {:.3f} ms",
+					lists.NumLists,
+					lists.NumCommands,
+					lists.NumDraws,
+					lists.RecordMillis,
+					lists.ReplayMillis
+				);
+
+				renderer.ImGuiText(listsStr);
+
+				std::string instancesStr = std::format(
+					"Instances: {} bytes ({})",
+					batchRenderer.InstanceBytes(),
+					batchRenderer.GetInstanceFormat() == Renderer::InstanceFormat::Compact ? "Compact" : "Basic"
+				);
+
+				renderer.ImGuiText(instancesStr);
+
+				const Renderer::UploadRingStats& ring = renderer.GetUploadRing().LastFrameStats();
+				std::string ringStr = std::format(
+					"Upload ring: {} / {} bytes, {} allocations in {} maps ({} overflows, {} grows)",
+					ring.AllocatedBytes,
+					ring.CapacityBytes,
+					ring.NumAllocations,
+					ring.NumMaps,
+					ring.NumOverflows,
+					ring.NumGrows
+				);
+
+				renderer.ImGuiText(ringStr);
+
+				std::string verticesStr = std::format(
+					"Vertices: {} bytes ({} quantized)",
+					batchRenderer.VertexBytes(),
+					batchRenderer.NumQuantizedVertices()
+				);
+
+				renderer.ImGuiText(verticesStr);
+
+				Asset::DerivedDataStats derivedData = m_Core.AssetManager().DerivedData().Stats();
+				std::string derivedDataStr = std::format(
+					"Derived data: {} hits, {} misses ({:.0f}%), {} bytes hashed, {} bytes saved",
+					derivedData.NumHits,
+					derivedData.NumMisses,
+					derivedData.HitRate() * 100.0f,
+					derivedData.BytesHashed,
+					derivedData.BytesSaved
+				);
+
+				renderer.ImGuiText(derivedDataStr);
+
+				for (Asset::AssetType type : { Asset::AssetType::Mesh, Asset::AssetType::Material, Asset::AssetType::Texture })
+				{
+					const Asset::AssetMemoryStats& memory = m_Core.AssetManager().MemoryStats(type);
+					std::string memoryStr = std::format(
+						"{}: {} resident ({} unreferenced), {} / {} bytes, {} evicted",
+						type == Asset::AssetType::Mesh ? "Meshes" : type == Asset::AssetType::Material ? "Materials" : "Textures",
+						memory.NumResident,
+						memory.NumUnreferenced,
+						memory.ResidentBytes,
+						memory.BudgetBytes,
+						memory.NumEvicted
+					);
+
+					renderer.ImGuiText(memoryStr);
+				}
+
+				for (size_t i = 0; i < Renderer::StateCacheStats::S_NumKinds; ++i)
+				{
+					Renderer::StateKind kind = static_cast<Renderer::StateKind>(i);
+
+					std::string kindStr = std::format("{}: {} / {}", Renderer::StateKindToString(kind), stats.NumIssued(kind), stats.NumElided(kind));
+					renderer.ImGuiText(kindStr);
+				}
 			}
 
+			renderer.ImGuiEndWindow();
+
 			renderer.Flush();
 
 			sceneManager.DisplaySceneGraph();
@@ -28,6 +28,7 @@ namespace CMEngine::Editor
 	private:
 		EngineCore m_Core;
 		Scene::SceneID m_EditorSceneID = {};
+		Asset::AssetID m_ModelID; /* The reference LoadModelAsync hands out, released on destruction. */
 		Event::ObserverID m_KeyPressedID;
 		Event::ObserverID m_KeyReleasedID;
 	};
@@ -40,8 +40,8 @@ namespace CMEngine
 		Event::EventSystem m_EventSystem;
 		APlatform m_Platform;
 		ECS::ECS m_ECS;
+		Asset::AssetManager m_AssetManager; /* Must be declared before m_Renderer, which subscribes to it's unloads. */
 		Renderer::Renderer m_Renderer;
-		Asset::AssetManager m_AssetManager;
 		Scene::SceneManager m_SceneManager;
 	};
 }
\ No newline at end of file
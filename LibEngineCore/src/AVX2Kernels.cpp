@@ -0,0 +1,267 @@
+/* Deliberately not including PCH.hpp, see AVX2Kernels.hpp. */
+#include "AVX2Kernels.hpp"
+
+#if defined(ENGINE_CORE_ENABLE_AVX2)
+
+#include <immintrin.h>
+#include <cmath>
+
+namespace CMEngine::Renderer::AVX2
+{
+	void CullFrustum(
+		const float* pPlanes,
+		const float* pCenterX,
+		const float* pCenterY,
+		const float* pCenterZ,
+		const float* pExtentX,
+		const float* pExtentY,
+		const float* pExtentZ,
+		const float* pRadius,
+		size_t first,
+		size_t last,
+		uint8_t* pVisible
+	) noexcept
+	{
+		/* Broadcast each plane once per range instead of once per lane group... */
+		__m256 planeX[G_NumFrustumPlanes];
+		__m256 planeY[G_NumFrustumPlanes];
+		__m256 planeZ[G_NumFrustumPlanes];
+		__m256 planeW[G_NumFrustumPlanes];
+		__m256 absPlaneX[G_NumFrustumPlanes];
+		__m256 absPlaneY[G_NumFrustumPlanes];
+		__m256 absPlaneZ[G_NumFrustumPlanes];
+
+		for (size_t p = 0; p < G_NumFrustumPlanes; ++p)
+		{
+			const float* pPlane = pPlanes + p * 4;
+
+			planeX[p] = _mm256_set1_ps(pPlane[0]);
+			planeY[p] = _mm256_set1_ps(pPlane[1]);
+			planeZ[p] = _mm256_set1_ps(pPlane[2]);
+			planeW[p] = _mm256_set1_ps(pPlane[3]);
+			absPlaneX[p] = _mm256_set1_ps(std::abs(pPlane[0]));
+			absPlaneY[p] = _mm256_set1_ps(std::abs(pPlane[1]));
+			absPlaneZ[p] = _mm256_set1_ps(std::abs(pPlane[2]));
+		}
+
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 allSet = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (size_t i = first; i < last; i += G_LaneWidth)
+		{
+			__m256 cx = _mm256_loadu_ps(pCenterX + i);
+			__m256 cy = _mm256_loadu_ps(pCenterY + i);
+			__m256 cz = _mm256_loadu_ps(pCenterZ + i);
+			__m256 ex = _mm256_loadu_ps(pExtentX + i);
+			__m256 ey = _mm256_loadu_ps(pExtentY + i);
+			__m256 ez = _mm256_loadu_ps(pExtentZ + i);
+			__m256 radius = _mm256_loadu_ps(pRadius + i);
+
+			__m256 inside = allSet;
+
+			for (size_t p = 0; p < G_NumFrustumPlanes; ++p)
+			{
+				/* Signed distance from the bounds center to the plane. */
+				__m256 dist = _mm256_fmadd_ps(planeX[p], cx,
+					_mm256_fmadd_ps(planeY[p], cy,
+						_mm256_fmadd_ps(planeZ[p], cz, planeW[p])));
+
+				/* AABB extents projected onto the plane normal. Whichever of the box or sphere
+				 *   is tighter against this plane decides, since both fully enclose the mesh. */
+				__m256 boxRadius = _mm256_fmadd_ps(absPlaneX[p], ex,
+					_mm256_fmadd_ps(absPlaneY[p], ey,
+						_mm256_mul_ps(absPlaneZ[p], ez)));
+
+				__m256 effectiveRadius = _mm256_min_ps(boxRadius, radius);
+
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, effectiveRadius), zero, _CMP_GE_OQ));
+			}
+
+			uint32_t mask = (uint32_t)_mm256_movemask_ps(inside);
+
+			for (size_t lane = 0; lane < G_LaneWidth; ++lane)
+				pVisible[i + lane] = (uint8_t)((mask >> lane) & 1u);
+		}
+	}
+
+	void RasterizeTriangle(
+		const float edgeA[3],
+		const float edgeB[3],
+		const float edgeC[3],
+		float depthA,
+		float depthB,
+		float depthC,
+		int32_t rowBegin,
+		int32_t rowEnd,
+		int32_t columnBegin,
+		int32_t maxX,
+		float* pDepth,
+		size_t rowPixels
+	) noexcept
+	{
+		const __m256 laneOffsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+		const __m256 zero = _mm256_setzero_ps();
+
+		const __m256 edgeA0 = _mm256_set1_ps(edgeA[0]);
+		const __m256 edgeA1 = _mm256_set1_ps(edgeA[1]);
+		const __m256 edgeA2 = _mm256_set1_ps(edgeA[2]);
+		const __m256 depthX = _mm256_set1_ps(depthA);
+
+		for (int32_t y = rowBegin; y < rowEnd; ++y)
+		{
+			float py = (float)y + 0.5f;
+
+			/* Row constant part of each edge function and the depth plane. */
+			const __m256 edgeRow0 = _mm256_set1_ps(edgeB[0] * py + edgeC[0]);
+			const __m256 edgeRow1 = _mm256_set1_ps(edgeB[1] * py + edgeC[1]);
+			const __m256 edgeRow2 = _mm256_set1_ps(edgeB[2] * py + edgeC[2]);
+			const __m256 depthRow = _mm256_set1_ps(depthB * py + depthC);
+
+			float* pRow = pDepth + (size_t)y * rowPixels;
+
+			for (int32_t x = columnBegin; x <= maxX; x += (int32_t)G_LaneWidth)
+			{
+				__m256 px = _mm256_add_ps(_mm256_set1_ps((float)x), laneOffsets);
+
+				__m256 e0 = _mm256_fmadd_ps(edgeA0, px, edgeRow0);
+				__m256 e1 = _mm256_fmadd_ps(edgeA1, px, edgeRow1);
+				__m256 e2 = _mm256_fmadd_ps(edgeA2, px, edgeRow2);
+
+				__m256 inside = _mm256_and_ps(
+					_mm256_cmp_ps(e0, zero, _CMP_GE_OQ),
+					_mm256_and_ps(
+						_mm256_cmp_ps(e1, zero, _CMP_GE_OQ),
+						_mm256_cmp_ps(e2, zero, _CMP_GE_OQ)
+					)
+				);
+
+				if (_mm256_movemask_ps(inside) == 0)
+					continue;
+
+				__m256 depth = _mm256_fmadd_ps(depthX, px, depthRow);
+				__m256 current = _mm256_loadu_ps(pRow + x);
+
+				_mm256_storeu_ps(pRow + x, _mm256_blendv_ps(current, _mm256_min_ps(current, depth), inside));
+			}
+		}
+	}
+
+	void CullClusters(
+		const float planeX[G_NumFrustumPlanes],
+		const float planeY[G_NumFrustumPlanes],
+		const float planeZ[G_NumFrustumPlanes],
+		const float planeW[G_NumFrustumPlanes],
+		const float planeScale[G_NumFrustumPlanes],
+		const float eye[3],
+		bool coneCulling,
+		const ClusterBoundsArrays& bounds,
+		size_t padded,
+		size_t count,
+		uint8_t* pVisible,
+		uint32_t& outNumFrustumCulled,
+		uint32_t& outNumConeCulled
+	) noexcept
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 allSet = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		const __m256 eyeX = _mm256_set1_ps(eye[0]);
+		const __m256 eyeY = _mm256_set1_ps(eye[1]);
+		const __m256 eyeZ = _mm256_set1_ps(eye[2]);
+		const __m256 coneEnabled = coneCulling ? allSet : zero;
+
+		uint32_t numFrustumCulled = 0;
+		uint32_t numConeCulled = 0;
+
+		for (size_t i = 0; i < padded; i += G_LaneWidth)
+		{
+			__m256 cx = _mm256_loadu_ps(bounds.pCenterX + i);
+			__m256 cy = _mm256_loadu_ps(bounds.pCenterY + i);
+			__m256 cz = _mm256_loadu_ps(bounds.pCenterZ + i);
+			__m256 radius = _mm256_loadu_ps(bounds.pRadius + i);
+
+			__m256 inside = allSet;
+
+			for (size_t p = 0; p < G_NumFrustumPlanes; ++p)
+			{
+				__m256 dist = _mm256_fmadd_ps(_mm256_set1_ps(planeX[p]), cx,
+					_mm256_fmadd_ps(_mm256_set1_ps(planeY[p]), cy,
+						_mm256_fmadd_ps(_mm256_set1_ps(planeZ[p]), cz, _mm256_set1_ps(planeW[p]))));
+
+				__m256 reach = _mm256_mul_ps(_mm256_set1_ps(planeScale[p]), radius);
+
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, reach), zero, _CMP_GE_OQ));
+			}
+
+			/* dot(Center - eye, Axis) >= Cutoff * length(Center - eye) + Radius */
+			__m256 dx = _mm256_sub_ps(cx, eyeX);
+			__m256 dy = _mm256_sub_ps(cy, eyeY);
+			__m256 dz = _mm256_sub_ps(cz, eyeZ);
+
+			__m256 length = _mm256_sqrt_ps(_mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz))));
+
+			__m256 facing = _mm256_fmadd_ps(dx, _mm256_loadu_ps(bounds.pAxisX + i),
+				_mm256_fmadd_ps(dy, _mm256_loadu_ps(bounds.pAxisY + i),
+					_mm256_mul_ps(dz, _mm256_loadu_ps(bounds.pAxisZ + i))));
+
+			__m256 threshold = _mm256_fmadd_ps(_mm256_loadu_ps(bounds.pCutoff + i), length, radius);
+			__m256 backfacing = _mm256_and_ps(coneEnabled, _mm256_cmp_ps(facing, threshold, _CMP_GE_OQ));
+
+			uint32_t insideMask = (uint32_t)_mm256_movemask_ps(inside);
+			uint32_t backfacingMask = (uint32_t)_mm256_movemask_ps(backfacing);
+
+			for (size_t lane = 0; lane < G_LaneWidth; ++lane)
+			{
+				bool isInside = ((insideMask >> lane) & 1u) != 0;
+				bool isBackfacing = ((backfacingMask >> lane) & 1u) != 0;
+
+				pVisible[i + lane] = (uint8_t)(isInside && !isBackfacing);
+
+				if (i + lane >= count)
+					continue;
+
+				numFrustumCulled += isInside ? 0 : 1;
+				numConeCulled += isInside && isBackfacing ? 1 : 0;
+			}
+		}
+
+		outNumFrustumCulled = numFrustumCulled;
+		outNumConeCulled = numConeCulled;
+	}
+
+	[[nodiscard]] size_t ComputeDepthKeys(
+		const float* pViewZ,
+		const float* pCenterX,
+		const float* pCenterY,
+		const float* pCenterZ,
+		size_t count,
+		float* pDepths,
+		uint32_t* pKeys
+	) noexcept
+	{
+		const __m256 viewX = _mm256_set1_ps(pViewZ[0]);
+		const __m256 viewY = _mm256_set1_ps(pViewZ[1]);
+		const __m256 viewZ = _mm256_set1_ps(pViewZ[2]);
+		const __m256 viewW = _mm256_set1_ps(pViewZ[3]);
+		const __m256i signBit = _mm256_set1_epi32((int32_t)0x80000000u);
+
+		size_t i = 0;
+
+		for (; i + G_LaneWidth <= count; i += G_LaneWidth)
+		{
+			__m256 depth = _mm256_fmadd_ps(viewX, _mm256_loadu_ps(pCenterX + i),
+				_mm256_fmadd_ps(viewY, _mm256_loadu_ps(pCenterY + i),
+					_mm256_fmadd_ps(viewZ, _mm256_loadu_ps(pCenterZ + i), viewW)));
+
+			/* Same as DepthToKey in RenderQueue.cpp */
+			__m256i bits = _mm256_castps_si256(depth);
+			__m256i mask = _mm256_or_si256(_mm256_srai_epi32(bits, 31), signBit);
+
+			_mm256_storeu_ps(pDepths + i, depth);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pKeys + i), _mm256_xor_si256(bits, mask));
+		}
+
+		return i;
+	}
+}
+
+#endif
\ No newline at end of file
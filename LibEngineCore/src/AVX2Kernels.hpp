@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CMEngine::Renderer::AVX2
+{
+	/* The 8-wide loops of culling and depth sorting, kept in AVX2Kernels.cpp as the only code compiled with AVX2 and FMA.
+	 *   (see ENGINE_CORE_ENABLE_AVX2) Each caller keeps a scalar fallback, and only calls these if CPUSupportsAVX2().
+	 *
+	 * Everything is passed as raw arrays, so AVX2Kernels.cpp includes no header whose inline functions an AVX2 compiled
+	 *   copy of could be linked in place of the one every other file uses. */
+
+	inline constexpr size_t G_LaneWidth = 8;
+	inline constexpr size_t G_NumFrustumPlanes = 6;
+
+	/* See FrustumCuller::CullRange. @pPlanes holds G_NumFrustumPlanes planes as (x, y, z, w), and
+	 *   [@first, @last) is a multiple of G_LaneWidth, as the bounds are padded to it. */
+	void CullFrustum(
+		const float* pPlanes,
+		const float* pCenterX,
+		const float* pCenterY,
+		const float* pCenterZ,
+		const float* pExtentX,
+		const float* pExtentY,
+		const float* pExtentZ,
+		const float* pRadius,
+		size_t first,
+		size_t last,
+		uint8_t* pVisible
+	) noexcept;
+
+	/* See OcclusionCuller::RasterizeTriangle. Writes whole groups of 8 pixels from @columnBegin, (a multiple of 8)
+	 *   so each row of @pDepth must be a multiple of 8 pixels. */
+	void RasterizeTriangle(
+		const float edgeA[3],
+		const float edgeB[3],
+		const float edgeC[3],
+		float depthA,
+		float depthB,
+		float depthC,
+		int32_t rowBegin,
+		int32_t rowEnd,
+		int32_t columnBegin,
+		int32_t maxX,
+		float* pDepth,
+		size_t rowPixels
+	) noexcept;
+
+	/* Object-space meshlet bounds, (see ClusterBounds) padded to a multiple of G_LaneWidth. */
+	struct ClusterBoundsArrays
+	{
+		const float* pCenterX = nullptr;
+		const float* pCenterY = nullptr;
+		const float* pCenterZ = nullptr;
+		const float* pRadius = nullptr;
+		const float* pAxisX = nullptr;
+		const float* pAxisY = nullptr;
+		const float* pAxisZ = nullptr;
+		const float* pCutoff = nullptr;
+	};
+
+	/* See ClusterCuller::Cull. Each plane array holds G_NumFrustumPlanes object-space planes, and only
+	 *   the first @count of the @padded meshlets are counted as culled. */
+	void CullClusters(
+		const float planeX[G_NumFrustumPlanes],
+		const float planeY[G_NumFrustumPlanes],
+		const float planeZ[G_NumFrustumPlanes],
+		const float planeW[G_NumFrustumPlanes],
+		const float planeScale[G_NumFrustumPlanes],
+		const float eye[3],
+		bool coneCulling,
+		const ClusterBoundsArrays& bounds,
+		size_t padded,
+		size_t count,
+		uint8_t* pVisible,
+		uint32_t& outNumFrustumCulled,
+		uint32_t& outNumConeCulled
+	) noexcept;
+
+	/* See DepthSorter::Compute, @pViewZ is it's (x, y, z, w). Returns how many of the @count centers were computed,
+	 *   (a multiple of G_LaneWidth) leaving the remainder to the caller. */
+	[[nodiscard]] size_t ComputeDepthKeys(
+		const float* pViewZ,
+		const float* pCenterX,
+		const float* pCenterY,
+		const float* pCenterZ,
+		size_t count,
+		float* pDepths,
+		uint32_t* pKeys
+	) noexcept;
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <limits>
 
 namespace CMEngine::Asset
 {
@@ -17,12 +18,95 @@ namespace CMEngine::Asset
 		Float2 TexCoord;
 	};
 
-	using Index = uint16_t;
+	/* 16 byte vertex produced at import when quantization is enabled, (see ImportOptions::QuantizeVertices)
+	 *   compared to Vertex's 32. Only ever uploaded, Vertex is still kept for everything on the CPU. */
+	struct QuantizedVertex
+	{
+		uint16_t Pos[4] = {};      /* unorm16 within the mesh's AABB, w is padding. (See VertexQuantization) */
+		int16_t Normal[2] = {};    /* Octahedral encoded snorm16, of the normal pre-divided by VertexQuantization::Scale. */
+		uint16_t TexCoord[2] = {}; /* float16 */
+	};
+
+	static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must be tightly packed, as it's uploaded as is.");
+
+	/* Maps a QuantizedVertex back into object space, Pos = Min + unorm(Pos) * Scale. */
+	struct VertexQuantization
+	{
+		Float3 Min;
+		Float3 Scale = Float3(1.0f, 1.0f, 1.0f);
+	};
+
+	using Index16 = uint16_t;
+	using Index32 = uint32_t;
+
+	/* Indices are always kept at full width on the CPU, see MeshData::Width for what the GPU gets. */
+	using Index = Index32;
+
+	enum class IndexWidth : uint8_t
+	{
+		Bits16,
+		Bits32
+	};
+
+	/* A contiguous range of a mesh's triangles, with bounds tight enough to cull on it's own. (See BuildMeshlets) */
+	struct Meshlet
+	{
+		uint32_t FirstIndex = 0; /* Into MeshData::Indices */
+		uint32_t NumIndices = 0;
+		uint32_t NumVertices = 0; /* Unique vertices referenced. */
+
+		/* Bounding sphere. */
+		Float3 Center;
+		float Radius = 0.0f;
+
+		/* Normal cone, every triangle faces away from a viewer at p if
+		 *   dot(Center - p, ConeAxis) >= ConeCutoff * length(Center - p) + Radius */
+		Float3 ConeAxis;
+		float ConeCutoff = 1.0f; /* 1 if the triangles' normals are too spread out to ever cull. */
+	};
+
+	/* Including the full mesh, (LOD 0) so a LOD always fits in a byte. */
+	inline constexpr uint32_t G_MaxMeshLODs = 8;
+
+	/* A simplified version of a mesh, whose indices still refer to MeshData::Vertices. (See BuildLODs) */
+	struct MeshLOD
+	{
+		uint32_t FirstIndex = 0; /* Into MeshData::LODIndices */
+		uint32_t NumIndices = 0;
+		float Error = 0.0f; /* Estimated object space distance from the full mesh's surface. */
+	};
 
 	struct MeshData
 	{
+		static constexpr Index S_Max16BitIndex = static_cast<Index>(std::numeric_limits<Index16>::max());
+
 		std::vector<Vertex> Vertices;
 		std::vector<Index> Indices;
+
+		/* Narrowest width that can hold every index, set at import. */
+		IndexWidth Width = IndexWidth::Bits16;
+
+		/* Parallel to Vertices, empty unless the mesh was quantized at import. */
+		std::vector<QuantizedVertex> QuantizedVertices;
+		VertexQuantization Quantization;
+
+		/* Partitions Indices, empty unless meshlets were built at import. */
+		std::vector<Meshlet> Meshlets;
+
+		/* Progressively coarser LODs, one after the other in LODIndices. Indices is always LOD 0,
+		 *   and the rest are empty unless LODs were built at import. */
+		std::vector<Index> LODIndices;
+		std::vector<MeshLOD> LODs;
+
+		inline [[nodiscard]] bool IsQuantized() const noexcept { return !QuantizedVertices.empty(); }
+	};
+
+	/* Object-space bounding volumes of a mesh, computed once at import. */
+	struct MeshBounds
+	{
+		Float3 Center;
+		Float3 Extents; /* Half-size of the AABB along each axis. */
+		float Radius = 0.0f; /* Radius of the bounding sphere around Center. */
 	};
 
 	struct MaterialData
@@ -84,7 +168,11 @@ namespace CMEngine::Asset
 
 		~Mesh() = default;
 
+		Mesh(const Mesh&) = default;
+		Mesh(Mesh&&) = default;
+
 		MeshData Data;
+		MeshBounds Bounds;
 		AssetID ModelID;
 		uint32_t Index = 0;
 	};
@@ -120,6 +208,8 @@ namespace CMEngine::Asset
 		uint32_t Index = 0;
 	};
 
+	/* The texture's file (or the pack it's in) is mapped rather than read, and it's bytes are handed to IGraphics::CreateTexture as is.
+	 *   Once uploaded they're released, (see AssetManager::ReleaseTextureData) after which Bytes is empty. */
 	struct Texture : public Asset
 	{
 		inline Texture() noexcept
@@ -127,7 +217,9 @@ namespace CMEngine::Asset
 		{
 		}
 
-		std::unique_ptr<std::byte> pBuffer;
-		size_t SizeBytes = 0;
+		inline [[nodiscard]] std::span<const std::byte> Bytes() const noexcept { return Data; }
+
+		std::span<const std::byte> Data;
+		std::shared_ptr<const void> pStorage; /* Whatever Data points into, (a mapped file, a mapped pack, or a decompressed copy) */
 	};
 }
\ No newline at end of file
@@ -4,10 +4,11 @@
 
 namespace CMEngine::Asset
 {
-	AssetID::AssetID(AssetType type, uint32_t globalID) noexcept
+	AssetID::AssetID(AssetType type, uint32_t globalID, uint32_t generation) noexcept
 	{
 		SetType(type);
 		SetGlobalID(globalID);
+		SetGeneration(generation);
 	}
 
 	[[nodiscard]] bool AssetID::IsRegistered() const noexcept
@@ -31,7 +32,15 @@ namespace CMEngine::Asset
 		/* Mask out the value in the GlobalID field (bits 0 - 31).
 		 * No shift needed, as the GlobalID field is already aligned at bit 0.
 		 */
-		return m_Handle & S_GLOBAL_ID_MASK;
+		return static_cast<uint32_t>(m_Handle & S_GLOBAL_ID_MASK);
+	}
+
+	[[nodiscard]] uint32_t AssetID::Generation() const noexcept
+	{
+		/* Mask out the value in the Generation field (bits 32 - 63).
+		 * Shift it down, which leaves exactly the 32 bits of the field.
+		 */
+		return static_cast<uint32_t>((m_Handle & S_GENERATION_MASK) >> S_GENERATION_SHIFT);
 	}
 
 	[[nodiscard]] AssetIDView AssetID::AsView() const noexcept
@@ -60,7 +69,7 @@ namespace CMEngine::Asset
 		 * Set the new IsRegistered bit by bitwise OR'ing.
 		 */
 		m_Handle = (m_Handle & ~S_IS_REGISTERED_MASK) |
-			(static_cast<uint32_t>(isRegistered) << S_IS_REGISTERED_SHIFT);
+			(static_cast<RawAssetID>(isRegistered) << S_IS_REGISTERED_SHIFT);
 	}
 
 	void AssetID::SetType(AssetType type) noexcept
@@ -76,7 +85,7 @@ namespace CMEngine::Asset
 		 * Set the new AssetType bits by bitwise OR'ing.
 		 */
 		m_Handle = (m_Handle & ~S_ASSET_TYPE_MASK) |
-			((static_cast<uint32_t>(type) << S_ASSET_TYPE_SHIFT) & S_ASSET_TYPE_MASK);
+			((static_cast<RawAssetID>(type) << S_ASSET_TYPE_SHIFT) & S_ASSET_TYPE_MASK);
 	}
 
 	void AssetID::SetGlobalID(uint32_t globalID) noexcept
@@ -94,9 +103,18 @@ namespace CMEngine::Asset
 			(globalID & S_GLOBAL_ID_MASK);
 	}
 
-	[[nodiscard]] AssetID AssetID::Registered(AssetType type, uint32_t globalID) noexcept
+	void AssetID::SetGeneration(uint32_t generation) noexcept
+	{
+		/* Clear the Generation field, then shift the value up into it (bits 32 - 63).
+		 * No need to mask the value, as it's exactly as wide as the field.
+		 */
+		m_Handle = (m_Handle & ~S_GENERATION_MASK) |
+			(static_cast<RawAssetID>(generation) << S_GENERATION_SHIFT);
+	}
+
+	[[nodiscard]] AssetID AssetID::Registered(AssetType type, uint32_t globalID, uint32_t generation) noexcept
 	{
-		AssetID handle(type, globalID);
+		AssetID handle(type, globalID, generation);
 		handle.SetRegistered(true);
 		return handle;
 	}
@@ -106,5 +124,6 @@ namespace CMEngine::Asset
 		IsRegistered = handle.IsRegistered();
 		Type = handle.Type();
 		GlobalID = handle.GlobalID();
+		Generation = handle.Generation();
 	}
 }
\ No newline at end of file
@@ -43,7 +43,7 @@ namespace CMEngine::Asset
 		}
 	}
 
-	using RawAssetID = uint32_t;
+	using RawAssetID = uint64_t;
 
 	/* Forward declare here for ToView(). */
 	class AssetIDView;
@@ -52,13 +52,14 @@ namespace CMEngine::Asset
 	{
 		friend class AssetManager;
 
-		AssetID(AssetType type, uint32_t globalID) noexcept;
+		AssetID(AssetType type, uint32_t globalID, uint32_t generation = 0) noexcept;
 		AssetID() = default;
 		~AssetID() = default;
 
 		[[nodiscard]] bool IsRegistered() const noexcept;
 		[[nodiscard]] AssetType Type() const noexcept;
 		[[nodiscard]] uint32_t GlobalID() const noexcept;
+		[[nodiscard]] uint32_t Generation() const noexcept;
 		[[nodiscard]] AssetIDView AsView() const noexcept;
 
 		inline [[nodiscard]] RawAssetID RawHandle() const noexcept { return m_Handle; }
@@ -73,12 +74,13 @@ namespace CMEngine::Asset
 		void SetRegistered(bool isRegistered) noexcept;
 		void SetType(AssetType type) noexcept;
 		void SetGlobalID(uint32_t globalID) noexcept;
+		void SetGeneration(uint32_t generation) noexcept;
 
-		static [[nodiscard]] AssetID Registered(AssetType type, uint32_t globalID) noexcept;
+		static [[nodiscard]] AssetID Registered(AssetType type, uint32_t globalID, uint32_t generation) noexcept;
 	private:
 		RawAssetID m_Handle = 0;
 	public:
-		static constexpr uint32_t S_INVALID_HANDLE = 0;
+		static constexpr RawAssetID S_INVALID_HANDLE = 0;
 
 		/* Because I'll forget later --
 		 *
@@ -90,6 +92,7 @@ namespace CMEngine::Asset
 		inline static constexpr uint32_t S_GLOBAL_ID_BITS = 24;
 		inline static constexpr uint32_t S_ASSET_TYPE_BITS = 7;
 		inline static constexpr uint32_t S_IS_REGISTERED_BITS = 1;
+		inline static constexpr uint32_t S_GENERATION_BITS = 32;
 
 		inline static constexpr uint32_t S_MAXIMUM_GLOBAL_IDS = ToPower<uint32_t>(2, 8 * 3);
 		inline static constexpr uint32_t S_MAXIMUM_ASSET_TYPES = ToPower<uint32_t>(2, 7);
@@ -100,15 +103,18 @@ namespace CMEngine::Asset
 		static constexpr uint32_t S_GLOBAL_ID_SHIFT = 0;
 		static constexpr uint32_t S_ASSET_TYPE_SHIFT = S_GLOBAL_ID_BITS;
 		static constexpr uint32_t S_IS_REGISTERED_SHIFT = S_ASSET_TYPE_SHIFT + S_ASSET_TYPE_BITS;
+		static constexpr uint32_t S_GENERATION_SHIFT = S_IS_REGISTERED_SHIFT + S_IS_REGISTERED_BITS;
 
-		/* uint32_t Asset Handle layout :
+		/* uint64_t Asset Handle layout :
 		 *
-		 * 31			31 30	    24 23			  0
-		 * +--------------+-----------+---------------+
-		 * | IsRegistered | AssetType | GlobalAssetID |
-		 * +--------------+-----------+---------------+
-		 *      1 bit		  7 bits	     24 bits
+		 * 63		  32 31			  31 30	      24 23			    0
+		 * +------------+--------------+-----------+---------------+
+		 * | Generation | IsRegistered | AssetType | GlobalAssetID |
+		 * +------------+--------------+-----------+---------------+
+		 *     32 bits       1 bit		   7 bits	     24 bits
 		 *
+		 * Generation is bumped every time a GlobalAssetID is unregistered, so a stale handle to
+		 *   it never resolves to whichever asset reuses it next.
 		 */
 
 		 /* Shift 1 (unsigned 32 bit) left by 24 bits :
@@ -129,7 +135,7 @@ namespace CMEngine::Asset
 		  *
 		  * No need to shift; bit-field already starts at bit 0.
 		  */
-		inline static constexpr uint32_t S_GLOBAL_ID_MASK = ((static_cast<uint32_t>(1) << S_GLOBAL_ID_BITS) - 1);
+		inline static constexpr RawAssetID S_GLOBAL_ID_MASK = ((static_cast<RawAssetID>(1) << S_GLOBAL_ID_BITS) - 1);
 
 		/* Shift 1 (unsigned 32 bit) left by 7 bits :
 		 *
@@ -149,7 +155,7 @@ namespace CMEngine::Asset
 		 *						to :
 		 *      01111111 00000000 00000000 00000000
 		 */
-		inline static constexpr uint32_t S_ASSET_TYPE_MASK = ((static_cast<uint32_t>(1) << S_ASSET_TYPE_BITS) - 1)
+		inline static constexpr RawAssetID S_ASSET_TYPE_MASK = ((static_cast<RawAssetID>(1) << S_ASSET_TYPE_BITS) - 1)
 			<< S_ASSET_TYPE_SHIFT;
 
 		/* Shift 1 (unsigned 32 bit) left by 1 bit :
@@ -170,8 +176,11 @@ namespace CMEngine::Asset
 		 *						to :
 		 *      10000000 00000000 00000000 00000000
 		 */
-		inline static constexpr uint32_t S_IS_REGISTERED_MASK = ((static_cast<uint32_t>(1) << S_IS_REGISTERED_BITS) - 1)
+		inline static constexpr RawAssetID S_IS_REGISTERED_MASK = ((static_cast<RawAssetID>(1) << S_IS_REGISTERED_BITS) - 1)
 			<< S_IS_REGISTERED_SHIFT;
+
+		/* Upper 32 bits, no need to subtract as the field runs to the end of the handle. */
+		inline static constexpr RawAssetID S_GENERATION_MASK = ~static_cast<RawAssetID>(0) << S_GENERATION_SHIFT;
 	};
 
 	class AssetIDView
@@ -183,6 +192,7 @@ namespace CMEngine::Asset
 		bool IsRegistered = false;
 		AssetType Type = AssetType::Invalid;
 		uint32_t GlobalID = 0;
+		uint32_t Generation = 0;
 	};
 }
 
@@ -193,7 +203,7 @@ namespace std
 	{
 		inline size_t operator()(CMEngine::Asset::AssetID id) const noexcept
 		{
-			return hash<size_t>{}(id.GlobalID());
+			return hash<CMEngine::Asset::RawAssetID>{}(id.RawHandle());
 		}
 	};
 }
\ No newline at end of file
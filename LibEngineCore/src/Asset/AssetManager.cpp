@@ -1,88 +1,108 @@
 ﻿#include "PCH.hpp"
 #include "Macros.hpp"
 #include "Asset/AssetManager.hpp"
+#include "Asset/CookedMesh.hpp"
+#include "Asset/AssetPack.hpp"
+#include "Asset/VertexQuantization.hpp"
+#include "Asset/VertexInterleave.hpp"
+#include "Asset/MeshOptimizer.hpp"
+#include "Asset/Meshlets.hpp"
+#include "Asset/MeshSimplifier.hpp"
 #include "Log.hpp"
+#include "MappedFile.hpp"
+#include "ImageDecoder.hpp"
 
 namespace CMEngine::Asset
 {
+	/* Part of every CookKey, so changing these invalidates every cooked model. */
+	inline constexpr uint32_t G_ImportFlags =
+		aiProcess_Triangulate |
+		aiProcess_JoinIdenticalVertices |
+		aiProcess_ConvertToLeftHanded;
+
 	class ModelImporterImpl
 	{
 	public:
 		ModelImporterImpl() = default;
 		~ModelImporterImpl() = default;
 
-		void LoadMesh(Mesh& mesh, ConstView<aiMesh> aiMesh, ConstView<aiScene> scene) noexcept;
+		/* Doesn't touch any AssetManager state, so it's safe to call from any thread. */
+		Result ImportModel(
+			const std::filesystem::path& modelPath,
+			const ImportOptions& options,
+			const AssetPackSet& packs,
+			DerivedDataCache& derivedData,
+			ImportedModel& outModel
+		) noexcept;
+
+		/* Imports @modelPath through assimp, ignoring any cooked meshes. */
+		Result ImportSource(const std::filesystem::path& modelPath, const ImportOptions& options, ImportedModel& outModel) noexcept;
+
+		void LoadMesh(Mesh& mesh, ConstView<aiMesh> aiMesh, ConstView<aiScene> scene, const ImportOptions& options) noexcept;
 
 		void LoadVertices(Mesh& mesh, ConstView<aiMesh> aiMesh) noexcept;
 		void LoadIndices(Mesh& mesh, ConstView<aiMesh> aiMesh) noexcept;
-
-		Assimp::Importer Importer;
+		void LoadBounds(Mesh& mesh) noexcept;
+		void LoadOptimized(Mesh& mesh) noexcept;
+		void LoadLODs(Mesh& mesh) noexcept;
+		void LoadMeshlets(Mesh& mesh) noexcept;
+		void LoadQuantized(Mesh& mesh) noexcept;
+		void LoadMaterial(Material& material, ConstView<aiMaterial> pMaterial) noexcept;
 	};
 
-	void ModelImporterImpl::LoadMesh(Mesh& mesh, ConstView<aiMesh> aiMesh, ConstView<aiScene> scene) noexcept
+	Result ModelImporterImpl::ImportModel(
+		const std::filesystem::path& modelPath,
+		const ImportOptions& options,
+		const AssetPackSet& packs,
+		DerivedDataCache& derivedData,
+		ImportedModel& outModel
+	) noexcept
 	{
-		LoadVertices(mesh, aiMesh);
-		LoadIndices(mesh, aiMesh);
-	}
+		PackedBytes packed;
 
-	void ModelImporterImpl::LoadVertices(Mesh& mesh, ConstView<aiMesh> aiMesh) noexcept
-	{
-		mesh.Data.Vertices.reserve(aiMesh->mNumVertices);
+		/* Packs only hold cooked models, which are copied out of the pack as is... */
+		if (packs.Read(modelPath, packed))
+			return ReadCookedModel(packed.Bytes, modelPath, nullptr, outModel);
 
-		for (unsigned int i = 0; i < aiMesh->mNumVertices; ++i)
+		/* Loading a .cmmesh directly, there's no source to check it against... */
+		if (modelPath.extension() == G_CookedMeshExtension)
 		{
-			aiVector3D texCoord = aiMesh->HasTextureCoords(mesh.Index)
-				? aiMesh->mTextureCoords[0][i]  // UV channel 0
-				: aiVector3D(0.0f, 0.0f, 0.0f); // fallback
-
-			aiVector3D& vertex = aiMesh->mVertices[i];
-			aiVector3D& normal = aiMesh->mNormals[i];
+			Result result = ReadCookedModel(modelPath, nullptr, outModel);
 
-			Float3 vertexF3(vertex.x, vertex.y, vertex.z);
-			Float3 normalF3(normal.x, normal.y, normal.z);
-			Float2 texCoordF2(texCoord.x, texCoord.y);
+			if (result.Type == ResultType::Failed_File_Absent)
+				CM_ENGINE_LOG_WARN(
+					"(AssetManager) Internal warning: Provided model path doesn't exist. Path: {}",
+					modelPath.generic_string()
+				);
 
-			mesh.Data.Vertices.emplace_back(vertexF3, normalF3, texCoordF2);
+			return result;
 		}
-	}
 
-	void ModelImporterImpl::LoadIndices(Mesh& mesh, ConstView<aiMesh> aiMesh) noexcept
-	{
-		/* Since we triangulated, each face should be a triangle (i.e., require 3 indices. ex. 0, 1, 2). */
-		UINT numIndices = aiMesh->mNumFaces * 3;
-		mesh.Data.Indices.reserve(numIndices);
+		CookKey key;
 
-		for (unsigned int i = 0; i < aiMesh->mNumFaces; ++i)
-		{
-			const auto& face = aiMesh->mFaces[i];
-			CM_ENGINE_ASSERT(face.mNumIndices == 3);
+		/* Unreadable sources are left to ImportSource to report, and ones the cache can't key are always imported from them... */
+		if (!options.UseCookedMeshes || !derivedData.MakeKey(modelPath, options, G_ImportFlags, key))
+			return ImportSource(modelPath, options, outModel);
 
-			mesh.Data.Indices.emplace_back((uint16_t)(face.mIndices[0]));
-			mesh.Data.Indices.emplace_back((uint16_t)(face.mIndices[1]));
-			mesh.Data.Indices.emplace_back((uint16_t)(face.mIndices[2]));
-		}
-	}
+		if (derivedData.Load(key, outModel))
+			return ResultType::Succeeded;
 
-	AssetManager::AssetManager() noexcept
-		: mP_ModelImporter(std::make_unique<ModelImporterImpl>())
-	{
- 	   Init();
-	}
+		Result result = ImportSource(modelPath, options, outModel);
 
-	AssetManager::~AssetManager() noexcept
-	{
- 	   Shutdown();
-	}
+		if (!result)
+			return result;
 
-	void AssetManager::Init() noexcept
-	{
-	}
+		/* Not fatal, the model is just imported from source again next time... */
+		if (derivedData.Store(key, outModel))
+			CM_ENGINE_LOG_INFO(
+				"(AssetManager) Internal info: Cooked model. Path: {}, Entry: {}",
+				modelPath.generic_string(), derivedData.EntryPath(key).generic_string()
+			);
 
-	void AssetManager::Shutdown() noexcept
-	{
+		return ResultType::Succeeded;
 	}
 
-	Result AssetManager::LoadModel(const std::filesystem::path& modelPath, AssetID& outModelID) noexcept
+	Result ModelImporterImpl::ImportSource(const std::filesystem::path& modelPath, const ImportOptions& options, ImportedModel& outModel) noexcept
 	{
 		if (!std::filesystem::exists(modelPath))
 		{
@@ -94,36 +114,27 @@ namespace CMEngine::Asset
 			return ResultType::Failed_File_Absent;
 		}
 
-		ConstView<aiScene> scene = mP_ModelImporter->Importer.ReadFile(
-			modelPath.generic_string(),
-			aiProcess_Triangulate |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_ConvertToLeftHanded
-		);
+		/* One importer per import, as an importer can't be shared between threads. (it's scene is only read from below) */
+		Assimp::Importer importer;
+
+		ConstView<aiScene> scene = importer.ReadFile(modelPath.generic_string(), G_ImportFlags);
 
 		if (!scene)
 		{
 			CM_ENGINE_LOG_WARN(
 				"(AssetManager) Internal warning: Error occured loading model. "
-				"Error: {}", mP_ModelImporter->Importer.GetErrorString()
+				"Error: {}", importer.GetErrorString()
 			);
 
 			return ResultType::Failed_File_Import;
 		}
 
-		outModelID = AssetID::Registered(AssetType::Model, NextGlobalID());
-		Model& model = m_ModelMap[outModelID];
-		File& file = m_LoadedFiles[outModelID];
-		file.Path = modelPath;
-
-		model.Meshes.reserve(scene->mNumMeshes);
-		model.Materials.reserve(scene->mNumMaterials);
+		std::vector<uint32_t> meshIndices;
+		meshIndices.reserve(scene->mNumMeshes);
 
 		for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex)
 		{
-			ConstView<aiMesh> aiMesh = scene->mMeshes[meshIndex];
-
-			if (!aiMesh)
+			if (!scene->mMeshes[meshIndex])
 			{
 				CM_ENGINE_LOG_WARN(
 					"(AssetManager) Internal warning: Failed to retrieve mesh at index: {}. File: {}",
@@ -133,130 +144,509 @@ namespace CMEngine::Asset
 				continue;
 			}
 
-			AssetID meshID = AssetID::Registered(AssetType::Mesh, NextGlobalID());
+			meshIndices.emplace_back(meshIndex);
+		}
+
+		outModel.Meshes.resize(meshIndices.size());
+		outModel.Materials.resize(scene->mNumMaterials);
 
-			model.Meshes.emplace_back(meshID);
+		/* Meshes first, then materials, each converted (with every pass on it) into it's own pre-sized slot,
+		 *   so the result is identical to converting them serially, regardless of which thread gets which. */
+		std::vector<uint32_t> jobs(outModel.Meshes.size() + outModel.Materials.size());
+		std::iota(jobs.begin(), jobs.end(), 0u);
+
+		std::for_each(
+			std::execution::par,
+			jobs.begin(),
+			jobs.end(),
+			[this, &meshIndices, &outModel, scene, &options](uint32_t job)
+			{
+				if (job < meshIndices.size())
+				{
+					Mesh& mesh = outModel.Meshes[job];
+					mesh.Index = meshIndices[job];
+
+					LoadMesh(mesh, scene->mMeshes[mesh.Index], scene, options);
+					return;
+				}
+
+				uint32_t materialIndex = job - static_cast<uint32_t>(meshIndices.size());
+
+				Material& material = outModel.Materials[materialIndex];
+				material.Index = materialIndex;
+
+				LoadMaterial(material, scene->mMaterials[materialIndex]);
+			}
+		);
+
+		return ResultType::Succeeded;
+	}
+
+	void ModelImporterImpl::LoadMesh(Mesh& mesh, ConstView<aiMesh> aiMesh, ConstView<aiScene> scene, const ImportOptions& options) noexcept
+	{
+		LoadVertices(mesh, aiMesh);
+		LoadIndices(mesh, aiMesh);
+
+		if (options.OptimizeMeshes)
+			LoadOptimized(mesh);
+
+		LoadBounds(mesh);
+
+		/* Also after optimizing, as LODs index into the final vertex order. */
+		if (options.GenerateLODs)
+			LoadLODs(mesh);
 
-			Mesh& mesh = m_MeshMap[meshID];
-			mesh.ModelID = outModelID;
-			mesh.Index = meshIndex;
+		/* After optimizing, as meshlets are taken from the triangle order as is. */
+		if (options.BuildMeshlets)
+			LoadMeshlets(mesh);
 
-			mP_ModelImporter->LoadMesh(mesh, aiMesh, scene);
+		if (options.QuantizeVertices)
+			LoadQuantized(mesh);
+	}
+
+	void ModelImporterImpl::LoadVertices(Mesh& mesh, ConstView<aiMesh> aiMesh) noexcept
+	{
+		static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "InterleaveVertices expects tightly packed float streams.");
+
+		/* Only UV channel 0 is ever used, so that's the one to check. (Not the mesh's index) */
+		const float* pTexCoords = aiMesh->HasTextureCoords(0) ? reinterpret_cast<const float*>(aiMesh->mTextureCoords[0]) : nullptr;
+		const float* pNormals = aiMesh->HasNormals() ? reinterpret_cast<const float*>(aiMesh->mNormals) : nullptr;
+
+		mesh.Data.Vertices.resize(aiMesh->mNumVertices);
+
+		InterleaveVertices(
+			reinterpret_cast<const float*>(aiMesh->mVertices),
+			pNormals,
+			pTexCoords,
+			mesh.Data.Vertices
+		);
+	}
+
+	void ModelImporterImpl::LoadIndices(Mesh& mesh, ConstView<aiMesh> aiMesh) noexcept
+	{
+		/* Since we triangulated, each face should be a triangle (i.e., require 3 indices. ex. 0, 1, 2). */
+		UINT numIndices = aiMesh->mNumFaces * 3;
+		mesh.Data.Indices.reserve(numIndices);
+
+		Index maxIndex = 0;
+
+		for (unsigned int i = 0; i < aiMesh->mNumFaces; ++i)
+		{
+			const auto& face = aiMesh->mFaces[i];
+			CM_ENGINE_ASSERT(face.mNumIndices == 3);
+
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				Index index = static_cast<Index>(face.mIndices[j]);
+
+				mesh.Data.Indices.emplace_back(index);
+				maxIndex = std::max(maxIndex, index);
+			}
 		}
 
-		for (uint32_t materialIndex = 0; materialIndex < scene->mNumMaterials; ++materialIndex)
+		/* Only meshes that would otherwise be truncated pay for 32-bit indices... */
+		mesh.Data.Width = maxIndex > MeshData::S_Max16BitIndex ?
+			IndexWidth::Bits32 : IndexWidth::Bits16;
+	}
+
+	void ModelImporterImpl::LoadBounds(Mesh& mesh) noexcept
+	{
+		MeshBounds& bounds = mesh.Bounds;
+
+		if (mesh.Data.Vertices.empty())
 		{
-			AssetID materialID = AssetID::Registered(AssetType::Material, NextGlobalID());
-			model.Materials.emplace_back(materialID);
+			bounds = MeshBounds();
+			return;
+		}
 
-			Material& material = m_MaterialMap[materialID];
-			MaterialData& materialData = material.Data;
+		Float3 min = mesh.Data.Vertices.front().Pos;
+		Float3 max = min;
 
-			ConstView<aiMaterial> pMaterial = scene->mMaterials[materialIndex];
+		for (const Vertex& vertex : mesh.Data.Vertices)
+		{
+			min.x = std::min(min.x, vertex.Pos.x);
+			min.y = std::min(min.y, vertex.Pos.y);
+			min.z = std::min(min.z, vertex.Pos.z);
 
-			/* TODO: handle material.TextureID */
-			material.ModelID = outModelID;
-			material.Index = materialIndex;
+			max.x = std::max(max.x, vertex.Pos.x);
+			max.y = std::max(max.y, vertex.Pos.y);
+			max.z = std::max(max.z, vertex.Pos.z);
+		}
 
-			aiColor4D baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-			aiGetMaterialColor(pMaterial, AI_MATKEY_BASE_COLOR, &baseColor);
-			materialData.BaseColor = { baseColor.r, baseColor.g, baseColor.b, baseColor.a };
+		bounds.Center = Float3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+		bounds.Extents = Float3((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f);
 
-			float metallic = 0.0f;
-			aiGetMaterialFloat(pMaterial, AI_MATKEY_METALLIC_FACTOR, &metallic);
-			materialData.Metallic = metallic;
+		/* Sphere around the AABB center, tightened to the farthest vertex rather than the box corner. */
+		float radiusSq = 0.0f;
+		for (const Vertex& vertex : mesh.Data.Vertices)
+		{
+			float dx = vertex.Pos.x - bounds.Center.x;
+			float dy = vertex.Pos.y - bounds.Center.y;
+			float dz = vertex.Pos.z - bounds.Center.z;
 
-			float roughness = 0.0f;
-			aiGetMaterialFloat(pMaterial, AI_MATKEY_ROUGHNESS_FACTOR, &roughness);
-			materialData.Roughness = roughness;
+			radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
 		}
 
+		bounds.Radius = std::sqrt(radiusSq);
+	}
+
+	void ModelImporterImpl::LoadOptimized(Mesh& mesh) noexcept
+	{
+		VertexCacheStats before = AnalyzeVertexCache(mesh.Data.Indices, mesh.Data.Vertices.size());
+
+		OptimizeMesh(mesh.Data);
+
+		VertexCacheStats after = AnalyzeVertexCache(mesh.Data.Indices, mesh.Data.Vertices.size());
+
 		CM_ENGINE_LOG_INFO(
-			"(AssetManager) Internal info: Successfully loaded model. Name: {}, GlobalID: {}", 
-			modelPath.generic_string(), outModelID.GlobalID()
+			"(AssetManager) Internal info: Optimized mesh. Index: {}, Triangles: {}, "
+			"ACMR: {} -> {}, ATVR: {} -> {}",
+			mesh.Index, mesh.Data.Indices.size() / 3,
+			before.ACMR, after.ACMR, before.ATVR, after.ATVR
 		);
+	}
 
-		return ResultType::Succeeded;
+	void ModelImporterImpl::LoadLODs(Mesh& mesh) noexcept
+	{
+		BuildLODs(mesh.Data);
+
+		for (size_t i = 0; i < mesh.Data.LODs.size(); ++i)
+			CM_ENGINE_LOG_INFO(
+				"(AssetManager) Internal info: Built mesh LOD. Index: {}, LOD: {}, Triangles: {} -> {}, Error: {}",
+				mesh.Index, i + 1, mesh.Data.Indices.size() / 3, mesh.Data.LODs[i].NumIndices / 3, mesh.Data.LODs[i].Error
+			);
 	}
 
-	Result AssetManager::LoadTexture(const std::filesystem::path& modelPath, AssetID& outTextureID) noexcept
+	void ModelImporterImpl::LoadMeshlets(Mesh& mesh) noexcept
 	{
-		if (!std::filesystem::exists(modelPath))
+		BuildMeshlets(mesh.Data);
+
+		CM_ENGINE_LOG_INFO(
+			"(AssetManager) Internal info: Built meshlets. Index: {}, Triangles: {}, Meshlets: {}",
+			mesh.Index, mesh.Data.Indices.size() / 3, mesh.Data.Meshlets.size()
+		);
+	}
+
+	void ModelImporterImpl::LoadQuantized(Mesh& mesh) noexcept
+	{
+		QuantizeVertices(mesh.Data);
+
+		QuantizationError error = MeasureQuantizationError(mesh.Data);
+
+		CM_ENGINE_LOG_INFO(
+			"(AssetManager) Internal info: Quantized mesh vertices. Index: {}, Vertices: {}, "
+			"Max position error: {} ({} of AABB diagonal), Max normal error: {} degrees, Max texcoord error: {}",
+			mesh.Index, mesh.Data.Vertices.size(),
+			error.MaxPosition, error.MaxPositionRelative, error.MaxNormalDegrees, error.MaxTexCoord
+		);
+	}
+
+	void ModelImporterImpl::LoadMaterial(Material& material, ConstView<aiMaterial> pMaterial) noexcept
+	{
+		MaterialData& materialData = material.Data;
+
+		/* TODO: handle material.TextureID */
+		aiColor4D baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+		aiGetMaterialColor(pMaterial, AI_MATKEY_BASE_COLOR, &baseColor);
+		materialData.BaseColor = { baseColor.r, baseColor.g, baseColor.b, baseColor.a };
+
+		float metallic = 0.0f;
+		aiGetMaterialFloat(pMaterial, AI_MATKEY_METALLIC_FACTOR, &metallic);
+		materialData.Metallic = metallic;
+
+		float roughness = 0.0f;
+		aiGetMaterialFloat(pMaterial, AI_MATKEY_ROUGHNESS_FACTOR, &roughness);
+		materialData.Roughness = roughness;
+	}
+
+	/* Doesn't touch any AssetManager state, so it's safe to call from any thread. */
+	static Result ReadTexture(const std::filesystem::path& texturePath, const AssetPackSet& packs, Texture& outTexture) noexcept
+	{
+		PackedBytes packed;
+
+		if (packs.Read(texturePath, packed))
+		{
+			outTexture.Data = packed.Bytes;
+			outTexture.pStorage = std::move(packed.pStorage);
+			return ResultType::Succeeded;
+		}
+
+		std::shared_ptr<AMappedFile> pFile = std::make_shared<AMappedFile>();
+
+		if (pFile->Open(texturePath))
+		{
+			outTexture.Data = pFile->Bytes();
+			outTexture.pStorage = std::move(pFile);
+			return ResultType::Succeeded;
+		}
+
+		/* Only worth telling apart once mapping has already failed... */
+		std::error_code error;
+
+		if (!std::filesystem::exists(texturePath, error))
 		{
 			CM_ENGINE_LOG_WARN(
 				"(AssetManager) Internal warning: Provided texture path doesn't exist. Path: {}",
-				modelPath.generic_string()
+				texturePath.generic_string()
 			);
 
 			return ResultType::Failed_File_Absent;
 		}
 
-		std::ifstream stream(modelPath, std::ios::binary);
+		CM_ENGINE_LOG_WARN(
+			"(AssetManager) Internal warning: Failed to map texture file, (or it's empty) Path: {}",
+			texturePath.generic_string()
+		);
+
+		return ResultType::Failed_File_Import;
+	}
 
-		if (!stream.is_open())
-		{
-			CM_ENGINE_LOG_WARN(
-				"(AssetManager) Internal warning: Failed to open texture file. Path: {}",
-				modelPath.generic_string()
-			);
+	template <typename Ty>
+	static [[nodiscard]] uint64_t VectorBytes(const std::vector<Ty>& elements) noexcept
+	{
+		return elements.capacity() * sizeof(Ty);
+	}
+
+	/* What each asset keeps resident, as counted against it's type's budget. */
+	static [[nodiscard]] uint64_t ResidentBytes(const Model& model) noexcept
+	{
+		return sizeof(Model) + VectorBytes(model.Meshes) + VectorBytes(model.Materials);
+	}
+
+	static [[nodiscard]] uint64_t ResidentBytes(const Mesh& mesh) noexcept
+	{
+		const MeshData& data = mesh.Data;
+
+		return sizeof(Mesh) +
+			VectorBytes(data.Vertices) +
+			VectorBytes(data.Indices) +
+			VectorBytes(data.QuantizedVertices) +
+			VectorBytes(data.Meshlets) +
+			VectorBytes(data.LODIndices) +
+			VectorBytes(data.LODs);
+	}
+
+	static [[nodiscard]] uint64_t ResidentBytes(const Material&) noexcept
+	{
+		return sizeof(Material);
+	}
+
+	static [[nodiscard]] uint64_t ResidentBytes(const Texture& texture) noexcept
+	{
+		return sizeof(Texture) + texture.Bytes().size();
+	}
 
+	AssetManager::AssetManager() noexcept
+		: mP_ModelImporter(std::make_unique<ModelImporterImpl>()),
+		  m_LoadPool(std::min(ThreadPool::DefaultThreadCount(), S_MaxLoadThreads))
+	{
+ 	   Init();
+	}
+
+	AssetManager::~AssetManager() noexcept
+	{
+ 	   Shutdown();
+	}
+
+	void AssetManager::Init() noexcept
+	{
+		for (TypeMemory& memory : m_Memory)
+			memory.Stats.BudgetBytes = S_DefaultBudgetBytes;
+	}
+
+	void AssetManager::Shutdown() noexcept
+	{
+	}
+
+	Result AssetManager::LoadModel(const std::filesystem::path& modelPath, AssetID& outModelID, const ImportOptions& options) noexcept
+	{
+		ImportedModel imported;
+		Result result = mP_ModelImporter->ImportModel(modelPath, options, m_Packs, m_DerivedData, imported);
+
+		if (!result)
+			return result;
+
+		outModelID = RegisterModel(modelPath, std::move(imported));
+		return ResultType::Succeeded;
+	}
+
+	Result AssetManager::CookModel(const std::filesystem::path& modelPath, const std::filesystem::path& cookedPath, const ImportOptions& options) noexcept
+	{
+		ImportedModel imported;
+		Result result = mP_ModelImporter->ImportSource(modelPath, options, imported);
+
+		if (!result)
+			return result;
+
+		CookKey key;
+
+		/* A cooked file's key is only checked when it's loaded through the DerivedDataCache, so a source it can't key
+		 *   is still cooked, just with an empty one... */
+		(void)m_DerivedData.MakeKey(modelPath, options, G_ImportFlags, key);
+
+		if (!WriteCookedModel(cookedPath, imported, key))
 			return ResultType::Failed_File_Import;
-		}
 
-		size_t byteSize = std::filesystem::file_size(modelPath);
+		return ResultType::Succeeded;
+	}
+
+	Result AssetManager::CookTexture(const std::filesystem::path& texturePath, const std::filesystem::path& cookedPath, const TextureCookOptions& options) noexcept
+	{
+		Texture source;
+		Result result = ReadTexture(texturePath, m_Packs, source);
+
+		if (!result)
+			return result;
 
-		if (byteSize == 0)
+		AImageDecoder decoder;
+		DecodedImage image;
+
+		if (!decoder.Decode(source.Bytes(), image))
 		{
 			CM_ENGINE_LOG_WARN(
-				"(AssetManager) Internal warning: Texture file is empty. (byte size is 0) Path: {}",
-				modelPath.generic_string()
+				"(AssetManager) Internal warning: Failed to decode texture for cooking. Path: {}",
+				texturePath.generic_string()
 			);
 
 			return ResultType::Failed_File_Import;
 		}
 
-		outTextureID = AssetID::Registered(AssetType::Texture, NextGlobalID());
-		Texture& texture = m_TextureMap[outTextureID];
+		if (!WriteCookedTexture(cookedPath, image, options))
+			return ResultType::Failed_File_Import;
 
-		texture.pBuffer = std::move(std::unique_ptr<std::byte>(new std::byte[byteSize]));
-		texture.SizeBytes = byteSize;
+		return ResultType::Succeeded;
+	}
 
-		stream.read(
-			reinterpret_cast<char*>(texture.pBuffer.get()),
-			static_cast<std::streamsize>(texture.SizeBytes)
-		);
+	Result AssetManager::LoadTexture(const std::filesystem::path& modelPath, AssetID& outTextureID) noexcept
+	{
+		Texture texture;
+		Result result = ReadTexture(modelPath, m_Packs, texture);
+
+		if (!result)
+			return result;
 
+		outTextureID = RegisterTexture(std::move(texture));
 		return ResultType::Succeeded;
 	}
 
+	bool AssetManager::MountPack(const std::filesystem::path& packPath, const std::filesystem::path& mountRoot) noexcept
+	{
+		return m_Packs.Mount(packPath, mountRoot);
+	}
+
+	void AssetManager::UnmountPacks() noexcept
+	{
+		m_Packs.UnmountAll();
+	}
+
+	LoadHandle AssetManager::LoadModelAsync(const std::filesystem::path& modelPath, const ImportOptions& options, LoadCallback onLoaded) noexcept
+	{
+		return QueueLoad(AssetType::Model, modelPath, options, std::move(onLoaded));
+	}
+
+	LoadHandle AssetManager::LoadTextureAsync(const std::filesystem::path& texturePath, LoadCallback onLoaded) noexcept
+	{
+		return QueueLoad(AssetType::Texture, texturePath, ImportOptions(), std::move(onLoaded));
+	}
+
+	void AssetManager::Update() noexcept
+	{
+		++m_FrameIndex;
+
+		m_RegisteringLoads.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(m_FinishedMutex);
+			m_RegisteringLoads.swap(m_FinishedLoads);
+		}
+
+		for (uint32_t index : m_RegisteringLoads)
+		{
+			AsyncLoad& load = *m_Loads[index];
+
+			if (load.LoadResult)
+				load.ID = load.Type == AssetType::Model ?
+					RegisterModel(load.Path, std::move(load.ModelData)) :
+					RegisterTexture(std::move(load.TextureData));
+
+			load.IsRegistered = true;
+			--m_NumPendingLoads;
+
+			if (!load.OnLoaded)
+				continue;
+
+			/* Released before invoking, as the callback may well queue another load... */
+			LoadCallback onLoaded = std::move(load.OnLoaded);
+			Result result = load.LoadResult;
+			AssetID id = load.ID;
+
+			ReleaseLoad(index);
+			onLoaded(result, id);
+		}
+
+		ProcessReleases();
+		EvictOverBudget();
+	}
+
+	Result AssetManager::PollLoad(LoadHandle handle, AssetID& outID) noexcept
+	{
+		if (!handle.IsValid() || handle.Index >= m_Loads.size())
+			return ResultType::Invalid;
+
+		AsyncLoad& load = *m_Loads[handle.Index];
+
+		if (!load.IsActive || load.Serial != handle.Serial)
+			return ResultType::Invalid;
+		else if (!load.IsRegistered)
+			return ResultType::Failed_Load_Pending;
+
+		Result result = load.LoadResult;
+		outID = load.ID;
+
+		ReleaseLoad(handle.Index);
+		return result;
+	}
+
 	Result AssetManager::GetModel(AssetID id, ConstView<Model>& outModel) noexcept
 	{
-		using MapTy = decltype(m_ModelMap);
-		return GetAsset<MapTy, Model>(m_ModelMap, AssetType::Model, id, outModel);
+		return GetAsset(m_Models, AssetType::Model, id, outModel);
 	}
 
 	Result AssetManager::GetMesh(AssetID id, ConstView<Mesh>& outMesh) noexcept
 	{
-		using MapTy = decltype(m_MeshMap);
-		return GetAsset<MapTy, Mesh>(m_MeshMap, AssetType::Mesh, id, outMesh);
+		return GetAsset(m_Meshes, AssetType::Mesh, id, outMesh);
 	}
 
 	Result AssetManager::GetMaterial(AssetID id, ConstView<Material>& outMaterial) noexcept
 	{
-		using MapTy = decltype(m_MaterialMap);
-		return GetAsset<MapTy, Material>(m_MaterialMap, AssetType::Material, id, outMaterial);
+		return GetAsset(m_Materials, AssetType::Material, id, outMaterial);
 	}
 
 	Result AssetManager::GetTexture(AssetID id, ConstView<Texture>& outTexture) noexcept
 	{
-		using MapTy = decltype(m_TextureMap);
-		return GetAsset<MapTy, Texture>(m_TextureMap, AssetType::Texture, id, outTexture);
+		return GetAsset(m_Textures, AssetType::Texture, id, outTexture);
+	}
+
+	void AssetManager::ReleaseTextureData(AssetID id) noexcept
+	{
+		Texture* pTexture = m_Textures.Find(id);
+		AssetRecord* pRecord = FindRecord(id);
+
+		if (pTexture == nullptr || pRecord == nullptr || pTexture->pStorage == nullptr)
+			return;
+
+		pTexture->Data = std::span<const std::byte>();
+		pTexture->pStorage.reset();
+
+		uint64_t sizeBytes = ResidentBytes(*pTexture);
+		m_Memory[static_cast<size_t>(AssetType::Texture)].Stats.ResidentBytes -= pRecord->SizeBytes - sizeBytes;
+		pRecord->SizeBytes = sizeBytes;
 	}
 
 	Result AssetManager::DumpMesh(AssetID id) noexcept
 	{
 		ConstView<Mesh> mesh;
-		Result result = GetAsset<decltype(m_MeshMap), Mesh>(m_MeshMap, AssetType::Mesh, id, mesh);
+		Result result = GetAsset(m_Meshes, AssetType::Mesh, id, mesh);
 
 		if (!result)
 			return result;
@@ -375,7 +765,7 @@ namespace CMEngine::Asset
 		switch (id.Type())
 		{
 		case AssetType::Mesh:
-			return m_MeshMap.contains(id);
+			return m_Meshes.Contains(id);
 		case AssetType::Invalid: [[fallthrough]];
 		case AssetType::Material: [[fallthrough]];
 		case AssetType::Texture: [[fallthrough]];
@@ -384,15 +774,131 @@ namespace CMEngine::Asset
 		}
 	}
 
-	[[nodiscard]] uint32_t AssetManager::NextGlobalID() noexcept
+	[[nodiscard]] AssetID AssetManager::RegisterModel(const std::filesystem::path& modelPath, ImportedModel&& imported) noexcept
 	{
-		if (m_FreeGlobalIDs.empty())
-			return m_TotalAssetCount++;
+		AssetID modelID = NextID(AssetType::Model);
+		Model& model = m_Models.Emplace(modelID);
+		File& file = m_LoadedFiles[modelID];
+		file.Path = modelPath;
+
+		model.Meshes.reserve(imported.Meshes.size());
+		model.Materials.reserve(imported.Materials.size());
+
+		for (Mesh& mesh : imported.Meshes)
+		{
+			AssetID meshID = NextID(AssetType::Mesh);
+			model.Meshes.emplace_back(meshID);
+
+			mesh.ModelID = modelID;
+			Track(meshID, ResidentBytes(m_Meshes.Emplace(meshID, std::move(mesh))));
+		}
+
+		for (Material& material : imported.Materials)
+		{
+			AssetID materialID = NextID(AssetType::Material);
+			model.Materials.emplace_back(materialID);
+
+			material.ModelID = modelID;
+			Track(materialID, ResidentBytes(m_Materials.Emplace(materialID, std::move(material))));
+		}
+
+		Track(modelID, ResidentBytes(model));
+
+		CM_ENGINE_LOG_INFO(
+			"(AssetManager) Internal info: Successfully loaded model. Name: {}, GlobalID: {}", 
+			modelPath.generic_string(), modelID.GlobalID()
+		);
+
+		return modelID;
+	}
+
+	[[nodiscard]] AssetID AssetManager::RegisterTexture(Texture&& texture) noexcept
+	{
+		AssetID textureID = NextID(AssetType::Texture);
+		Track(textureID, ResidentBytes(m_Textures.Emplace(textureID, std::move(texture))));
+
+		return textureID;
+	}
+
+	[[nodiscard]] LoadHandle AssetManager::QueueLoad(AssetType type, const std::filesystem::path& path, const ImportOptions& options, LoadCallback onLoaded) noexcept
+	{
+		uint32_t index = 0;
+
+		if (m_FreeLoads.empty())
+		{
+			index = static_cast<uint32_t>(m_Loads.size());
+			m_Loads.emplace_back(std::make_unique<AsyncLoad>());
+		}
+		else
+		{
+			index = m_FreeLoads.back();
+			m_FreeLoads.pop_back();
+		}
+
+		AsyncLoad* pLoad = m_Loads[index].get();
+		pLoad->Type = type;
+		pLoad->Path = path;
+		pLoad->Options = options;
+		pLoad->OnLoaded = std::move(onLoaded);
+		pLoad->LoadResult = ResultType::Invalid;
+		pLoad->ID = AssetID();
+		pLoad->IsActive = true;
+		pLoad->IsRegistered = false;
+		++pLoad->Serial;
+
+		++m_NumPendingLoads;
+
+		/* The worker only touches it's own load until it's handed back through m_FinishedLoads... */
+		m_LoadPool.Submit(
+			[this, pLoad, index]()
+			{
+				if (pLoad->Type == AssetType::Model)
+					pLoad->LoadResult = mP_ModelImporter->ImportModel(pLoad->Path, pLoad->Options, m_Packs, m_DerivedData, pLoad->ModelData);
+				else
+					pLoad->LoadResult = ReadTexture(pLoad->Path, m_Packs, pLoad->TextureData);
+
+				std::lock_guard<std::mutex> lock(m_FinishedMutex);
+				m_FinishedLoads.emplace_back(index);
+			}
+		);
+
+		LoadHandle handle;
+		handle.Index = index;
+		handle.Serial = pLoad->Serial;
+
+		return handle;
+	}
+
+	void AssetManager::ReleaseLoad(uint32_t index) noexcept
+	{
+		AsyncLoad& load = *m_Loads[index];
+
+		load.Path.clear();
+		load.OnLoaded = nullptr;
+		load.ModelData = ImportedModel();
+		load.TextureData.Data = std::span<const std::byte>();
+		load.TextureData.pStorage.reset();
+		load.IsActive = false;
+
+		m_FreeLoads.emplace_back(index);
+	}
 
-		uint32_t next = m_FreeGlobalIDs.back();
-		m_FreeGlobalIDs.pop_back();
+	[[nodiscard]] AssetID AssetManager::NextID(AssetType type) noexcept
+	{
+		uint32_t globalID = 0;
 
-		return next;
+		if (m_FreeGlobalIDs.empty())
+		{
+			globalID = m_TotalAssetCount++;
+			m_Records.emplace_back();
+		}
+		else
+		{
+			globalID = m_FreeGlobalIDs.back();
+			m_FreeGlobalIDs.pop_back();
+		}
+
+		return AssetID::Registered(type, globalID, m_Records[globalID].Generation);
 	}
 
 	void AssetManager::CleanupID(AssetID& outHandle) noexcept
@@ -400,23 +906,234 @@ namespace CMEngine::Asset
 		if (!outHandle.IsRegistered() || outHandle.Type() == AssetType::Invalid)
 			return;
 
+		AssetID id = outHandle;
 		outHandle.SetRegistered(false);
 
-		switch (outHandle.Type())
+		switch (id.Type())
 		{
+		case AssetType::Model:
+		{
+			Model* pModel = m_Models.Find(id);
+
+			if (pModel == nullptr)
+				return;
+
+			/* It's children are unloaded on their own, once nothing else references them... */
+			for (AssetID meshID : pModel->Meshes)
+				Release(meshID);
+
+			for (AssetID materialID : pModel->Materials)
+				Release(materialID);
+
+			m_LoadedFiles.erase(id);
+			m_Models.Erase(id);
+			break;
+		}
 		case AssetType::Mesh:
-			if (auto it = m_MeshMap.find(outHandle); it != m_MeshMap.end())
-				m_MeshMap.erase(it);
+			if (!m_Meshes.Erase(id))
+				return;
 
 			break;
-		case AssetType::Material: /* TODO: Implement later... */
-		case AssetType::Texture: /* TODO: Implement later... */
+		case AssetType::Material:
+			if (!m_Materials.Erase(id))
+				return;
+
+			break;
+		case AssetType::Texture:
+			if (!m_Textures.Erase(id))
+				return;
+
 			break;
 		default:
 			return;
 		}
 
-		m_FreeGlobalIDs.emplace_back(outHandle.GlobalID());
+		AssetRecord& record = m_Records[id.GlobalID()];
+		AssetMemoryStats& stats = m_Memory[static_cast<size_t>(id.Type())].Stats;
+
+		stats.ResidentBytes -= record.SizeBytes;
+		--stats.NumResident;
+
+		if (record.IsUnreferenced)
+			--stats.NumUnreferenced;
+
+		/* Any other handle to it is now stale, (including any left in the type's Unreferenced list) */
+		uint32_t generation = record.Generation + 1;
+		record = AssetRecord();
+		record.Generation = generation;
+
+		m_FreeGlobalIDs.emplace_back(id.GlobalID());
+
+		for (const auto& [subscriptionID, onUnloaded] : m_UnloadCallbacks)
+			onUnloaded(id);
+	}
+
+	[[nodiscard]] uint32_t AssetManager::SubscribeUnload(UnloadCallback onUnloaded) noexcept
+	{
+		uint32_t subscriptionID = m_NextUnloadSubscription++;
+
+		m_UnloadCallbacks.emplace_back(subscriptionID, std::move(onUnloaded));
+		return subscriptionID;
+	}
+
+	void AssetManager::UnsubscribeUnload(uint32_t subscriptionID) noexcept
+	{
+		std::erase_if(
+			m_UnloadCallbacks,
+			[&](const std::pair<uint32_t, UnloadCallback>& callback) { return callback.first == subscriptionID; }
+		);
+	}
+
+	bool AssetManager::AddRef(AssetID id) noexcept
+	{
+		AssetRecord* pRecord = FindRecord(id);
+
+		if (pRecord == nullptr)
+			return false;
+
+		++pRecord->RefCount;
+
+		if (pRecord->IsUnreferenced)
+		{
+			pRecord->IsUnreferenced = false;
+			--m_Memory[static_cast<size_t>(id.Type())].Stats.NumUnreferenced;
+		}
+
+		return true;
+	}
+
+	bool AssetManager::Release(AssetID id) noexcept
+	{
+		AssetRecord* pRecord = FindRecord(id);
+
+		if (pRecord == nullptr || pRecord->RefCount == 0)
+			return false;
+
+		/* Deferred to Update, so an asset released and referenced again within a frame is never considered... */
+		if (--pRecord->RefCount == 0)
+			m_PendingReleases.emplace_back(id);
+
+		return true;
+	}
+
+	[[nodiscard]] uint32_t AssetManager::RefCount(AssetID id) const noexcept
+	{
+		const AssetRecord* pRecord = FindRecord(id);
+		return pRecord != nullptr ? pRecord->RefCount : 0;
+	}
+
+	void AssetManager::SetBudget(AssetType type, uint64_t budgetBytes) noexcept
+	{
+		if (!IsValidAssetType(type))
+			return;
+
+		m_Memory[static_cast<size_t>(type)].Stats.BudgetBytes = budgetBytes;
+	}
+
+	[[nodiscard]] AssetManager::AssetRecord* AssetManager::FindRecord(AssetID id) noexcept
+	{
+		return const_cast<AssetRecord*>(std::as_const(*this).FindRecord(id));
+	}
+
+	[[nodiscard]] const AssetManager::AssetRecord* AssetManager::FindRecord(AssetID id) const noexcept
+	{
+		if (!id.IsRegistered() || id.GlobalID() >= m_Records.size())
+			return nullptr;
+
+		const AssetRecord& record = m_Records[id.GlobalID()];
+		return record.Generation == id.Generation() ? &record : nullptr;
+	}
+
+	void AssetManager::Track(AssetID id, uint64_t sizeBytes) noexcept
+	{
+		AssetRecord& record = m_Records[id.GlobalID()];
+		record.SizeBytes = sizeBytes;
+		record.RefCount = 1;
+		record.LastUsedFrame = m_FrameIndex;
+
+		AssetMemoryStats& stats = m_Memory[static_cast<size_t>(id.Type())].Stats;
+		stats.ResidentBytes += sizeBytes;
+		++stats.NumResident;
+	}
+
+	void AssetManager::ProcessReleases() noexcept
+	{
+		for (AssetID id : m_PendingReleases)
+		{
+			AssetRecord* pRecord = FindRecord(id);
+
+			/* Referenced again since, or already unloaded... */
+			if (pRecord == nullptr || pRecord->RefCount != 0 || pRecord->IsUnreferenced)
+				continue;
+
+			TypeMemory& memory = m_Memory[static_cast<size_t>(id.Type())];
+
+			pRecord->IsUnreferenced = true;
+			pRecord->LastUsedFrame = m_FrameIndex;
+			++memory.Stats.NumUnreferenced;
+
+			if (!pRecord->IsListed)
+			{
+				pRecord->IsListed = true;
+				memory.Unreferenced.emplace_back(id);
+			}
+		}
+
+		m_PendingReleases.clear();
+	}
+
+	void AssetManager::EvictOverBudget() noexcept
+	{
+		/* In AssetType order, so models go first, as evicting one releases it's children to be evicted next frame. */
+		for (TypeMemory& memory : m_Memory)
+		{
+			bool isOverBudget = memory.Stats.ResidentBytes > memory.Stats.BudgetBytes && memory.Stats.NumUnreferenced != 0;
+			bool needsCompact = memory.Unreferenced.size() > 2 * static_cast<size_t>(memory.Stats.NumUnreferenced) + S_MinCompactSize;
+
+			if (!isOverBudget && !needsCompact)
+				continue;
+
+			std::erase_if(
+				memory.Unreferenced,
+				[this](AssetID id)
+				{
+					AssetRecord* pRecord = FindRecord(id);
+
+					/* Unloaded, the record (if reused) no longer refers to this entry... */
+					if (pRecord == nullptr)
+						return true;
+					else if (pRecord->IsUnreferenced)
+						return false;
+
+					pRecord->IsListed = false;
+					return true;
+				}
+			);
+
+			if (!isOverBudget)
+				continue;
+
+			std::sort(
+				memory.Unreferenced.begin(),
+				memory.Unreferenced.end(),
+				[this](AssetID lhs, AssetID rhs)
+				{
+					return m_Records[lhs.GlobalID()].LastUsedFrame < m_Records[rhs.GlobalID()].LastUsedFrame;
+				}
+			);
+
+			size_t numEvicted = 0;
+
+			while (numEvicted < memory.Unreferenced.size() && memory.Stats.ResidentBytes > memory.Stats.BudgetBytes)
+			{
+				AssetID id = memory.Unreferenced[numEvicted++];
+				CleanupID(id);
+
+				++memory.Stats.NumEvicted;
+			}
+
+			memory.Unreferenced.erase(memory.Unreferenced.begin(), memory.Unreferenced.begin() + numEvicted);
+		}
 	}
 
 	void AssetManager::DumpFloat3(std::ofstream& stream, const Float3& f3) noexcept
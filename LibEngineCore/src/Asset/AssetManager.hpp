@@ -1,14 +1,21 @@
 #pragma once
 
 #include "Asset/Asset.hpp"
+#include "Asset/DerivedDataCache.hpp"
+#include "Asset/AssetPack.hpp"
+#include "Asset/TextureCooker.hpp"
+#include "Asset/SlotArray.hpp"
+#include "ThreadPool.hpp"
 #include "Types.hpp"
 
 #include <spdlog/logger.h>
 
 #include <unordered_map>
+#include <array>
 #include <memory>
 #include <functional>
 #include <filesystem>
+#include <mutex>
 
 namespace CMEngine::Asset
 {
@@ -24,6 +31,7 @@ namespace CMEngine::Asset
 		Failed_Handle_Already_Mapped,
 		Failed_Handle_Mismatching_Asset_Type,
 		Failed_Handle_Mismatching_Mapped_Type,
+		Failed_Load_Pending,
 		Failed = 0,
 		Succeeded
 	};
@@ -61,6 +69,7 @@ namespace CMEngine::Asset
 			case ResultType::Failed_Handle_Already_Mapped:		    return std::string_view("Failed_Handle_Already_Mapped");
 			case ResultType::Failed_Handle_Mismatching_Asset_Type:  return std::string_view("Failed_Handle_Mismatching_Asset_Type");
 			case ResultType::Failed_Handle_Mismatching_Mapped_Type: return std::string_view("Failed_Handle_Mismatching_Mapped_Type");
+			case ResultType::Failed_Load_Pending:					return std::string_view("Failed_Load_Pending");
 			case ResultType::Failed:							    return std::string_view("Failed");
 			case ResultType::Succeeded:							    return std::string_view("Succeeded");
 			default:											    return std::string_view("Unknown");
@@ -91,6 +100,68 @@ namespace CMEngine::Asset
 		std::filesystem::path Path;
 	};
 
+	/* Of what ModelImporterImpl itself produces from assimp's output, (see DerivedDataCache.hpp) bump it
+	 *   whenever that changes. (ex. a new vertex attribute, or reading a material differently) */
+	inline constexpr uint32_t G_ModelImporterVersion = 1;
+
+	struct ImportOptions
+	{
+		/* Reorders each mesh's triangles and vertices for the post-transform cache, overdraw and
+		 *   vertex fetch. (See MeshOptimizer.hpp) The ACMR / ATVR before and after is logged per mesh. */
+		bool OptimizeMeshes = true;
+
+		/* Simplifies each mesh into progressively coarser LODs, (see MeshSimplifier.hpp) which the renderer
+		 *   picks between per instance by it's size on screen. The triangles and error per LOD are logged per mesh. */
+		bool GenerateLODs = true;
+
+		/* Splits each mesh into Meshlets, (see Meshlets.hpp) which lets the renderer cull and draw parts of
+		 *   a mesh at a time. Only worth it for dense meshes, as culled instances then take a draw per visible range. */
+		bool BuildMeshlets = false;
+
+		/* Also stores each mesh's vertices as QuantizedVertex's, (half the size) which the renderer
+		 *   then uploads instead. The worst case error is measured and logged per mesh. */
+		bool QuantizeVertices = false;
+
+		/* Loads the model from the DerivedDataCache, cooking it into it first on a miss. A cooked model
+		 *   is only mapped and copied, (see CookedMesh.hpp) skipping assimp and every step above. */
+		bool UseCookedMeshes = true;
+	};
+
+	/* Everything imported from a model file, before any of it is registered. */
+	struct ImportedModel
+	{
+		std::vector<Mesh> Meshes;
+		std::vector<Material> Materials;
+	};
+
+	/* A LoadModelAsync / LoadTextureAsync request, valid until it's result is retrieved. */
+	struct LoadHandle
+	{
+		static constexpr uint32_t S_InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		uint32_t Index = S_InvalidIndex;
+		uint32_t Serial = 0; /* Distinguishes loads re-using the same index. */
+
+		inline constexpr [[nodiscard]] bool IsValid() const noexcept { return Index != S_InvalidIndex; }
+	};
+
+	/* Invoked by AssetManager::Update, (on it's caller's thread) with the loaded asset's ID, which is invalid if @result failed. */
+	using LoadCallback = std::function<void(Result result, AssetID id)>;
+
+	/* Invoked with every asset AssetManager unloads, (evicted or unregistered) once it's already stale,
+	 *   so whatever was derived from it (ex. GPU resources) can be freed too. */
+	using UnloadCallback = std::function<void(AssetID id)>;
+
+	/* Per asset type, see AssetManager::SetBudget. */
+	struct AssetMemoryStats
+	{
+		uint64_t ResidentBytes = 0;
+		uint64_t BudgetBytes = 0;
+		uint32_t NumResident = 0;
+		uint32_t NumUnreferenced = 0; /* Resident, but free to be evicted. */
+		uint32_t NumEvicted = 0; /* In total. */
+	};
+
 	class AssetManager
 	{
 	public:
@@ -102,51 +173,185 @@ namespace CMEngine::Asset
 
 		/* Mesh and material data can then be retrieved using GetModel(modelID),
 		 *    and then GetModel or GetMaterial with any of it's children.
-		 * May return an invalid AssetID if a file of @modelPath doesn't exist. */
-		Result LoadModel(const std::filesystem::path& modelPath, AssetID& outModelID) noexcept;
+		 * May return an invalid AssetID if a file of @modelPath doesn't exist.
+		 *
+		 * Every loaded asset is handed out with one reference, which the caller releases once done with it. (see Release) */
+		Result LoadModel(const std::filesystem::path& modelPath, AssetID& outModelID, const ImportOptions& options = ImportOptions()) noexcept;
+
+		/* Imports @modelPath from source and writes it to @cookedPath as a .cmmesh, which LoadModel can then be given directly. */
+		Result CookModel(const std::filesystem::path& modelPath, const std::filesystem::path& cookedPath, const ImportOptions& options = ImportOptions()) noexcept;
+
+		/* Decodes @texturePath on the CPU and writes it to @cookedPath as a mipped, (and by default block compressed) .dds,
+		 *   which LoadTexture can then be given directly, skipping the decode and mip generation at runtime. */
+		Result CookTexture(const std::filesystem::path& texturePath, const std::filesystem::path& cookedPath, const TextureCookOptions& options = TextureCookOptions()) noexcept;
 
 		Result LoadTexture(const std::filesystem::path& modelPath, AssetID& outTextureID) noexcept;
+
+		/* Maps @packPath, (a .cmpak, see AssetPack.hpp) after which every load of a path under @mountRoot is resolved from it
+		 *   first, newest mount first, and only then from loose files. A packed model is used as cooked by the packer,
+		 *   whatever ImportOptions it's loaded with. */
+		bool MountPack(const std::filesystem::path& packPath, const std::filesystem::path& mountRoot) noexcept;
+
+		/* Assets already loaded from a pack stay valid. */
+		void UnmountPacks() noexcept;
+
+		/* Reads and imports the file on a worker thread, returning immediately. The asset is registered by the first Update
+		 *   after it finishes, which then invokes @onLoaded if provided, or otherwise holds the result for PollLoad. */
+		LoadHandle LoadModelAsync(
+			const std::filesystem::path& modelPath,
+			const ImportOptions& options = ImportOptions(),
+			LoadCallback onLoaded = nullptr
+		) noexcept;
+
+		LoadHandle LoadTextureAsync(
+			const std::filesystem::path& texturePath,
+			LoadCallback onLoaded = nullptr
+		) noexcept;
+
+		/* Registers every finished asynchronous load, and invokes their callbacks. Called once per frame by EngineCore::Update. */
+		void Update() noexcept;
+
+		/* Returns Failed_Load_Pending until the load is registered by Update, after which it's result is returned once,
+		 *   (with @outID) and @handle is released. Loads with a callback are released after it instead, and return Invalid. */
+		Result PollLoad(LoadHandle handle, AssetID& outID) noexcept;
+
+		/* Queued or running, as of the last Update. */
+		inline [[nodiscard]] uint32_t NumPendingLoads() const noexcept { return m_NumPendingLoads; }
+
+		inline [[nodiscard]] DerivedDataCache& DerivedData() noexcept { return m_DerivedData; }
+		inline [[nodiscard]] const DerivedDataCache& DerivedData() const noexcept { return m_DerivedData; }
 		
-		/* Note: The underlying pointers may become invalidated if the corresponding bucket of the asset type resizes via asset loading.
-		 *       Best practice should be ensuring ConstView's are temporary and synchronous. */
+		/* Note: The underlying pointers stay valid until the asset is unregistered, as each asset type is stored in a SlotArray.
+		 *       A handle that outlives it's asset fails with Failed_Handle_Not_Mapped, even once it's GlobalID is reused. */
 		Result GetModel(AssetID id, ConstView<Model>& outModel) noexcept;
 		Result GetMesh(AssetID id, ConstView<Mesh>& outMesh) noexcept;
 		Result GetMaterial(AssetID id, ConstView<Material>& outMaterial) noexcept;
 		Result GetTexture(AssetID id, ConstView<Texture>& outTexture) noexcept;
 
+		/* Unmaps @id's file once it's been uploaded, as nothing reads it's bytes after. The asset itself stays registered. */
+		void ReleaseTextureData(AssetID id) noexcept;
+
 		Result DumpMesh(AssetID id) noexcept;
 
 		/* Returns true if the handle was registered previously; false otherwise. */
 		bool Unregister(AssetID& outID) noexcept;
 
 		[[nodiscard]] bool IsMapped(AssetID id) noexcept;
+
+		/* Returns false if @id isn't registered. */
+		bool AddRef(AssetID id) noexcept;
+
+		/* An asset isn't unloaded once it's last reference is released, it's only evicted by Update once it's type
+		 *   is over budget, least recently used first. Until then, another reference keeps it resident.
+		 * A model holds a reference to each of it's meshes and materials, which it releases once it's unloaded. */
+		bool Release(AssetID id) noexcept;
+
+		[[nodiscard]] uint32_t RefCount(AssetID id) const noexcept;
+
+		/* Referenced assets are never evicted, so a type may still exceed it's budget. */
+		void SetBudget(AssetType type, uint64_t budgetBytes) noexcept;
+
+		inline [[nodiscard]] const AssetMemoryStats& MemoryStats(AssetType type) const noexcept { return m_Memory[static_cast<size_t>(type)].Stats; }
+
+		/* Returns the ID to unsubscribe with, which must happen before anything @onUnloaded uses is destroyed. */
+		[[nodiscard]] uint32_t SubscribeUnload(UnloadCallback onUnloaded) noexcept;
+		void UnsubscribeUnload(uint32_t subscriptionID) noexcept;
 	private:
-		template <typename MapTy, typename AssetTy>
+		struct AsyncLoad
+		{
+			AssetType Type = AssetType::Invalid;
+			std::filesystem::path Path;
+			ImportOptions Options;
+			LoadCallback OnLoaded;
+			ImportedModel ModelData; /* Written by the worker. */
+			Texture TextureData;     /* Written by the worker. */
+			Result LoadResult = ResultType::Invalid;
+			AssetID ID;
+			uint32_t Serial = 0;
+			bool IsActive = false;
+			bool IsRegistered = false;
+		};
+
+		struct AssetRecord
+		{
+			uint64_t SizeBytes = 0;
+			uint32_t Generation = 0;
+			uint32_t RefCount = 0;
+			uint32_t LastUsedFrame = 0;
+			bool IsUnreferenced = false;
+			bool IsListed = false; /* In it's type's TypeMemory::Unreferenced. */
+		};
+
+		struct TypeMemory
+		{
+			AssetMemoryStats Stats;
+			std::vector<AssetID> Unreferenced; /* Also holds entries referenced again or unloaded since, dropped when compacted. */
+		};
+
+		/* Registers everything imported by ImportModel / ReadTexture, assigning it's IDs. */
+		[[nodiscard]] AssetID RegisterModel(const std::filesystem::path& modelPath, ImportedModel&& imported) noexcept;
+		[[nodiscard]] AssetID RegisterTexture(Texture&& texture) noexcept;
+
+		[[nodiscard]] LoadHandle QueueLoad(AssetType type, const std::filesystem::path& path, const ImportOptions& options, LoadCallback onLoaded) noexcept;
+		void ReleaseLoad(uint32_t index) noexcept;
+
+		template <typename AssetTy>
 		inline [[nodiscard]] Result GetAsset(
-			const MapTy& map,
+			const SlotArray<AssetTy>& slots,
 			AssetType assetType,
 			AssetID id,
 			ConstView<AssetTy>& outAsset
 		) noexcept;
 
-		[[nodiscard]] uint32_t NextGlobalID() noexcept;
+		/* Returns a registered ID of @type, with the current generation of the GlobalID it's given. */
+		[[nodiscard]] AssetID NextID(AssetType type) noexcept;
 
 		void CleanupID(AssetID& outID) noexcept;
 
+		/* Returns nullptr if @id isn't registered, or is stale. */
+		[[nodiscard]] AssetRecord* FindRecord(AssetID id) noexcept;
+		[[nodiscard]] const AssetRecord* FindRecord(AssetID id) const noexcept;
+
+		/* Counts a newly registered asset as resident, with it's first reference. */
+		void Track(AssetID id, uint64_t sizeBytes) noexcept;
+
+		/* Run by Update, at the frame boundary. */
+		void ProcessReleases() noexcept;
+		void EvictOverBudget() noexcept;
+
 		void DumpFloat3(std::ofstream& stream, const Float3& f3) noexcept;
 	private:
+		static constexpr uint32_t S_MaxLoadThreads = 4;
+		static constexpr size_t S_NumAssetTypes = static_cast<size_t>(AssetType::Texture) + 1;
+		static constexpr uint64_t S_DefaultBudgetBytes = 512ull * 1024 * 1024;
+		static constexpr size_t S_MinCompactSize = 64; /* Unreferenced entries tolerated before compacting a type's list. */
 		uint32_t m_TotalAssetCount = 0;
 		std::unique_ptr<ModelImporterImpl> mP_ModelImporter;
 		std::vector<GlobalID> m_FreeGlobalIDs;
 		std::unordered_map<AssetID, File> m_LoadedFiles;
-		std::unordered_map<AssetID, Model> m_ModelMap;
-		std::unordered_map<AssetID, Mesh> m_MeshMap;
-		std::unordered_map<AssetID, Material> m_MaterialMap;
-		std::unordered_map<AssetID, Texture> m_TextureMap;
+		std::vector<AssetRecord> m_Records; /* Indexed by GlobalID. */
+		std::array<TypeMemory, S_NumAssetTypes> m_Memory;
+		std::vector<AssetID> m_PendingReleases;
+		std::vector<std::pair<uint32_t, UnloadCallback>> m_UnloadCallbacks; /* By subscription ID. */
+		uint32_t m_NextUnloadSubscription = 0;
+		uint32_t m_FrameIndex = 0;
+		SlotArray<Model> m_Models;
+		SlotArray<Mesh> m_Meshes;
+		SlotArray<Material> m_Materials;
+		SlotArray<Texture> m_Textures;
+		std::vector<std::unique_ptr<AsyncLoad>> m_Loads; /* Boxed, so workers can keep a pointer to theirs while this grows. */
+		std::vector<uint32_t> m_FreeLoads;
+		std::vector<uint32_t> m_FinishedLoads; /* Appended to by the workers, guarded by m_FinishedMutex. */
+		std::vector<uint32_t> m_RegisteringLoads;
+		std::mutex m_FinishedMutex;
+		uint32_t m_NumPendingLoads = 0;
+		DerivedDataCache m_DerivedData;
+		AssetPackSet m_Packs;
+		ThreadPool m_LoadPool; /* Declared last, so it's workers are joined before anything they write to is destroyed. */
 	};
 
-	template <typename MapTy, typename AssetTy>
-	inline [[nodiscard]] Result AssetManager::GetAsset(const MapTy& map, AssetType assetType, AssetID id, ConstView<AssetTy>& outAsset) noexcept
+	template <typename AssetTy>
+	inline [[nodiscard]] Result AssetManager::GetAsset(const SlotArray<AssetTy>& slots, AssetType assetType, AssetID id, ConstView<AssetTy>& outAsset) noexcept
 	{
 		outAsset = nullptr;
 
@@ -155,11 +360,90 @@ namespace CMEngine::Asset
 		else if (!id.IsRegistered())
 			return ResultType::Failed_Handle_Not_Registered;
 
-		auto it = map.find(id);
-		if (it == map.end())
+		const AssetTy* pAsset = slots.Find(id);
+		if (pAsset == nullptr)
 			return ResultType::Failed_Handle_Not_Mapped;
 
-		outAsset = &it->second;
+		m_Records[id.GlobalID()].LastUsedFrame = m_FrameIndex;
+		outAsset = pAsset;
 		return ResultType::Succeeded;
 	}
+	/* Holds a reference to an asset for as long as it lives, (see AssetManager::AddRef / Release)
+	 *   so the asset can't be evicted while anything still holds one. */
+	class AssetRef
+	{
+	public:
+		AssetRef() = default;
+
+		/* Adds a reference, so @id's own reference (if any) is still the caller's to release. */
+		inline AssetRef(AssetManager& manager, AssetID id) noexcept
+		{
+			if (manager.AddRef(id))
+			{
+				mP_Manager = &manager;
+				m_ID = id;
+			}
+		}
+
+		inline ~AssetRef() noexcept
+		{
+			Reset();
+		}
+
+		inline AssetRef(const AssetRef& other) noexcept
+			: AssetRef()
+		{
+			*this = other;
+		}
+
+		inline AssetRef(AssetRef&& other) noexcept
+			: mP_Manager(std::exchange(other.mP_Manager, nullptr)),
+			  m_ID(std::exchange(other.m_ID, AssetID()))
+		{
+		}
+
+		inline AssetRef& operator=(const AssetRef& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			Reset();
+
+			if (other.mP_Manager != nullptr && other.mP_Manager->AddRef(other.m_ID))
+			{
+				mP_Manager = other.mP_Manager;
+				m_ID = other.m_ID;
+			}
+
+			return *this;
+		}
+
+		inline AssetRef& operator=(AssetRef&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			Reset();
+
+			mP_Manager = std::exchange(other.mP_Manager, nullptr);
+			m_ID = std::exchange(other.m_ID, AssetID());
+
+			return *this;
+		}
+
+		inline void Reset() noexcept
+		{
+			if (mP_Manager != nullptr)
+				mP_Manager->Release(m_ID);
+
+			mP_Manager = nullptr;
+			m_ID = AssetID();
+		}
+
+		inline [[nodiscard]] AssetID ID() const noexcept { return m_ID; }
+		inline [[nodiscard]] bool IsValid() const noexcept { return mP_Manager != nullptr; }
+	private:
+		AssetManager* mP_Manager = nullptr;
+		AssetID m_ID;
+	};
 }
\ No newline at end of file
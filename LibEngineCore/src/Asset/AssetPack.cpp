@@ -0,0 +1,407 @@
+#include "PCH.hpp"
+#include "Asset/AssetPack.hpp"
+#include "MappedFile.hpp"
+#include "Hash.hpp"
+#include "LZ4.hpp"
+#include "FileUtil.hpp"
+#include "Log.hpp"
+
+namespace CMEngine::Asset
+{
+	/* Anything that changes the pack's layout must bump the version, which makes every existing .cmpak unmountable. */
+	inline constexpr uint32_t G_AssetPackMagic = 0x4B504D43; /* "CMPK" */
+	inline constexpr uint32_t G_AssetPackVersion = 1;
+	inline constexpr uint64_t G_PackBlobAlignment = 4096; /* A page, so no blob shares it's first or last page with another. */
+
+	/* LZ4 can't expand data by more than this, so anything beyond it is corrupt. */
+	inline constexpr uint64_t G_MaxLZ4Ratio = 256;
+
+	/* Compressed entries are decompressed whole into memory, so the table of contents (which may be corrupt)
+	 *   can't request more than this per entry. Larger files are packed uncompressed, and only ever mapped. */
+	inline constexpr uint64_t G_MaxDecompressedBytes = 2ull * 1024 * 1024 * 1024;
+
+	struct PackHeader
+	{
+		uint32_t Magic = G_AssetPackMagic;
+		uint32_t Version = G_AssetPackVersion;
+		uint32_t NumEntries = 0;
+		uint32_t Reserved = 0;
+		uint64_t FileSizeBytes = 0;
+	};
+
+	static_assert(std::is_trivially_copyable_v<PackHeader>, "Pack data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<PackEntry>, "Pack data must be trivially copyable, as it's written as is.");
+
+	static [[nodiscard]] uint64_t AlignBlob(uint64_t offsetBytes) noexcept
+	{
+		return (offsetBytes + G_PackBlobAlignment - 1) & ~(G_PackBlobAlignment - 1);
+	}
+
+	static [[nodiscard]] std::filesystem::path NormalizeRoot(const std::filesystem::path& mountRoot) noexcept
+	{
+		std::error_code error;
+		std::filesystem::path root = std::filesystem::absolute(mountRoot, error);
+
+		if (error)
+			root = mountRoot;
+
+		root = root.lexically_normal();
+
+		/* "a/b/" would otherwise leave every relative path starting with "../b"... */
+		if (!root.has_filename() && root.has_relative_path())
+			root = root.parent_path();
+
+		return root;
+	}
+
+	/* Returns false if @path doesn't lie under @normalizedRoot. */
+	static [[nodiscard]] bool MakeRelative(const std::filesystem::path& path, const std::filesystem::path& normalizedRoot, std::filesystem::path& outRelativePath) noexcept
+	{
+		std::error_code error;
+		std::filesystem::path absolutePath = path.is_absolute() ? path : std::filesystem::absolute(path, error);
+
+		if (error)
+			return false;
+
+		outRelativePath = absolutePath.lexically_normal().lexically_relative(normalizedRoot);
+		return !outRelativePath.empty() && *outRelativePath.begin() != "..";
+	}
+
+	[[nodiscard]] uint64_t HashPackPath(const std::filesystem::path& relativePath) noexcept
+	{
+		std::u8string key = relativePath.lexically_normal().generic_u8string();
+
+		for (char8_t& c : key)
+			if (c >= u8'A' && c <= u8'Z')
+				c = static_cast<char8_t>(c - u8'A' + u8'a');
+
+		return XXHash64::Hash(std::as_bytes(std::span<const char8_t>(key)));
+	}
+
+	AssetPack::AssetPack() noexcept = default;
+	AssetPack::~AssetPack() noexcept = default;
+
+	[[nodiscard]] bool AssetPack::Open(const std::filesystem::path& packPath, const std::filesystem::path& mountRoot) noexcept
+	{
+		std::unique_ptr<AMappedFile> pFile = std::make_unique<AMappedFile>();
+
+		if (!pFile->Open(packPath))
+		{
+			CM_ENGINE_LOG_WARN(
+				"(AssetPack) Internal warning: Failed to map asset pack. Path: {}",
+				packPath.generic_string()
+			);
+
+			return false;
+		}
+
+		std::span<const std::byte> file = pFile->Bytes();
+		PackHeader header;
+
+		if (file.size() >= sizeof(PackHeader))
+			std::memcpy(&header, file.data(), sizeof(header));
+
+		bool isValid =
+			file.size() >= sizeof(PackHeader) &&
+			header.Magic == G_AssetPackMagic &&
+			header.Version == G_AssetPackVersion &&
+			header.FileSizeBytes == file.size() &&
+			(file.size() - sizeof(PackHeader)) / sizeof(PackEntry) >= header.NumEntries;
+
+		std::vector<PackEntry> entries;
+
+		if (isValid)
+		{
+			entries.resize(header.NumEntries);
+
+			if (!entries.empty())
+				std::memcpy(entries.data(), file.data() + sizeof(PackHeader), entries.size() * sizeof(PackEntry));
+		}
+
+		for (size_t i = 0; isValid && i < entries.size(); ++i)
+		{
+			const PackEntry& entry = entries[i];
+
+			isValid =
+				entry.SizeBytes <= file.size() &&
+				entry.OffsetBytes <= file.size() - entry.SizeBytes &&
+				(i == 0 || entries[i - 1].PathHash < entry.PathHash);
+
+			if (entry.Compression == PackCompression::None)
+				isValid = isValid && entry.UncompressedSizeBytes == entry.SizeBytes;
+			else if (entry.Compression == PackCompression::LZ4)
+				isValid = isValid &&
+					entry.UncompressedSizeBytes <= entry.SizeBytes * G_MaxLZ4Ratio &&
+					entry.UncompressedSizeBytes <= G_MaxDecompressedBytes;
+			else
+				isValid = false;
+		}
+
+		if (!isValid)
+		{
+			CM_ENGINE_LOG_WARN(
+				"(AssetPack) Internal warning: Asset pack is corrupt, or of another version. Path: {}",
+				packPath.generic_string()
+			);
+
+			return false;
+		}
+
+		mP_File = std::move(pFile);
+		m_Path = packPath;
+		m_MountRoot = NormalizeRoot(mountRoot);
+		m_Entries = std::move(entries);
+
+		return true;
+	}
+
+	[[nodiscard]] const PackEntry* AssetPack::Find(const std::filesystem::path& path) const noexcept
+	{
+		std::filesystem::path relativePath;
+
+		if (m_Entries.empty() || !MakeRelative(path, m_MountRoot, relativePath))
+			return nullptr;
+
+		uint64_t pathHash = HashPackPath(relativePath);
+
+		auto entryIt = std::lower_bound(
+			m_Entries.begin(),
+			m_Entries.end(),
+			pathHash,
+			[](const PackEntry& entry, uint64_t hash) { return entry.PathHash < hash; }
+		);
+
+		return entryIt != m_Entries.end() && entryIt->PathHash == pathHash ? &*entryIt : nullptr;
+	}
+
+	[[nodiscard]] std::span<const std::byte> AssetPack::StoredBytes(const PackEntry& entry) const noexcept
+	{
+		if (mP_File == nullptr)
+			return std::span<const std::byte>();
+
+		return mP_File->Bytes().subspan(entry.OffsetBytes, entry.SizeBytes);
+	}
+
+	bool AssetPackSet::Mount(const std::filesystem::path& packPath, const std::filesystem::path& mountRoot) noexcept
+	{
+		std::shared_ptr<AssetPack> pPack = std::make_shared<AssetPack>();
+
+		if (!pPack->Open(packPath, mountRoot))
+			return false;
+
+		CM_ENGINE_LOG_INFO(
+			"(AssetPack) Internal info: Mounted asset pack. Path: {}, Entries: {}",
+			packPath.generic_string(), pPack->NumEntries()
+		);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Packs.insert(m_Packs.begin(), std::move(pPack));
+
+		return true;
+	}
+
+	void AssetPackSet::UnmountAll() noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Packs.clear();
+	}
+
+	[[nodiscard]] bool AssetPackSet::Read(const std::filesystem::path& path, PackedBytes& outBytes) const noexcept
+	{
+		outBytes = PackedBytes();
+
+		std::shared_ptr<const AssetPack> pPack;
+		const PackEntry* pEntry = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (const std::shared_ptr<const AssetPack>& pMounted : m_Packs)
+				if ((pEntry = pMounted->Find(path)) != nullptr)
+				{
+					pPack = pMounted;
+					break;
+				}
+		}
+
+		if (pEntry == nullptr)
+			return false;
+
+		std::span<const std::byte> stored = pPack->StoredBytes(*pEntry);
+
+		/* Used in place, the pack stays mapped for as long as they're held... */
+		if (pEntry->Compression == PackCompression::None)
+		{
+			outBytes.Bytes = stored;
+			outBytes.pStorage = std::move(pPack);
+			return true;
+		}
+
+		/* Decompressed outside of the lock, as it's by far the slowest part. (and into uninitialized memory, as it's all overwritten)
+		 *   Allocated without throwing, as even a size Open allowed may not fit in memory at the time. */
+		std::shared_ptr<std::byte[]> pDecompressed(new (std::nothrow) std::byte[pEntry->UncompressedSizeBytes]);
+
+		if (pDecompressed == nullptr)
+		{
+			CM_ENGINE_LOG_WARN(
+				"(AssetPack) Internal warning: Failed to allocate memory to decompress packed file into. Pack: {}, Path: {}, Size: {}",
+				pPack->Path().generic_string(), path.generic_string(), pEntry->UncompressedSizeBytes
+			);
+
+			return false;
+		}
+
+		std::span<std::byte> decompressed(pDecompressed.get(), pEntry->UncompressedSizeBytes);
+
+		if (!LZ4::Decompress(stored, decompressed))
+		{
+			CM_ENGINE_LOG_WARN(
+				"(AssetPack) Internal warning: Packed file is corrupt. Pack: {}, Path: {}",
+				pPack->Path().generic_string(), path.generic_string()
+			);
+
+			return false;
+		}
+
+		outBytes.Bytes = decompressed;
+		outBytes.pStorage = std::move(pDecompressed);
+		return true;
+	}
+
+	[[nodiscard]] bool AssetPackSet::IsEmpty() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Packs.empty();
+	}
+
+	static [[nodiscard]] bool WriteBytes(std::ofstream& stream, const void* pBytes, uint64_t numBytes) noexcept
+	{
+		stream.write(reinterpret_cast<const char*>(pBytes), static_cast<std::streamsize>(numBytes));
+		return static_cast<bool>(stream);
+	}
+
+	static [[nodiscard]] bool WritePadding(std::ofstream& stream, uint64_t numBytes) noexcept
+	{
+		static constexpr std::array<char, G_PackBlobAlignment> S_Zeros = {};
+
+		for (uint64_t written = 0; written < numBytes; written += S_Zeros.size())
+			if (!WriteBytes(stream, S_Zeros.data(), std::min<uint64_t>(S_Zeros.size(), numBytes - written)))
+				return false;
+
+		return true;
+	}
+
+	[[nodiscard]] bool WritePack(const std::filesystem::path& packPath, std::span<const PackSource> sources) noexcept
+	{
+		std::vector<PackEntry> entries(sources.size());
+		std::vector<uint32_t> order(sources.size());
+
+		for (size_t i = 0; i < sources.size(); ++i)
+		{
+			if (sources[i].Key.empty() || sources[i].Key.is_absolute())
+			{
+				CM_ENGINE_LOG_WARN(
+					"(AssetPack) Internal warning: Packed path must be relative to the mount root. Path: {}",
+					sources[i].Key.generic_string()
+				);
+
+				return false;
+			}
+
+			entries[i].PathHash = HashPackPath(sources[i].Key);
+			order[i] = static_cast<uint32_t>(i);
+		}
+
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return entries[a].PathHash < entries[b].PathHash; });
+
+		for (size_t i = 1; i < order.size(); ++i)
+			if (entries[order[i - 1]].PathHash == entries[order[i]].PathHash)
+			{
+				CM_ENGINE_LOG_WARN(
+					"(AssetPack) Internal warning: Packed paths collide, (or are the same) Path: {}, Path: {}",
+					sources[order[i - 1]].Key.generic_string(), sources[order[i]].Key.generic_string()
+				);
+
+				return false;
+			}
+
+		/* Only replaces the previous pack once fully written, so a failed or interrupted pack never leaves a broken one behind... */
+		return WriteFileReplacing(
+			packPath,
+			[&](std::ofstream& stream)
+			{
+				/* The header and table of contents are written last, once every blob's offset is known... */
+				uint64_t offsetBytes = AlignBlob(sizeof(PackHeader) + entries.size() * sizeof(PackEntry));
+				bool isWritten = WritePadding(stream, offsetBytes);
+
+				std::vector<std::byte> compressed;
+
+				/* Blobs are kept in the order given, (rather than by hash) so files loaded together can be kept together. */
+				for (size_t i = 0; isWritten && i < sources.size(); ++i)
+				{
+					const PackSource& source = sources[i];
+					PackEntry& entry = entries[i];
+					entry.OffsetBytes = offsetBytes;
+
+					AMappedFile sourceFile;
+
+					if (!sourceFile.Open(source.FilePath))
+					{
+						/* Empty files can't be mapped, but are still packed... */
+						std::error_code error;
+
+						if (std::filesystem::file_size(source.FilePath, error) == 0 && !error)
+							continue;
+
+						CM_ENGINE_LOG_WARN(
+							"(AssetPack) Internal warning: Failed to read file to pack. Path: {}",
+							source.FilePath.generic_string()
+						);
+
+						return false;
+					}
+
+					std::span<const std::byte> stored = sourceFile.Bytes();
+					entry.UncompressedSizeBytes = stored.size();
+
+					if (source.Compress && stored.size() <= G_MaxDecompressedBytes)
+					{
+						compressed.resize(LZ4::CompressBound(stored.size()));
+						size_t compressedBytes = LZ4::Compress(stored, compressed);
+
+						if (compressedBytes != 0 && compressedBytes < stored.size())
+						{
+							stored = std::span<const std::byte>(compressed.data(), compressedBytes);
+							entry.Compression = PackCompression::LZ4;
+						}
+					}
+
+					entry.SizeBytes = stored.size();
+
+					isWritten =
+						WriteBytes(stream, stored.data(), stored.size()) &&
+						WritePadding(stream, AlignBlob(offsetBytes + stored.size()) - offsetBytes - stored.size());
+
+					offsetBytes = AlignBlob(offsetBytes + stored.size());
+				}
+
+				std::sort(entries.begin(), entries.end(), [](const PackEntry& a, const PackEntry& b) { return a.PathHash < b.PathHash; });
+
+				PackHeader header;
+				header.NumEntries = static_cast<uint32_t>(entries.size());
+				header.FileSizeBytes = offsetBytes;
+
+				if (isWritten)
+				{
+					stream.seekp(0);
+
+					isWritten =
+						WriteBytes(stream, &header, sizeof(header)) &&
+						WriteBytes(stream, entries.data(), entries.size() * sizeof(PackEntry));
+				}
+
+				return isWritten;
+			}
+		);
+	}
+}
\ No newline at end of file
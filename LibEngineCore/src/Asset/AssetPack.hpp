@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Platform/Core/IMappedFile.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace CMEngine::Asset
+{
+	inline constexpr std::wstring_view G_AssetPackExtension = L".cmpak";
+
+	enum class PackCompression : uint8_t
+	{
+		None,
+		LZ4
+	};
+
+	/* One per packed file, in the pack's table of contents. */
+	struct PackEntry
+	{
+		uint64_t PathHash = 0; /* See HashPackPath. */
+		uint64_t OffsetBytes = 0;
+		uint64_t SizeBytes = 0; /* As stored, (i.e. compressed, if it's compressed) */
+		uint64_t UncompressedSizeBytes = 0;
+		PackCompression Compression = PackCompression::None;
+		uint8_t Padding[7] = {};
+	};
+
+	/* A packed file's bytes, and whatever they point into. (the pack itself, or a decompressed copy) */
+	struct PackedBytes
+	{
+		std::span<const std::byte> Bytes;
+		std::shared_ptr<const void> pStorage;
+	};
+
+	/* What WritePack packs from. */
+	struct PackSource
+	{
+		std::filesystem::path Key; /* Relative to the pack's mount root, which loads are resolved against. */
+		std::filesystem::path FilePath; /* What to actually read, which may well be a cooked version of Key. */
+		bool Compress = false; /* Only stored compressed if that's smaller, (and it's at most 2 GB uncompressed) */
+	};
+
+	/* Normalizes @relativePath, (generic separators, ASCII lowercased) so it hashes the same however it's spelled on Windows. */
+	[[nodiscard]] uint64_t HashPackPath(const std::filesystem::path& relativePath) noexcept;
+
+	/* A .cmpak is a header, then a table of contents sorted by PathHash, then every file as a blob aligned to
+	 *   a page. (4 KiB) The whole pack is mapped once, so a lookup is a binary search over the table,
+	 *   and an uncompressed file is used in place, without being read or copied at all.
+	 *
+	 * Only path hashes are stored, (WritePack refuses to write colliding paths) so a pack can't be listed. */
+	class AssetPack
+	{
+	public:
+		AssetPack() noexcept;
+		~AssetPack() noexcept;
+
+		AssetPack(const AssetPack&) = delete;
+		AssetPack& operator=(const AssetPack&) = delete;
+	public:
+		/* Packed files are looked up by their path relative to @mountRoot.
+		 * Returns false if @packPath couldn't be mapped, or isn't a valid .cmpak of the current version. */
+		[[nodiscard]] bool Open(const std::filesystem::path& packPath, const std::filesystem::path& mountRoot) noexcept;
+
+		/* Returns nullptr if @path isn't under the mount root, or isn't packed. */
+		[[nodiscard]] const PackEntry* Find(const std::filesystem::path& path) const noexcept;
+
+		/* As stored, and only valid for as long as the pack is. */
+		[[nodiscard]] std::span<const std::byte> StoredBytes(const PackEntry& entry) const noexcept;
+
+		inline [[nodiscard]] const std::filesystem::path& Path() const noexcept { return m_Path; }
+		inline [[nodiscard]] size_t NumEntries() const noexcept { return m_Entries.size(); }
+	private:
+		std::unique_ptr<IMappedFile> mP_File;
+		std::filesystem::path m_Path;
+		std::filesystem::path m_MountRoot; /* Normalized. */
+		std::vector<PackEntry> m_Entries; /* Copied out of the mapped table of contents once validated. */
+	};
+
+	/* Every mounted pack, searched newest first so a later pack (i.e. a patch) overrides an earlier one.
+	 *
+	 * Safe to use from multiple threads at once. A pack stays mapped until it's unmounted and nothing
+	 *   read from it is still held, (see PackedBytes::pStorage) so unmounting never invalidates a read. */
+	class AssetPackSet
+	{
+	public:
+		AssetPackSet() = default;
+		~AssetPackSet() = default;
+	public:
+		bool Mount(const std::filesystem::path& packPath, const std::filesystem::path& mountRoot) noexcept;
+		void UnmountAll() noexcept;
+
+		/* Returns false if @path isn't in any mounted pack, (or fails to decompress) leaving @outBytes empty. */
+		[[nodiscard]] bool Read(const std::filesystem::path& path, PackedBytes& outBytes) const noexcept;
+
+		[[nodiscard]] bool IsEmpty() const noexcept;
+	private:
+		mutable std::mutex m_Mutex; /* Guards m_Packs. */
+		std::vector<std::shared_ptr<const AssetPack>> m_Packs; /* Newest first. */
+	};
+
+	/* Written to a temporary file first, so a partially written .cmpak is never mapped.
+	 * Fails if any source can't be read, or two keys hash the same. */
+	[[nodiscard]] bool WritePack(const std::filesystem::path& packPath, std::span<const PackSource> sources) noexcept;
+}
\ No newline at end of file
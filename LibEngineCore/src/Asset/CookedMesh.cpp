@@ -0,0 +1,225 @@
+#include "PCH.hpp"
+#include "Asset/CookedMesh.hpp"
+#include "MappedFile.hpp"
+#include "FileUtil.hpp"
+#include "Log.hpp"
+
+namespace CMEngine::Asset
+{
+	/* Anything that changes the file's layout must bump the version, which makes every existing .cmmesh stale. */
+	inline constexpr uint32_t G_CookedMeshMagic = 0x48534D43; /* "CMSH" */
+	inline constexpr uint32_t G_CookedMeshVersion = 3;
+	inline constexpr uint64_t G_CookedBlobAlignment = 64;
+
+	struct CookedBlob
+	{
+		uint64_t OffsetBytes = 0;
+		uint64_t SizeBytes = 0;
+	};
+
+	struct CookedHeader
+	{
+		uint32_t Magic = G_CookedMeshMagic;
+		uint32_t Version = G_CookedMeshVersion;
+		CookKey Key;
+		uint64_t FileSizeBytes = 0;
+		uint32_t NumMeshes = 0;
+		uint32_t NumMaterials = 0;
+	};
+
+	struct CookedMeshEntry
+	{
+		uint32_t Index = 0;
+		IndexWidth Width = IndexWidth::Bits16;
+		MeshBounds Bounds;
+		VertexQuantization Quantization;
+		CookedBlob Vertices;
+		CookedBlob Indices;
+		CookedBlob QuantizedVertices;
+		CookedBlob Meshlets;
+		CookedBlob LODIndices;
+		CookedBlob LODs;
+	};
+
+	struct CookedMaterialEntry
+	{
+		uint32_t Index = 0;
+		MaterialData Data;
+	};
+
+	static_assert(std::is_trivially_copyable_v<CookedHeader>, "Cooked data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<CookedMeshEntry>, "Cooked data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<CookedMaterialEntry>, "Cooked data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<Vertex>, "Cooked data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<QuantizedVertex>, "Cooked data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<Meshlet>, "Cooked data must be trivially copyable, as it's written as is.");
+	static_assert(std::is_trivially_copyable_v<MeshLOD>, "Cooked data must be trivially copyable, as it's written as is.");
+
+	static [[nodiscard]] uint64_t AlignBlob(uint64_t offsetBytes) noexcept
+	{
+		return (offsetBytes + G_CookedBlobAlignment - 1) & ~(G_CookedBlobAlignment - 1);
+	}
+
+	/* Appends @elements at the next aligned offset of @outFile. */
+	template <typename Ty>
+	static [[nodiscard]] CookedBlob AppendBlob(std::vector<std::byte>& outFile, const std::vector<Ty>& elements) noexcept
+	{
+		CookedBlob blob;
+		blob.OffsetBytes = AlignBlob(outFile.size());
+		blob.SizeBytes = elements.size() * sizeof(Ty);
+
+		outFile.resize(blob.OffsetBytes + blob.SizeBytes);
+
+		if (blob.SizeBytes != 0)
+			std::memcpy(outFile.data() + blob.OffsetBytes, elements.data(), blob.SizeBytes);
+
+		return blob;
+	}
+
+	/* Returns false if @blob doesn't lie within @file, or isn't a whole number of Ty's. */
+	template <typename Ty>
+	static [[nodiscard]] bool ReadBlob(std::span<const std::byte> file, const CookedBlob& blob, std::vector<Ty>& outElements) noexcept
+	{
+		if (blob.OffsetBytes > file.size() ||
+			blob.SizeBytes > file.size() - blob.OffsetBytes ||
+			blob.SizeBytes % sizeof(Ty) != 0 ||
+			blob.OffsetBytes % alignof(Ty) != 0)
+			return false;
+
+		const Ty* pElements = reinterpret_cast<const Ty*>(file.data() + blob.OffsetBytes);
+		outElements.assign(pElements, pElements + blob.SizeBytes / sizeof(Ty));
+
+		return true;
+	}
+
+	[[nodiscard]] bool WriteCookedModel(const std::filesystem::path& cookedPath, const ImportedModel& model, const CookKey& key) noexcept
+	{
+		CookedHeader header;
+		header.Key = key;
+		header.NumMeshes = static_cast<uint32_t>(model.Meshes.size());
+		header.NumMaterials = static_cast<uint32_t>(model.Materials.size());
+
+		size_t meshTableOffset = sizeof(CookedHeader);
+		size_t materialTableOffset = meshTableOffset + model.Meshes.size() * sizeof(CookedMeshEntry);
+
+		std::vector<std::byte> file(materialTableOffset + model.Materials.size() * sizeof(CookedMaterialEntry));
+		std::vector<CookedMeshEntry> meshEntries(model.Meshes.size());
+
+		for (size_t i = 0; i < model.Meshes.size(); ++i)
+		{
+			const Mesh& mesh = model.Meshes[i];
+			CookedMeshEntry& entry = meshEntries[i];
+
+			entry.Index = mesh.Index;
+			entry.Width = mesh.Data.Width;
+			entry.Bounds = mesh.Bounds;
+			entry.Quantization = mesh.Data.Quantization;
+			entry.Vertices = AppendBlob(file, mesh.Data.Vertices);
+			entry.Indices = AppendBlob(file, mesh.Data.Indices);
+			entry.QuantizedVertices = AppendBlob(file, mesh.Data.QuantizedVertices);
+			entry.Meshlets = AppendBlob(file, mesh.Data.Meshlets);
+			entry.LODIndices = AppendBlob(file, mesh.Data.LODIndices);
+			entry.LODs = AppendBlob(file, mesh.Data.LODs);
+		}
+
+		for (size_t i = 0; i < model.Materials.size(); ++i)
+		{
+			CookedMaterialEntry entry;
+			entry.Index = model.Materials[i].Index;
+			entry.Data = model.Materials[i].Data;
+
+			std::memcpy(file.data() + materialTableOffset + i * sizeof(CookedMaterialEntry), &entry, sizeof(entry));
+		}
+
+		if (!meshEntries.empty())
+			std::memcpy(file.data() + meshTableOffset, meshEntries.data(), meshEntries.size() * sizeof(CookedMeshEntry));
+
+		header.FileSizeBytes = file.size();
+		std::memcpy(file.data(), &header, sizeof(header));
+
+		return WriteFileReplacing(cookedPath, file);
+	}
+
+	Result ReadCookedModel(const std::filesystem::path& cookedPath, const CookKey* pExpectedKey, ImportedModel& outModel) noexcept
+	{
+		outModel = ImportedModel();
+
+		AMappedFile mappedFile;
+
+		if (!mappedFile.Open(cookedPath))
+			return ResultType::Failed_File_Absent;
+
+		return ReadCookedModel(mappedFile.Bytes(), cookedPath, pExpectedKey, outModel);
+	}
+
+	Result ReadCookedModel(std::span<const std::byte> file, const std::filesystem::path& sourcePath, const CookKey* pExpectedKey, ImportedModel& outModel) noexcept
+	{
+		outModel = ImportedModel();
+
+		if (file.size() < sizeof(CookedHeader))
+			return ResultType::Failed_File_Import;
+
+		CookedHeader header;
+		std::memcpy(&header, file.data(), sizeof(header));
+
+		if (header.Magic != G_CookedMeshMagic ||
+			header.Version != G_CookedMeshVersion ||
+			header.FileSizeBytes != file.size())
+			return ResultType::Failed_File_Import;
+
+		/* Out of date, the caller re-cooks it... */
+		if (pExpectedKey != nullptr && !(header.Key == *pExpectedKey))
+			return ResultType::Failed_File_Import;
+
+		size_t meshTableOffset = sizeof(CookedHeader);
+		size_t materialTableOffset = meshTableOffset + (size_t)header.NumMeshes * sizeof(CookedMeshEntry);
+
+		if (materialTableOffset + (size_t)header.NumMaterials * sizeof(CookedMaterialEntry) > file.size())
+			return ResultType::Failed_File_Import;
+
+		outModel.Meshes.resize(header.NumMeshes);
+		outModel.Materials.resize(header.NumMaterials);
+
+		for (uint32_t i = 0; i < header.NumMeshes; ++i)
+		{
+			CookedMeshEntry entry;
+			std::memcpy(&entry, file.data() + meshTableOffset + i * sizeof(CookedMeshEntry), sizeof(entry));
+
+			Mesh& mesh = outModel.Meshes[i];
+			mesh.Index = entry.Index;
+			mesh.Bounds = entry.Bounds;
+			mesh.Data.Width = entry.Width;
+			mesh.Data.Quantization = entry.Quantization;
+
+			bool isValid =
+				ReadBlob(file, entry.Vertices, mesh.Data.Vertices) &&
+				ReadBlob(file, entry.Indices, mesh.Data.Indices) &&
+				ReadBlob(file, entry.QuantizedVertices, mesh.Data.QuantizedVertices) &&
+				ReadBlob(file, entry.Meshlets, mesh.Data.Meshlets) &&
+				ReadBlob(file, entry.LODIndices, mesh.Data.LODIndices) &&
+				ReadBlob(file, entry.LODs, mesh.Data.LODs);
+
+			if (!isValid)
+			{
+				CM_ENGINE_LOG_WARN(
+					"(CookedMesh) Internal warning: Cooked mesh file is corrupt. Path: {}",
+					sourcePath.generic_string()
+				);
+
+				outModel = ImportedModel();
+				return ResultType::Failed_File_Import;
+			}
+		}
+
+		for (uint32_t i = 0; i < header.NumMaterials; ++i)
+		{
+			CookedMaterialEntry entry;
+			std::memcpy(&entry, file.data() + materialTableOffset + i * sizeof(CookedMaterialEntry), sizeof(entry));
+
+			outModel.Materials[i].Index = entry.Index;
+			outModel.Materials[i].Data = entry.Data;
+		}
+
+		return ResultType::Succeeded;
+	}
+}
\ No newline at end of file
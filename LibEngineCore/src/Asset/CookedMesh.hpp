@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Asset/AssetManager.hpp"
+#include "Asset/DerivedDataCache.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace CMEngine::Asset
+{
+	inline constexpr std::wstring_view G_CookedMeshExtension = L".cmmesh";
+
+	/* A .cmmesh is a header, a table of meshes and materials, and then every mesh's arrays as blobs, each
+	 *   aligned to G_CookedBlobAlignment. Everything is written as laid out in memory, so loading only
+	 *   maps the file and copies each blob out as is, without going through assimp.
+	 *
+	 * Written to a temporary file first, so a partially written .cmmesh is never read. */
+	[[nodiscard]] bool WriteCookedModel(const std::filesystem::path& cookedPath, const ImportedModel& model, const CookKey& key) noexcept;
+
+	/* Fails if the file isn't a .cmmesh of the current version, or if @pExpectedKey is provided and doesn't match.
+	 * @outModel is left empty on failure. */
+	Result ReadCookedModel(const std::filesystem::path& cookedPath, const CookKey* pExpectedKey, ImportedModel& outModel) noexcept;
+
+	/* Reads a .cmmesh that's already in memory, (i.e. packed) with @sourcePath only used for logging. */
+	Result ReadCookedModel(std::span<const std::byte> file, const std::filesystem::path& sourcePath, const CookKey* pExpectedKey, ImportedModel& outModel) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,398 @@
+#include "PCH.hpp"
+#include "Asset/DerivedDataCache.hpp"
+#include "Asset/CookedMesh.hpp"
+#include "Asset/MeshOptimizer.hpp"
+#include "Asset/MeshSimplifier.hpp"
+#include "Asset/Meshlets.hpp"
+#include "Asset/VertexQuantization.hpp"
+#include "MappedFile.hpp"
+#include "Hash.hpp"
+#include "Log.hpp"
+
+#include <cctype>
+#include <cstring>
+
+namespace CMEngine::Asset
+{
+	static_assert(
+		G_ModelImporterVersion <= 0xFF && G_MeshOptimizerVersion <= 0xFF && G_MeshSimplifierVersion <= 0xFF &&
+			G_MeshletsVersion <= 0xFF && G_VertexQuantizationVersion <= 0xFF,
+		"Every cooking step's version must fit in it's byte of G_CookerVersion."
+	);
+
+	/* Any step's version being bumped re-cooks every model, without the .cmmesh layout having to change. */
+	inline constexpr uint64_t G_CookerVersion =
+		(static_cast<uint64_t>(G_ModelImporterVersion)      << 32) |
+		(static_cast<uint64_t>(G_MeshOptimizerVersion)      << 24) |
+		(static_cast<uint64_t>(G_MeshSimplifierVersion)     << 16) |
+		(static_cast<uint64_t>(G_MeshletsVersion)           <<  8) |
+		(static_cast<uint64_t>(G_VertexQuantizationVersion) <<  0);
+
+	/* Formats that are either self contained, or only reference textures, which aren't part of a cooked model. */
+	inline constexpr std::string_view G_SelfContainedExtensions[] = { ".fbx", ".ply", ".stl", ".off" };
+
+	inline constexpr uint32_t G_GlbMagic = 0x46546C67; /* "glTF" */
+	inline constexpr uint32_t G_GlbJSONChunk = 0x4E4F534A; /* "JSON" */
+
+	static [[nodiscard]] std::string_view AsStringView(std::span<const std::byte> bytes) noexcept
+	{
+		return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	}
+
+	static [[nodiscard]] size_t SkipWhitespace(std::string_view text, size_t offset) noexcept
+	{
+		while (offset < text.size() && (text[offset] == ' ' || text[offset] == '\t' || text[offset] == '\r' || text[offset] == '\n'))
+			++offset;
+
+		return offset;
+	}
+
+	/* Reads the JSON string starting at @offset, (at it's opening quote) only unescaping the escapes a path could use. */
+	static [[nodiscard]] bool ReadJSONString(std::string_view json, size_t offset, std::string& outString, size_t& outEnd) noexcept
+	{
+		outString.clear();
+
+		if (offset >= json.size() || json[offset] != '"')
+			return false;
+
+		for (size_t i = offset + 1; i < json.size(); ++i)
+		{
+			if (json[i] == '"')
+			{
+				outEnd = i + 1;
+				return true;
+			}
+			else if (json[i] == '\\' && i + 1 < json.size())
+				++i;
+
+			outString += json[i];
+		}
+
+		return false;
+	}
+
+	/* Of the top level @key, whose value must be an array. Empty if there isn't one. */
+	static [[nodiscard]] std::string_view FindJSONArray(std::string_view json, std::string_view key) noexcept
+	{
+		size_t begin = std::string_view::npos;
+
+		/* The key's quoted, so only another string containing it exactly (with quotes) could be mistaken for it... */
+		for (size_t offset = json.find(key); offset != std::string_view::npos; offset = json.find(key, offset + 1))
+		{
+			size_t colon = SkipWhitespace(json, offset + key.size());
+
+			if (colon >= json.size() || json[colon] != ':')
+				continue;
+
+			size_t bracket = SkipWhitespace(json, colon + 1);
+
+			if (bracket < json.size() && json[bracket] == '[')
+			{
+				begin = bracket;
+				break;
+			}
+		}
+
+		if (begin == std::string_view::npos)
+			return {};
+
+		uint32_t depth = 0;
+		bool isInString = false;
+
+		for (size_t i = begin; i < json.size(); ++i)
+		{
+			char c = json[i];
+
+			if (isInString)
+			{
+				if (c == '\\')
+					++i;
+				else if (c == '"')
+					isInString = false;
+			}
+			else if (c == '"')
+				isInString = true;
+			else if (c == '[')
+				++depth;
+			else if (c == ']' && --depth == 0)
+				return json.substr(begin, i + 1 - begin);
+		}
+
+		return {};
+	}
+
+	/* glTF URIs are percent encoded, (RFC 3986) and relative to the .gltf. */
+	static [[nodiscard]] std::filesystem::path DecodeURI(std::string_view uri) noexcept
+	{
+		auto hexValue = [](char c) -> int
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			else if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+
+			return -1;
+		};
+
+		std::u8string decoded;
+		decoded.reserve(uri.size());
+
+		for (size_t i = 0; i < uri.size(); ++i)
+		{
+			if (uri[i] == '%' && i + 2 < uri.size() && hexValue(uri[i + 1]) >= 0 && hexValue(uri[i + 2]) >= 0)
+			{
+				decoded += static_cast<char8_t>(hexValue(uri[i + 1]) * 16 + hexValue(uri[i + 2]));
+				i += 2;
+			}
+			else
+				decoded += static_cast<char8_t>(uri[i]);
+		}
+
+		return std::filesystem::path(decoded);
+	}
+
+	/* Only buffers, as images are textures, which aren't part of a cooked model. (Embedded data: URIs are part of the source) */
+	static void FindGltfDependencies(std::string_view json, std::vector<std::filesystem::path>& outDependencies) noexcept
+	{
+		constexpr std::string_view URIKey = "\"uri\"";
+
+		std::string_view buffers = FindJSONArray(json, "\"buffers\"");
+		std::string uri;
+
+		for (size_t offset = buffers.find(URIKey); offset != std::string_view::npos; offset = buffers.find(URIKey, offset + 1))
+		{
+			size_t colon = SkipWhitespace(buffers, offset + URIKey.size());
+
+			if (colon >= buffers.size() || buffers[colon] != ':')
+				continue;
+
+			size_t end = 0;
+
+			if (ReadJSONString(buffers, SkipWhitespace(buffers, colon + 1), uri, end) && !uri.starts_with("data:"))
+				outDependencies.emplace_back(DecodeURI(uri));
+		}
+	}
+
+	/* Every mtllib line, whose names are relative to the .obj. */
+	static void FindObjDependencies(std::string_view obj, const std::filesystem::path& sourceDirectory, std::vector<std::filesystem::path>& outDependencies) noexcept
+	{
+		constexpr std::string_view Whitespace = " \t\r";
+
+		for (size_t lineBegin = 0; lineBegin < obj.size();)
+		{
+			size_t lineEnd = obj.find('\n', lineBegin);
+
+			if (lineEnd == std::string_view::npos)
+				lineEnd = obj.size();
+
+			std::string_view line = obj.substr(lineBegin, lineEnd - lineBegin);
+			lineBegin = lineEnd + 1;
+
+			size_t keyBegin = line.find_first_not_of(Whitespace);
+
+			if (keyBegin == std::string_view::npos || !line.substr(keyBegin).starts_with("mtllib"))
+				continue;
+
+			line = line.substr(keyBegin + 6);
+
+			if (line.empty() || (line.front() != ' ' && line.front() != '\t'))
+				continue;
+
+			size_t namesBegin = line.find_first_not_of(Whitespace);
+
+			if (namesBegin == std::string_view::npos)
+				continue;
+
+			std::string_view names = line.substr(namesBegin, line.find_last_not_of(Whitespace) + 1 - namesBegin);
+
+			/* Names are whitespace separated, though some exporters write a single name with spaces in it... */
+			std::filesystem::path whole = std::filesystem::path(std::u8string(names.begin(), names.end()));
+			std::error_code error;
+
+			if (std::filesystem::is_regular_file(sourceDirectory / whole, error))
+			{
+				outDependencies.emplace_back(std::move(whole));
+				continue;
+			}
+
+			for (size_t nameBegin = 0; nameBegin < names.size();)
+			{
+				size_t nameEnd = std::min(names.find_first_of(Whitespace, nameBegin), names.size());
+
+				if (nameEnd > nameBegin)
+					outDependencies.emplace_back(std::u8string(names.begin() + nameBegin, names.begin() + nameEnd));
+
+				nameBegin = nameEnd + 1;
+			}
+		}
+	}
+
+	/* Returns false if @sourcePath's format might reference other files the cache can't find. */
+	static [[nodiscard]] bool FindDependencies(
+		const std::filesystem::path& sourcePath,
+		std::span<const std::byte> bytes,
+		std::vector<std::filesystem::path>& outDependencies
+	) noexcept
+	{
+		std::string extension = sourcePath.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+		if (extension == ".gltf")
+			FindGltfDependencies(AsStringView(bytes), outDependencies);
+		else if (extension == ".glb")
+		{
+			/* The JSON chunk always comes first, right after the 12 byte header. */
+			uint32_t words[5] = {};
+
+			if (bytes.size() < sizeof(words))
+				return false;
+
+			std::memcpy(words, bytes.data(), sizeof(words));
+
+			if (words[0] != G_GlbMagic || words[4] != G_GlbJSONChunk || words[3] > bytes.size() - sizeof(words))
+				return false;
+
+			FindGltfDependencies(AsStringView(bytes.subspan(sizeof(words), words[3])), outDependencies);
+		}
+		else if (extension == ".obj")
+			FindObjDependencies(AsStringView(bytes), sourcePath.parent_path(), outDependencies);
+		else if (std::find(std::begin(G_SelfContainedExtensions), std::end(G_SelfContainedExtensions), extension) == std::end(G_SelfContainedExtensions))
+			return false;
+
+		return true;
+	}
+
+	DerivedDataCache::DerivedDataCache(const std::filesystem::path& rootDirectory) noexcept
+		: m_RootDirectory(rootDirectory)
+	{
+	}
+
+	[[nodiscard]] bool DerivedDataCache::MakeKey(
+		const std::filesystem::path& sourcePath,
+		const ImportOptions& options,
+		uint32_t importFlags,
+		CookKey& outKey
+	) noexcept
+	{
+		outKey = CookKey();
+
+		AMappedFile source;
+
+		if (!source.Open(sourcePath))
+			return false;
+
+		std::span<const std::byte> bytes = source.Bytes();
+		std::vector<std::filesystem::path> dependencies;
+
+		if (!FindDependencies(sourcePath, bytes, dependencies))
+			return false;
+
+		XXHash64 hash;
+		hash.Update(bytes);
+
+		uint64_t numBytes = bytes.size();
+		std::filesystem::path sourceDirectory = sourcePath.parent_path();
+
+		/* Each name is hashed too, so a referenced file going missing (or appearing) also misses... */
+		for (const std::filesystem::path& dependency : dependencies)
+		{
+			std::u8string name = dependency.generic_u8string();
+			hash.Update(std::as_bytes(std::span<const char8_t>(name.data(), name.size() + 1)));
+
+			AMappedFile file;
+
+			if (!file.Open(sourceDirectory / dependency))
+				continue;
+
+			hash.Update(file.Bytes());
+			numBytes += file.Bytes().size();
+		}
+
+		outKey.SourceHash = hash.Digest();
+		outKey.SourceSizeBytes = numBytes;
+		outKey.ImportFlags = importFlags;
+		outKey.OptionBits =
+			(options.OptimizeMeshes   ? 1u << 0 : 0u) |
+			(options.GenerateLODs     ? 1u << 1 : 0u) |
+			(options.BuildMeshlets    ? 1u << 2 : 0u) |
+			(options.QuantizeVertices ? 1u << 3 : 0u);
+		outKey.CookerVersion = G_CookerVersion;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stats.BytesHashed += numBytes;
+
+		return true;
+	}
+
+	[[nodiscard]] bool DerivedDataCache::Load(const CookKey& key, ImportedModel& outModel) noexcept
+	{
+		bool isHit = ReadCookedModel(EntryPath(key), &key, outModel).Succeeded();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (isHit)
+		{
+			++m_Stats.NumHits;
+			m_Stats.BytesSaved += key.SourceSizeBytes;
+		}
+		else
+			++m_Stats.NumMisses;
+
+		return isHit;
+	}
+
+	bool DerivedDataCache::Store(const CookKey& key, const ImportedModel& model) noexcept
+	{
+		std::filesystem::path entryPath = EntryPath(key);
+
+		std::error_code error;
+		std::filesystem::create_directories(entryPath.parent_path(), error);
+
+		if (error)
+		{
+			CM_ENGINE_LOG_WARN(
+				"(DerivedDataCache) Internal warning: Failed to create cache directory. Path: {}, Error: {}",
+				entryPath.parent_path().generic_string(), error.message()
+			);
+
+			return false;
+		}
+
+		if (!WriteCookedModel(entryPath, model, key))
+			return false;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		++m_Stats.NumStores;
+
+		return true;
+	}
+
+	void DerivedDataCache::SetRootDirectory(const std::filesystem::path& rootDirectory) noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_RootDirectory = rootDirectory;
+	}
+
+	[[nodiscard]] std::filesystem::path DerivedDataCache::EntryPath(const CookKey& key) const noexcept
+	{
+		std::string fileName = std::format(
+			"{:016x}{:08x}{:08x}{:010x}",
+			key.SourceHash,
+			key.ImportFlags,
+			key.OptionBits,
+			key.CookerVersion
+		);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		std::filesystem::path entryPath = m_RootDirectory / fileName;
+		entryPath += G_CookedMeshExtension;
+
+		return entryPath;
+	}
+
+	[[nodiscard]] DerivedDataStats DerivedDataCache::Stats() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Stats;
+	}
+}
\ No newline at end of file
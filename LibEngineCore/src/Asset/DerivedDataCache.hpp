@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string_view>
+
+namespace CMEngine::Asset
+{
+	struct ImportOptions;
+	struct ImportedModel;
+
+	/* Identifies what cooked data was derived from, by the source's contents rather than it's path or write time,
+	 *   so a renamed or touched source still hits, and any actual change misses. That includes the files a source
+	 *   references, (ex. a .gltf's .bin's, or an .obj's .mtl's) and the version of every step that cooks it. */
+	struct CookKey
+	{
+		uint64_t SourceHash = 0; /* XXH64 of the source file's contents, followed by each file it references. */
+		uint64_t SourceSizeBytes = 0; /* Including referenced files. */
+		uint32_t ImportFlags = 0; /* aiPostProcessSteps the source is imported with. */
+		uint32_t OptionBits = 0; /* Of the ImportOptions that change the imported data. */
+		uint64_t CookerVersion = 0; /* A byte per cooking step's version, (ex. G_MeshOptimizerVersion) so changing any step misses. */
+
+		inline constexpr [[nodiscard]] bool operator==(const CookKey& other) const noexcept = default;
+	};
+
+	struct DerivedDataStats
+	{
+		uint32_t NumHits = 0;
+		uint32_t NumMisses = 0;
+		uint32_t NumStores = 0;
+		uint64_t BytesHashed = 0; /* Of source files, and the files they reference. */
+		uint64_t BytesSaved = 0; /* Of source files that didn't have to be imported, due to a hit. */
+
+		inline [[nodiscard]] float HitRate() const noexcept
+		{
+			uint32_t numLookups = NumHits + NumMisses;
+			return numLookups != 0 ? static_cast<float>(NumHits) / static_cast<float>(numLookups) : 0.0f;
+		}
+	};
+
+	/* A local directory of cooked models, (see CookedMesh.hpp) each named by the CookKey it was derived from.
+	 *
+	 * A lookup first hashes the source, which is mapped rather than read, so a miss importing it afterwards
+	 *   finds it's pages already in the OS's file cache instead of reading it from disk a second time.
+	 *   Entries are never evicted, so the directory can be deleted at any time to clear it.
+	 *
+	 * Only sources whose referenced files can be found without importing them are cached, (.gltf's, .glb's and .obj's,
+	 *   plus formats that only ever reference textures, which a cooked model doesn't hold) anything else is always
+	 *   imported from source.
+	 *
+	 * Safe to use from multiple threads at once. */
+	class DerivedDataCache
+	{
+	public:
+		DerivedDataCache(const std::filesystem::path& rootDirectory = S_DefaultRootDirectory) noexcept;
+		~DerivedDataCache() = default;
+	public:
+		/* Returns false if @sourcePath couldn't be read, or is of a format the cache can't tell the referenced files of. */
+		[[nodiscard]] bool MakeKey(
+			const std::filesystem::path& sourcePath,
+			const ImportOptions& options,
+			uint32_t importFlags,
+			CookKey& outKey
+		) noexcept;
+
+		/* Returns false on a miss, (or a corrupt entry) leaving @outModel empty. */
+		[[nodiscard]] bool Load(const CookKey& key, ImportedModel& outModel) noexcept;
+
+		bool Store(const CookKey& key, const ImportedModel& model) noexcept;
+
+		/* NOTE: Only takes effect for lookups after it, and doesn't move any existing entries. */
+		void SetRootDirectory(const std::filesystem::path& rootDirectory) noexcept;
+
+		[[nodiscard]] std::filesystem::path EntryPath(const CookKey& key) const noexcept;
+		[[nodiscard]] DerivedDataStats Stats() const noexcept;
+	private:
+		static constexpr std::wstring_view S_DefaultRootDirectory = L"DerivedDataCache";
+		mutable std::mutex m_Mutex; /* Guards m_RootDirectory and m_Stats. */
+		std::filesystem::path m_RootDirectory;
+		DerivedDataStats m_Stats;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,383 @@
+#include "PCH.hpp"
+#include "Macros.hpp"
+#include "Asset/MeshOptimizer.hpp"
+
+namespace CMEngine::Asset
+{
+	static constexpr uint32_t S_InvalidVertex = ~static_cast<uint32_t>(0);
+
+	/* A FIFO cache, tracked by when each vertex was last inserted rather than as an actual queue.
+	 *   A vertex is cached if fewer than CacheSize vertices have been inserted since. */
+	struct FIFOCache
+	{
+		inline FIFOCache(size_t numVertices, uint32_t cacheSize) noexcept
+			: Timestamps(numVertices, 0),
+			  CacheSize(cacheSize),
+			  Time(cacheSize + 1)
+		{
+		}
+
+		/* Returns true on a cache miss. */
+		inline [[nodiscard]] bool Reference(Index vertex) noexcept
+		{
+			if (Time - Timestamps[vertex] <= CacheSize)
+				return false;
+
+			Timestamps[vertex] = Time++;
+			return true;
+		}
+
+		inline void Flush() noexcept { Time += CacheSize + 1; }
+
+		std::vector<uint32_t> Timestamps;
+		uint32_t CacheSize = 0;
+		uint32_t Time = 0;
+	};
+
+	TriangleAdjacency::TriangleAdjacency(std::span<const Index> indices, size_t numVertices) noexcept
+		: Offsets(numVertices + 1, 0),
+		  Triangles(indices.size())
+	{
+		for (Index index : indices)
+			++Offsets[index + 1];
+
+		std::partial_sum(Offsets.begin(), Offsets.end(), Offsets.begin());
+
+		std::vector<uint32_t> cursor(Offsets.begin(), Offsets.end() - 1);
+
+		for (size_t i = 0; i < indices.size(); ++i)
+			Triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	[[nodiscard]] VertexCacheStats AnalyzeVertexCache(
+		std::span<const Index> indices,
+		size_t numVertices,
+		uint32_t cacheSize
+	) noexcept
+	{
+		VertexCacheStats stats;
+
+		if (indices.empty() || numVertices == 0)
+			return stats;
+
+		FIFOCache cache(numVertices, cacheSize);
+
+		for (Index index : indices)
+			if (cache.Reference(index))
+				++stats.NumTransforms;
+
+		size_t numTriangles = indices.size() / 3;
+
+		stats.ACMR = static_cast<float>(stats.NumTransforms) / static_cast<float>(numTriangles);
+		stats.ATVR = static_cast<float>(stats.NumTransforms) / static_cast<float>(numVertices);
+
+		return stats;
+	}
+
+	void OptimizeVertexCache(
+		std::vector<Index>& indices,
+		size_t numVertices,
+		std::vector<uint32_t>& outClusters,
+		uint32_t cacheSize
+	) noexcept
+	{
+		outClusters.clear();
+
+		size_t numTriangles = indices.size() / 3;
+
+		if (numTriangles == 0)
+			return;
+
+		TriangleAdjacency adjacency(indices, numVertices);
+
+		/* Triangles still to be emitted per vertex. */
+		std::vector<uint32_t> liveTriangles(numVertices);
+		for (size_t v = 0; v < numVertices; ++v)
+			liveTriangles[v] = static_cast<uint32_t>(adjacency.Of(static_cast<Index>(v)).size());
+
+		std::vector<uint32_t> cacheTimes(numVertices, 0);
+		std::vector<uint8_t> emitted(numTriangles, 0);
+		std::vector<Index> deadEnds;
+		std::vector<Index> candidates;
+		std::vector<Index> optimized;
+
+		deadEnds.reserve(indices.size());
+		optimized.reserve(indices.size());
+
+		uint32_t time = cacheSize + 1;
+		size_t cursor = 0;
+
+		/* Returns the next vertex with live triangles, after the fan dead-ends. */
+		auto skipDeadEnd = [&]() -> uint32_t
+			{
+				while (!deadEnds.empty())
+				{
+					Index vertex = deadEnds.back();
+					deadEnds.pop_back();
+
+					if (liveTriangles[vertex] > 0)
+						return vertex;
+				}
+
+				for (; cursor < numVertices; ++cursor)
+					if (liveTriangles[cursor] > 0)
+						return static_cast<uint32_t>(cursor);
+
+				return S_InvalidVertex;
+			};
+
+		uint32_t fanning = skipDeadEnd();
+		outClusters.emplace_back(0);
+
+		while (fanning != S_InvalidVertex)
+		{
+			candidates.clear();
+
+			for (uint32_t triangle : adjacency.Of(fanning))
+			{
+				if (emitted[triangle])
+					continue;
+
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					Index vertex = indices[triangle * 3 + corner];
+
+					optimized.emplace_back(vertex);
+					deadEnds.emplace_back(vertex);
+					candidates.emplace_back(vertex);
+
+					--liveTriangles[vertex];
+
+					if (time - cacheTimes[vertex] > cacheSize)
+						cacheTimes[vertex] = time++;
+				}
+
+				emitted[triangle] = 1;
+			}
+
+			/* Prefer the candidate that's been cached the longest, that will still be cached after it's own fan. */
+			uint32_t next = S_InvalidVertex;
+			int32_t bestPriority = -1;
+
+			for (Index candidate : candidates)
+			{
+				if (liveTriangles[candidate] == 0)
+					continue;
+
+				int32_t priority = 0;
+
+				if (time - cacheTimes[candidate] + 2 * liveTriangles[candidate] <= cacheSize)
+					priority = static_cast<int32_t>(time - cacheTimes[candidate]);
+
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					next = candidate;
+				}
+			}
+
+			if (next != S_InvalidVertex)
+			{
+				fanning = next;
+				continue;
+			}
+
+			fanning = skipDeadEnd();
+
+			if (fanning != S_InvalidVertex)
+				outClusters.emplace_back(static_cast<uint32_t>(optimized.size() / 3));
+		}
+
+		indices = std::move(optimized);
+	}
+
+	void OptimizeOverdraw(
+		std::vector<Index>& indices,
+		std::span<const Vertex> vertices,
+		std::span<const uint32_t> clusters,
+		float threshold,
+		uint32_t cacheSize
+	) noexcept
+	{
+		uint32_t numTriangles = static_cast<uint32_t>(indices.size() / 3);
+
+		if (numTriangles == 0 || clusters.empty())
+			return;
+
+		/* Soft boundaries, every point within a hard cluster where splitting costs at most @threshold of it's ACMR... */
+		std::vector<uint32_t> splits;
+		FIFOCache cache(vertices.size(), cacheSize);
+
+		for (size_t c = 0; c < clusters.size(); ++c)
+		{
+			uint32_t first = clusters[c];
+			uint32_t last = c + 1 < clusters.size() ? clusters[c + 1] : numTriangles;
+
+			cache.Flush();
+
+			uint32_t misses = 0;
+			for (uint32_t t = first; t < last; ++t)
+				for (size_t corner = 0; corner < 3; ++corner)
+					misses += cache.Reference(indices[t * 3 + corner]) ? 1 : 0;
+
+			float clusterACMR = static_cast<float>(misses) / static_cast<float>(last - first);
+
+			cache.Flush();
+			splits.emplace_back(first);
+
+			uint32_t splitMisses = 0;
+			uint32_t splitFirst = first;
+
+			for (uint32_t t = first; t < last; ++t)
+			{
+				for (size_t corner = 0; corner < 3; ++corner)
+					splitMisses += cache.Reference(indices[t * 3 + corner]) ? 1 : 0;
+
+				float splitACMR = static_cast<float>(splitMisses) / static_cast<float>(t + 1 - splitFirst);
+
+				if (t + 1 < last && splitACMR <= clusterACMR * threshold)
+				{
+					splits.emplace_back(t + 1);
+					splitFirst = t + 1;
+					splitMisses = 0;
+					cache.Flush();
+				}
+			}
+		}
+
+		struct ClusterSortKey
+		{
+			float Key = 0.0f;
+			uint32_t Index = 0;
+		};
+
+		/* Centroid and (area weighted) normal of each cluster, measured against the mesh's centroid. */
+		std::vector<ClusterSortKey> sortKeys(splits.size());
+		std::vector<Float3> centroids(splits.size());
+		std::vector<Float3> normals(splits.size());
+
+		Float3 meshCentroid;
+		float meshArea = 0.0f;
+
+		for (size_t c = 0; c < splits.size(); ++c)
+		{
+			uint32_t first = splits[c];
+			uint32_t last = c + 1 < splits.size() ? splits[c + 1] : numTriangles;
+
+			Float3 centroid;
+			Float3 normal;
+			float area = 0.0f;
+
+			for (uint32_t t = first; t < last; ++t)
+			{
+				const Float3& p0 = vertices[indices[t * 3 + 0]].Pos;
+				const Float3& p1 = vertices[indices[t * 3 + 1]].Pos;
+				const Float3& p2 = vertices[indices[t * 3 + 2]].Pos;
+
+				Float3 e0(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+				Float3 e1(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+
+				Float3 cross(
+					e0.y * e1.z - e0.z * e1.y,
+					e0.z * e1.x - e0.x * e1.z,
+					e0.x * e1.y - e0.y * e1.x
+				);
+
+				float triangleArea = std::sqrt(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+
+				Float3 triangleCentroid(
+					(p0.x + p1.x + p2.x) * (1.0f / 3.0f),
+					(p0.y + p1.y + p2.y) * (1.0f / 3.0f),
+					(p0.z + p1.z + p2.z) * (1.0f / 3.0f)
+				);
+
+				centroid += triangleCentroid * triangleArea;
+				normal += cross;
+				area += triangleArea;
+			}
+
+			meshCentroid += centroid;
+			meshArea += area;
+
+			centroids[c] = area > 0.0f ? centroid * (1.0f / area) : centroid;
+			normals[c] = normal;
+		}
+
+		if (meshArea > 0.0f)
+			meshCentroid = meshCentroid * (1.0f / meshArea);
+
+		for (size_t c = 0; c < splits.size(); ++c)
+		{
+			const Float3& normal = normals[c];
+			float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+
+			Float3 offset(
+				centroids[c].x - meshCentroid.x,
+				centroids[c].y - meshCentroid.y,
+				centroids[c].z - meshCentroid.z
+			);
+
+			sortKeys[c].Index = static_cast<uint32_t>(c);
+
+			if (length > 0.0f)
+				sortKeys[c].Key = (offset.x * normal.x + offset.y * normal.y + offset.z * normal.z) / length;
+		}
+
+		/* Most outward facing first, stable so that equal clusters keep their cache friendly order. */
+		std::stable_sort(
+			sortKeys.begin(),
+			sortKeys.end(),
+			[](const ClusterSortKey& lhs, const ClusterSortKey& rhs) { return lhs.Key > rhs.Key; }
+		);
+
+		std::vector<Index> sorted;
+		sorted.reserve(indices.size());
+
+		for (const ClusterSortKey& sortKey : sortKeys)
+		{
+			uint32_t first = splits[sortKey.Index];
+			uint32_t last = sortKey.Index + 1 < splits.size() ? splits[sortKey.Index + 1] : numTriangles;
+
+			sorted.insert(sorted.end(), indices.begin() + first * 3, indices.begin() + last * 3);
+		}
+
+		indices = std::move(sorted);
+	}
+
+	void OptimizeVertexFetch(MeshData& data) noexcept
+	{
+		std::vector<Index> remap(data.Vertices.size(), S_InvalidVertex);
+		std::vector<Vertex> vertices;
+
+		vertices.reserve(data.Vertices.size());
+
+		for (Index& index : data.Indices)
+		{
+			if (remap[index] == S_InvalidVertex)
+			{
+				remap[index] = static_cast<Index>(vertices.size());
+				vertices.emplace_back(data.Vertices[index]);
+			}
+
+			index = remap[index];
+		}
+
+		data.Vertices = std::move(vertices);
+
+		/* Every vertex is now referenced, so the largest index is the last vertex. */
+		data.Width = data.Vertices.size() > static_cast<size_t>(MeshData::S_Max16BitIndex) + 1 ?
+			IndexWidth::Bits32 : IndexWidth::Bits16;
+	}
+
+	void OptimizeMesh(MeshData& data, uint32_t cacheSize) noexcept
+	{
+		/* Quantized vertices would have to be remapped as well... */
+		CM_ENGINE_ASSERT(!data.IsQuantized());
+
+		std::vector<uint32_t> clusters;
+
+		OptimizeVertexCache(data.Indices, data.Vertices.size(), clusters, cacheSize);
+		OptimizeOverdraw(data.Indices, data.Vertices, clusters, G_DefaultOverdrawThreshold, cacheSize);
+		OptimizeVertexFetch(data);
+	}
+}
\ No newline at end of file
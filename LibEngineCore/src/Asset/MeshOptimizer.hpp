@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace CMEngine::Asset
+{
+	/* Bumped whenever OptimizeMesh's output changes, which re-cooks every cached model. (See DerivedDataCache.hpp) */
+	inline constexpr uint32_t G_MeshOptimizerVersion = 1;
+
+	/* Roughly the post-transform cache size of most hardware, (what's actually reused varies) */
+	inline constexpr uint32_t G_DefaultVertexCacheSize = 16;
+
+	/* Default ACMR an overdraw cluster is allowed to cost over it's unsplit cluster. */
+	inline constexpr float G_DefaultOverdrawThreshold = 1.05f;
+
+	/* Vertex to triangle adjacency, in compressed rows. (Triangles of vertex v are Triangles[Offsets[v]..Offsets[v + 1]]) */
+	struct TriangleAdjacency
+	{
+		TriangleAdjacency(std::span<const Index> indices, size_t numVertices) noexcept;
+
+		inline [[nodiscard]] std::span<const uint32_t> Of(Index vertex) const noexcept
+		{
+			return std::span<const uint32_t>(Triangles.data() + Offsets[vertex], Offsets[vertex + 1] - Offsets[vertex]);
+		}
+
+		std::vector<uint32_t> Offsets;
+		std::vector<uint32_t> Triangles;
+	};
+
+	struct VertexCacheStats
+	{
+		uint32_t NumTransforms = 0; /* Cache misses, (i.e. vertex shader invocations) */
+		float ACMR = 0.0f;          /* Average cache miss ratio, transforms per triangle. (3 is the worst case, ~0.5 the best for regular grids) */
+		float ATVR = 0.0f;          /* Average transform to vertex ratio. (1 is the best case) */
+	};
+
+	/* Simulates a FIFO post-transform cache of @cacheSize entries over @indices. */
+	[[nodiscard]] VertexCacheStats AnalyzeVertexCache(
+		std::span<const Index> indices,
+		size_t numVertices,
+		uint32_t cacheSize = G_DefaultVertexCacheSize
+	) noexcept;
+
+	/* Reorders triangles for post-transform cache locality, using Tipsify. (Sander et al. 2007)
+	 *
+	 * Fans around the most recently cached vertex, and when the fan dead-ends, restarts from
+	 *   the most recently referenced vertex that still has triangles. The first triangle of
+	 *   every restart (a hard cluster boundary) is written to @outClusters. */
+	void OptimizeVertexCache(
+		std::vector<Index>& indices,
+		size_t numVertices,
+		std::vector<uint32_t>& outClusters,
+		uint32_t cacheSize = G_DefaultVertexCacheSize
+	) noexcept;
+
+	/* Reorders the clusters of OptimizeVertexCache so outward facing ones are drawn first, which
+	 *   approximates front to back for any view, and lets early-z reject more of what's behind them.
+	 *
+	 * Clusters are first split further wherever the split's ACMR is within @threshold of the whole
+	 *   cluster's, trading a little vertex cache efficiency for finer ordering. */
+	void OptimizeOverdraw(
+		std::vector<Index>& indices,
+		std::span<const Vertex> vertices,
+		std::span<const uint32_t> clusters,
+		float threshold = G_DefaultOverdrawThreshold,
+		uint32_t cacheSize = G_DefaultVertexCacheSize
+	) noexcept;
+
+	/* Reorders vertices by their first use in @data.Indices, so vertex fetches walk forward through
+	 *   memory. Unreferenced vertices are dropped, and the index width is narrowed if possible. */
+	void OptimizeVertexFetch(MeshData& data) noexcept;
+
+	/* Vertex cache, overdraw, then vertex fetch optimization. Has to run before QuantizeVertices. */
+	void OptimizeMesh(MeshData& data, uint32_t cacheSize = G_DefaultVertexCacheSize) noexcept;
+}
\ No newline at end of file
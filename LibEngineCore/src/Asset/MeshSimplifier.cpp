@@ -0,0 +1,621 @@
+#include "PCH.hpp"
+#include "Macros.hpp"
+#include "Asset/MeshSimplifier.hpp"
+#include "Asset/MeshOptimizer.hpp"
+
+namespace CMEngine::Asset
+{
+	static constexpr Index S_InvalidVertex = ~static_cast<Index>(0);
+
+	/* Border planes are weighted over the surface's, so open edges keep their outline. */
+	static constexpr double S_BorderWeight = 10.0;
+
+	/* A pass may go this far past the error of the collapse that would've met it's goal, (so passes
+	 *   aren't cut short by a few touched vertices) but never past maxError. */
+	static constexpr double S_PassErrorSlack = 1.5;
+
+	/* Collapses that turn any triangle's normal by more than ~75 degrees are rejected, not only outright flips,
+	 *   as several smaller turns over later passes would add up to one. */
+	static constexpr float S_MinNormalDot = 0.25f;
+
+	/* A LOD is only kept if it has at least this fraction fewer triangles than the last. */
+	static constexpr float S_MinLODReduction = 0.1f;
+
+	enum class VertexKind : uint8_t
+	{
+		Manifold, /* Can collapse onto any neighbour. */
+		Border,   /* On a single open border, can only collapse along it. */
+		Locked    /* On an attribute seam, or a non-manifold edge. */
+	};
+
+	/* Sum of squared distances to a set of weighted planes, Q(p) = p^T * A * p + 2 * B^T * p + C */
+	struct Quadric
+	{
+		static Quadric FromPlane(double a, double b, double c, double d, double weight) noexcept
+		{
+			Quadric quadric;
+
+			quadric.A00 = weight * a * a;
+			quadric.A01 = weight * a * b;
+			quadric.A02 = weight * a * c;
+			quadric.A11 = weight * b * b;
+			quadric.A12 = weight * b * c;
+			quadric.A22 = weight * c * c;
+			quadric.B0 = weight * a * d;
+			quadric.B1 = weight * b * d;
+			quadric.B2 = weight * c * d;
+			quadric.C = weight * d * d;
+			quadric.Weight = weight;
+
+			return quadric;
+		}
+
+		inline Quadric& operator+=(const Quadric& other) noexcept
+		{
+			A00 += other.A00; A01 += other.A01; A02 += other.A02;
+			A11 += other.A11; A12 += other.A12; A22 += other.A22;
+			B0 += other.B0; B1 += other.B1; B2 += other.B2;
+			C += other.C;
+			Weight += other.Weight;
+
+			return *this;
+		}
+
+		inline [[nodiscard]] Quadric operator+(const Quadric& other) const noexcept
+		{
+			Quadric sum = *this;
+			return sum += other;
+		}
+
+		/* Weighted mean of the squared distances from @p to each plane. */
+		inline [[nodiscard]] double Error(const Float3& p) const noexcept
+		{
+			if (Weight <= 0.0)
+				return 0.0;
+
+			double x = p.x, y = p.y, z = p.z;
+
+			double error = x * (A00 * x + A01 * y + A02 * z) +
+				y * (A01 * x + A11 * y + A12 * z) +
+				z * (A02 * x + A12 * y + A22 * z) +
+				2.0 * (B0 * x + B1 * y + B2 * z) +
+				C;
+
+			/* Rounding can take it slightly negative... */
+			return std::max(error, 0.0) / Weight;
+		}
+
+		double A00 = 0.0, A01 = 0.0, A02 = 0.0;
+		double A11 = 0.0, A12 = 0.0;
+		double A22 = 0.0;
+		double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+		double C = 0.0;
+		double Weight = 0.0;
+	};
+
+	struct Collapse
+	{
+		Index From = 0;
+		Index To = 0;
+		double Error = 0.0;
+	};
+
+	static [[nodiscard]] Float3 Cross(const Float3& a, const Float3& b) noexcept
+	{
+		return Float3(
+			a.y * b.z - a.z * b.y,
+			a.z * b.x - a.x * b.z,
+			a.x * b.y - a.y * b.x
+		);
+	}
+
+	static [[nodiscard]] float Dot(const Float3& a, const Float3& b) noexcept
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	static [[nodiscard]] Float3 Subtract(const Float3& a, const Float3& b) noexcept
+	{
+		return Float3(a.x - b.x, a.y - b.y, a.z - b.z);
+	}
+
+	static [[nodiscard]] uint64_t EdgeKey(Index from, Index to) noexcept
+	{
+		return (static_cast<uint64_t>(from) << 32) | to;
+	}
+
+	/* Maps every vertex to the first vertex with the same position, (@outPositions) and to the first vertex
+	 *   that's identical altogether. (@outWedges) Seams are positions with more than one distinct wedge. */
+	static void BuildRemaps(
+		std::span<const Vertex> vertices,
+		std::vector<Index>& outPositions,
+		std::vector<Index>& outWedges,
+		std::vector<uint8_t>& outSeams
+	) noexcept
+	{
+		size_t numVertices = vertices.size();
+
+		std::vector<Index> order(numVertices);
+		std::iota(order.begin(), order.end(), 0);
+
+		auto positionLess = [&](Index lhs, Index rhs)
+			{
+				const Float3& a = vertices[lhs].Pos;
+				const Float3& b = vertices[rhs].Pos;
+
+				if (a.x != b.x) return a.x < b.x;
+				if (a.y != b.y) return a.y < b.y;
+				if (a.z != b.z) return a.z < b.z;
+				return lhs < rhs;
+			};
+
+		auto samePosition = [&](Index lhs, Index rhs)
+			{
+				const Float3& a = vertices[lhs].Pos;
+				const Float3& b = vertices[rhs].Pos;
+
+				return a.x == b.x && a.y == b.y && a.z == b.z;
+			};
+
+		auto sameAttributes = [&](Index lhs, Index rhs)
+			{
+				const Vertex& a = vertices[lhs];
+				const Vertex& b = vertices[rhs];
+
+				return a.Normal.x == b.Normal.x && a.Normal.y == b.Normal.y && a.Normal.z == b.Normal.z &&
+					a.TexCoord.x == b.TexCoord.x && a.TexCoord.y == b.TexCoord.y;
+			};
+
+		std::sort(order.begin(), order.end(), positionLess);
+
+		outPositions.resize(numVertices);
+		outWedges.resize(numVertices);
+		outSeams.assign(numVertices, 0);
+
+		for (size_t first = 0; first < numVertices;)
+		{
+			size_t last = first + 1;
+			while (last < numVertices && samePosition(order[first], order[last]))
+				++last;
+
+			/* Groups are tiny, (a vertex per side of a seam) so pairwise is fine. */
+			bool isSeam = false;
+
+			for (size_t i = first; i < last; ++i)
+			{
+				Index vertex = order[i];
+
+				outPositions[vertex] = order[first];
+				outWedges[vertex] = vertex;
+
+				for (size_t j = first; j < i; ++j)
+					if (sameAttributes(order[j], vertex))
+					{
+						outWedges[vertex] = outWedges[order[j]];
+						break;
+					}
+
+				isSeam |= outWedges[vertex] != order[first];
+			}
+
+			outSeams[order[first]] = isSeam;
+			first = last;
+		}
+	}
+
+	/* Classifies each position by it's directed edges, an edge without a twin is on an open border. */
+	static void ClassifyVertices(
+		std::span<const Index> indices,
+		std::span<const Index> positions,
+		std::span<const uint8_t> seams,
+		std::vector<VertexKind>& outKinds,
+		std::vector<Index>& outBorderNext,
+		std::vector<Index>& outBorderPrev
+	) noexcept
+	{
+		size_t numVertices = positions.size();
+
+		std::unordered_map<uint64_t, uint32_t> edges;
+		edges.reserve(indices.size());
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				Index from = positions[indices[i + corner]];
+				Index to = positions[indices[i + (corner + 1) % 3]];
+
+				++edges[EdgeKey(from, to)];
+			}
+
+		std::vector<uint32_t> borderOut(numVertices, 0);
+		std::vector<uint32_t> borderIn(numVertices, 0);
+		std::vector<uint8_t> nonManifold(numVertices, 0);
+
+		outBorderNext.assign(numVertices, S_InvalidVertex);
+		outBorderPrev.assign(numVertices, S_InvalidVertex);
+
+		for (const auto& [key, count] : edges)
+		{
+			Index from = static_cast<Index>(key >> 32);
+			Index to = static_cast<Index>(key & 0xFFFFFFFF);
+
+			if (count > 1)
+			{
+				nonManifold[from] = 1;
+				nonManifold[to] = 1;
+			}
+
+			if (edges.find(EdgeKey(to, from)) != edges.end())
+				continue;
+
+			++borderOut[from];
+			++borderIn[to];
+
+			outBorderNext[from] = to;
+			outBorderPrev[to] = from;
+		}
+
+		outKinds.assign(numVertices, VertexKind::Manifold);
+
+		for (size_t v = 0; v < numVertices; ++v)
+		{
+			/* Only ever read through positions[], so every other vertex's kind is irrelevant. */
+			if (positions[v] != v)
+				continue;
+
+			if (seams[v] || nonManifold[v] || borderOut[v] > 1 || borderIn[v] != borderOut[v])
+				outKinds[v] = VertexKind::Locked;
+			else if (borderOut[v] == 1)
+				outKinds[v] = VertexKind::Border;
+		}
+	}
+
+	static void BuildQuadrics(
+		std::span<const Vertex> vertices,
+		std::span<const Index> indices,
+		std::span<const Index> positions,
+		std::span<const Index> borderNext,
+		std::vector<Quadric>& outQuadrics
+	) noexcept
+	{
+		outQuadrics.assign(vertices.size(), Quadric());
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			Index p[3] = { positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]] };
+
+			const Float3& p0 = vertices[p[0]].Pos;
+			const Float3& p1 = vertices[p[1]].Pos;
+			const Float3& p2 = vertices[p[2]].Pos;
+
+			Float3 normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+			double length = std::sqrt(static_cast<double>(Dot(normal, normal)));
+
+			if (length <= 0.0)
+				continue;
+
+			double nx = normal.x / length;
+			double ny = normal.y / length;
+			double nz = normal.z / length;
+			double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+
+			/* Weighted by area, so large triangles dominate the error of their vertices. */
+			Quadric face = Quadric::FromPlane(nx, ny, nz, d, length * 0.5);
+
+			for (Index vertex : p)
+				outQuadrics[vertex] += face;
+
+			/* A plane through each border edge, perpendicular to the triangle, keeps the border from shrinking. */
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				Index from = p[corner];
+				Index to = p[(corner + 1) % 3];
+
+				if (borderNext[from] != to)
+					continue;
+
+				Float3 edge = Subtract(vertices[to].Pos, vertices[from].Pos);
+				Float3 edgeNormal = Cross(edge, Float3(static_cast<float>(nx), static_cast<float>(ny), static_cast<float>(nz)));
+
+				double edgeLengthSq = Dot(edge, edge);
+				double edgeNormalLength = std::sqrt(static_cast<double>(Dot(edgeNormal, edgeNormal)));
+
+				if (edgeNormalLength <= 0.0)
+					continue;
+
+				double ex = edgeNormal.x / edgeNormalLength;
+				double ey = edgeNormal.y / edgeNormalLength;
+				double ez = edgeNormal.z / edgeNormalLength;
+				double ed = -(ex * vertices[from].Pos.x + ey * vertices[from].Pos.y + ez * vertices[from].Pos.z);
+
+				Quadric border = Quadric::FromPlane(ex, ey, ez, ed, edgeLengthSq * S_BorderWeight);
+
+				outQuadrics[from] += border;
+				outQuadrics[to] += border;
+			}
+		}
+	}
+
+	/* Returns true if moving @from onto @to would flip (or nearly flip) any of @from's remaining triangles. */
+	static [[nodiscard]] bool FlipsTriangle(
+		Index from,
+		Index to,
+		std::span<const Vertex> vertices,
+		std::span<const Index> indices,
+		std::span<const Index> positions,
+		const TriangleAdjacency& adjacency
+	) noexcept
+	{
+		Index toPosition = positions[to];
+
+		for (uint32_t triangle : adjacency.Of(from))
+		{
+			const Index* pCorners = indices.data() + triangle * 3;
+
+			/* Triangles on the collapsed edge are removed altogether. */
+			if (positions[pCorners[0]] == toPosition ||
+				positions[pCorners[1]] == toPosition ||
+				positions[pCorners[2]] == toPosition)
+				continue;
+
+			Float3 before[3];
+			Float3 after[3];
+
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				before[corner] = vertices[pCorners[corner]].Pos;
+				after[corner] = pCorners[corner] == from ? vertices[to].Pos : before[corner];
+			}
+
+			Float3 normalBefore = Cross(Subtract(before[1], before[0]), Subtract(before[2], before[0]));
+			Float3 normalAfter = Cross(Subtract(after[1], after[0]), Subtract(after[2], after[0]));
+
+			float lengths = std::sqrt(Dot(normalBefore, normalBefore) * Dot(normalAfter, normalAfter));
+
+			if (Dot(normalBefore, normalAfter) <= S_MinNormalDot * lengths)
+				return true;
+		}
+
+		return false;
+	}
+
+	[[nodiscard]] float SimplifyMesh(
+		std::span<const Vertex> vertices,
+		std::span<const Index> indices,
+		size_t targetIndices,
+		float maxError,
+		std::vector<Index>& outIndices
+	) noexcept
+	{
+		outIndices.assign(indices.begin(), indices.end());
+
+		if (indices.size() <= targetIndices || vertices.empty())
+			return 0.0f;
+
+		size_t numVertices = vertices.size();
+
+		std::vector<Index> positions;
+		std::vector<Index> wedges;
+		std::vector<uint8_t> seams;
+		BuildRemaps(vertices, positions, wedges, seams);
+
+		/* Identical vertices would otherwise split a vertex's triangles between them. */
+		for (Index& index : outIndices)
+			index = wedges[index];
+
+		std::vector<VertexKind> kinds;
+		std::vector<Index> borderNext;
+		std::vector<Index> borderPrev;
+		ClassifyVertices(outIndices, positions, seams, kinds, borderNext, borderPrev);
+
+		/* Indexed by position, so every wedge at a position shares one. */
+		std::vector<Quadric> quadrics;
+		BuildQuadrics(vertices, outIndices, positions, borderNext, quadrics);
+
+		auto canCollapse = [&](Index from, Index to)
+			{
+				Index fromPosition = positions[from];
+				Index toPosition = positions[to];
+
+				if (fromPosition == toPosition)
+					return false;
+
+				switch (kinds[fromPosition])
+				{
+				case VertexKind::Manifold:
+					return true;
+				case VertexKind::Border:
+					return borderNext[fromPosition] == toPosition || borderPrev[fromPosition] == toPosition;
+				default:
+					return false;
+				}
+			};
+
+		double maxErrorSq = static_cast<double>(maxError) * maxError;
+		double resultErrorSq = 0.0;
+
+		std::vector<Collapse> bestCollapses(numVertices);
+		std::vector<Collapse> collapses;
+		std::vector<Index> remap(numVertices);
+		std::vector<uint8_t> touched(numVertices);
+		std::vector<Index> simplified;
+
+		while (outIndices.size() > targetIndices)
+		{
+			TriangleAdjacency adjacency(outIndices, numVertices);
+
+			/* Cheapest collapse of each vertex, onto any of it's neighbours... */
+			for (Collapse& collapse : bestCollapses)
+				collapse.To = S_InvalidVertex;
+
+			for (size_t i = 0; i < outIndices.size(); i += 3)
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					Index a = outIndices[i + corner];
+					Index b = outIndices[i + (corner + 1) % 3];
+
+					for (auto [from, to] : { std::pair(a, b), std::pair(b, a) })
+					{
+						if (!canCollapse(from, to))
+							continue;
+
+						Quadric quadric = quadrics[positions[from]] + quadrics[positions[to]];
+						double error = quadric.Error(vertices[to].Pos);
+
+						Collapse& best = bestCollapses[from];
+
+						if (best.To == S_InvalidVertex || error < best.Error)
+							best = Collapse{ from, to, error };
+					}
+				}
+
+			collapses.clear();
+			for (const Collapse& collapse : bestCollapses)
+				if (collapse.To != S_InvalidVertex && collapse.Error <= maxErrorSq)
+					collapses.emplace_back(collapse);
+
+			if (collapses.empty())
+				break;
+
+			std::sort(
+				collapses.begin(),
+				collapses.end(),
+				[](const Collapse& lhs, const Collapse& rhs) { return lhs.Error < rhs.Error; }
+			);
+
+			/* Each collapse removes about two triangles. */
+			size_t goal = (outIndices.size() - targetIndices) / 6 + 1;
+			double passLimit = std::min(
+				collapses[std::min(goal, collapses.size()) - 1].Error * S_PassErrorSlack,
+				maxErrorSq
+			);
+
+			std::iota(remap.begin(), remap.end(), 0);
+			std::fill(touched.begin(), touched.end(), 0);
+
+			size_t numCollapsed = 0;
+
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.Error > passLimit)
+					break;
+
+				/* Anything around an earlier collapse this pass has stale quadrics and adjacency. */
+				if (touched[collapse.From] || touched[collapse.To])
+					continue;
+
+				if (FlipsTriangle(collapse.From, collapse.To, vertices, outIndices, positions, adjacency))
+					continue;
+
+				remap[collapse.From] = collapse.To;
+				quadrics[positions[collapse.To]] += quadrics[positions[collapse.From]];
+
+				for (uint32_t triangle : adjacency.Of(collapse.From))
+					for (size_t corner = 0; corner < 3; ++corner)
+						touched[outIndices[triangle * 3 + corner]] = 1;
+
+				touched[collapse.To] = 1;
+
+				resultErrorSq = std::max(resultErrorSq, collapse.Error);
+
+				if (++numCollapsed >= goal)
+					break;
+			}
+
+			if (numCollapsed == 0)
+				break;
+
+			/* Triangles on a collapsed edge end up with two corners at the same position. */
+			simplified.clear();
+
+			for (size_t i = 0; i < outIndices.size(); i += 3)
+			{
+				Index a = remap[outIndices[i]];
+				Index b = remap[outIndices[i + 1]];
+				Index c = remap[outIndices[i + 2]];
+
+				if (positions[a] == positions[b] ||
+					positions[b] == positions[c] ||
+					positions[c] == positions[a])
+					continue;
+
+				simplified.emplace_back(a);
+				simplified.emplace_back(b);
+				simplified.emplace_back(c);
+			}
+
+			outIndices.swap(simplified);
+		}
+
+		return static_cast<float>(std::sqrt(resultErrorSq));
+	}
+
+	void BuildLODs(
+		MeshData& data,
+		uint32_t numLODs,
+		float reduction,
+		float maxError
+	) noexcept
+	{
+		data.LODs.clear();
+		data.LODIndices.clear();
+
+		numLODs = std::min(numLODs, G_MaxMeshLODs);
+
+		if (numLODs <= 1 || data.Indices.empty() || data.Vertices.empty())
+			return;
+
+		CM_ENGINE_ASSERT(!data.IsQuantized());
+
+		Float3 min = data.Vertices.front().Pos;
+		Float3 max = min;
+
+		for (const Vertex& vertex : data.Vertices)
+		{
+			min.x = std::min(min.x, vertex.Pos.x);
+			min.y = std::min(min.y, vertex.Pos.y);
+			min.z = std::min(min.z, vertex.Pos.z);
+
+			max.x = std::max(max.x, vertex.Pos.x);
+			max.y = std::max(max.y, vertex.Pos.y);
+			max.z = std::max(max.z, vertex.Pos.z);
+		}
+
+		Float3 extents = Subtract(max, min) * 0.5f;
+		float objectMaxError = maxError * std::sqrt(Dot(extents, extents));
+
+		std::vector<Index> simplified;
+		std::vector<uint32_t> clusters;
+
+		size_t numPrevious = data.Indices.size();
+		float targetRatio = 1.0f;
+
+		/* Every level is simplified from the full mesh, so it's error is measured against it rather than accumulated. */
+		for (uint32_t lod = 1; lod < numLODs; ++lod)
+		{
+			targetRatio *= reduction;
+
+			size_t targetIndices = static_cast<size_t>(static_cast<float>(data.Indices.size() / 3) * targetRatio) * 3;
+
+			if (targetIndices < 3)
+				break;
+
+			float error = SimplifyMesh(data.Vertices, data.Indices, targetIndices, objectMaxError, simplified);
+
+			if (simplified.empty() ||
+				static_cast<float>(simplified.size()) > static_cast<float>(numPrevious) * (1.0f - S_MinLODReduction))
+				break;
+
+			OptimizeVertexCache(simplified, data.Vertices.size(), clusters);
+
+			MeshLOD& meshLOD = data.LODs.emplace_back();
+			meshLOD.FirstIndex = static_cast<uint32_t>(data.LODIndices.size());
+			meshLOD.NumIndices = static_cast<uint32_t>(simplified.size());
+			meshLOD.Error = error;
+
+			data.LODIndices.insert(data.LODIndices.end(), simplified.begin(), simplified.end());
+
+			numPrevious = simplified.size();
+		}
+	}
+}
\ No newline at end of file
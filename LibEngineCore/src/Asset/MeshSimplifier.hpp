@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace CMEngine::Asset
+{
+	/* Of BuildLODs' output, (and part of every CookKey) so bump it with any change to the LODs it generates. */
+	inline constexpr uint32_t G_MeshSimplifierVersion = 1;
+
+	/* Including the full mesh. */
+	inline constexpr uint32_t G_DefaultNumLODs = 4;
+
+	/* Fraction of the previous LOD's triangles each LOD aims for. */
+	inline constexpr float G_DefaultLODReduction = 0.5f;
+
+	/* Largest error any LOD may reach, relative to the mesh's bounding radius. */
+	inline constexpr float G_DefaultMaxLODError = 0.05f;
+
+	/* Quadric error simplification. (Garland and Heckbert 1997)
+	 *
+	 * Vertices are collapsed onto one of their neighbours rather than an optimal position, so @outIndices
+	 *   still refers to @vertices as is. Collapses are made in passes, cheapest first, until either
+	 *   @targetIndices or @maxError (an object space distance) is reached.
+	 *
+	 * Vertices on an attribute seam or non-manifold edge never move, and vertices on an open border
+	 *   only collapse along it. Returns the error of the simplified mesh. */
+	[[nodiscard]] float SimplifyMesh(
+		std::span<const Vertex> vertices,
+		std::span<const Index> indices,
+		size_t targetIndices,
+		float maxError,
+		std::vector<Index>& outIndices
+	) noexcept;
+
+	/* Fills @data.LODs and @data.LODIndices with up to @numLODs - 1 levels, each simplified from the full mesh
+	 *   down to @reduction of the previous level's triangles, and optimized for the vertex cache.
+	 *
+	 * Stops early once a level can't get much smaller without exceeding @maxError. (Relative to the bounding radius) */
+	void BuildLODs(
+		MeshData& data,
+		uint32_t numLODs = G_DefaultNumLODs,
+		float reduction = G_DefaultLODReduction,
+		float maxError = G_DefaultMaxLODError
+	) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "PCH.hpp"
+#include "Asset/Meshlets.hpp"
+
+namespace CMEngine::Asset
+{
+	/* Below this, the normal cone spans close to a hemisphere and would almost never cull anything. */
+	static constexpr float S_MinConeSpread = 0.1f;
+
+	static void ComputeMeshletBounds(Meshlet& meshlet, const MeshData& data) noexcept
+	{
+		uint32_t lastIndex = meshlet.FirstIndex + meshlet.NumIndices;
+
+		Float3 min = data.Vertices[data.Indices[meshlet.FirstIndex]].Pos;
+		Float3 max = min;
+
+		for (uint32_t i = meshlet.FirstIndex; i < lastIndex; ++i)
+		{
+			const Float3& pos = data.Vertices[data.Indices[i]].Pos;
+
+			min.x = std::min(min.x, pos.x);
+			min.y = std::min(min.y, pos.y);
+			min.z = std::min(min.z, pos.z);
+
+			max.x = std::max(max.x, pos.x);
+			max.y = std::max(max.y, pos.y);
+			max.z = std::max(max.z, pos.z);
+		}
+
+		meshlet.Center = Float3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+
+		float radiusSq = 0.0f;
+		for (uint32_t i = meshlet.FirstIndex; i < lastIndex; ++i)
+		{
+			const Float3& pos = data.Vertices[data.Indices[i]].Pos;
+
+			float dx = pos.x - meshlet.Center.x;
+			float dy = pos.y - meshlet.Center.y;
+			float dz = pos.z - meshlet.Center.z;
+
+			radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+		}
+
+		meshlet.Radius = std::sqrt(radiusSq);
+
+		/* Front faces are clockwise, (D3D's default) so cross(p1 - p0, p2 - p0) points out of the front face
+		 *   in the left handed space assimp converted to. */
+		std::vector<Float3> normals;
+		normals.reserve(meshlet.NumIndices / 3);
+
+		Float3 axis;
+
+		for (uint32_t i = meshlet.FirstIndex; i < lastIndex; i += 3)
+		{
+			const Float3& p0 = data.Vertices[data.Indices[i + 0]].Pos;
+			const Float3& p1 = data.Vertices[data.Indices[i + 1]].Pos;
+			const Float3& p2 = data.Vertices[data.Indices[i + 2]].Pos;
+
+			Float3 e0(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+			Float3 e1(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+
+			Float3 normal(
+				e0.y * e1.z - e0.z * e1.y,
+				e0.z * e1.x - e0.x * e1.z,
+				e0.x * e1.y - e0.y * e1.x
+			);
+
+			float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+
+			/* Degenerate triangles are never rasterized, so they can't constrain the cone. */
+			if (length <= 0.0f)
+				continue;
+
+			normal = normal * (1.0f / length);
+			normals.emplace_back(normal);
+			axis += normal;
+		}
+
+		float axisLength = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+
+		meshlet.ConeAxis = Float3(0.0f, 0.0f, 0.0f);
+		meshlet.ConeCutoff = 1.0f;
+
+		if (normals.empty() || axisLength <= 0.0f)
+			return;
+
+		axis = axis * (1.0f / axisLength);
+
+		float minDot = 1.0f;
+		for (const Float3& normal : normals)
+			minDot = std::min(minDot, normal.x * axis.x + normal.y * axis.y + normal.z * axis.z);
+
+		if (minDot <= S_MinConeSpread)
+			return;
+
+		/* sin of the cone's half angle. */
+		meshlet.ConeAxis = axis;
+		meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+
+	void BuildMeshlets(MeshData& data, uint32_t maxVertices, uint32_t maxTriangles) noexcept
+	{
+		data.Meshlets.clear();
+
+		if (data.Indices.size() < 3 || maxVertices < 3 || maxTriangles == 0)
+			return;
+
+		/* The meshlet each vertex was last added to, so unique vertices can be counted without a set. */
+		constexpr uint32_t NoMeshlet = ~static_cast<uint32_t>(0);
+		std::vector<uint32_t> owners(data.Vertices.size(), NoMeshlet);
+
+		Meshlet current;
+		uint32_t currentID = 0;
+
+		auto countNew = [&](uint32_t first) -> uint32_t
+			{
+				Index a = data.Indices[first + 0];
+				Index b = data.Indices[first + 1];
+				Index c = data.Indices[first + 2];
+
+				return (owners[a] != currentID ? 1u : 0u) +
+					(owners[b] != currentID && b != a ? 1u : 0u) +
+					(owners[c] != currentID && c != a && c != b ? 1u : 0u);
+			};
+
+		for (uint32_t i = 0; i + 2 < (uint32_t)data.Indices.size(); i += 3)
+		{
+			bool full = current.NumIndices / 3 >= maxTriangles ||
+				current.NumVertices + countNew(i) > maxVertices;
+
+			if (full)
+			{
+				ComputeMeshletBounds(current, data);
+				data.Meshlets.emplace_back(current);
+
+				current = Meshlet();
+				current.FirstIndex = i;
+				++currentID;
+			}
+
+			current.NumVertices += countNew(i);
+			current.NumIndices += 3;
+
+			for (uint32_t corner = 0; corner < 3; ++corner)
+				owners[data.Indices[i + corner]] = currentID;
+		}
+
+		ComputeMeshletBounds(current, data);
+		data.Meshlets.emplace_back(current);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+
+#include <cstdint>
+
+namespace CMEngine::Asset
+{
+	/* Part of every CookKey, bump it if BuildMeshlets ever splits meshes differently. */
+	inline constexpr uint32_t G_MeshletsVersion = 1;
+
+	/* Matches the common mesh shader limits, so meshlets could be fed to one as is later on. */
+	inline constexpr uint32_t G_MaxMeshletVertices = 64;
+	inline constexpr uint32_t G_MaxMeshletTriangles = 124;
+
+	/* Splits @data.Indices into Meshlets, in their current order. Triangles are added to a meshlet
+	 *   until either limit would be exceeded, so this should run after OptimizeMesh, whose vertex
+	 *   cache ordering keeps consecutive triangles close together. */
+	void BuildMeshlets(
+		MeshData& data,
+		uint32_t maxVertices = G_MaxMeshletVertices,
+		uint32_t maxTriangles = G_MaxMeshletTriangles
+	) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Asset/AssetID.hpp"
+#include "Macros.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace CMEngine::Asset
+{
+	/* Storage for one asset type, indexed directly by AssetID::GlobalID.
+	 *
+	 * Slots are allocated a page at a time and pages are never moved or freed, so a
+	 *   pointer to an asset stays valid until the asset itself is erased, regardless of
+	 *   how many are added after it. A lookup only succeeds if the ID's generation
+	 *   matches the one the slot was filled with. */
+	template <typename Ty>
+	class SlotArray
+	{
+	public:
+		SlotArray() = default;
+		~SlotArray() = default;
+
+		SlotArray(const SlotArray&) = delete;
+		SlotArray& operator=(const SlotArray&) = delete;
+	public:
+		/* NOTE: @id's slot must be empty. */
+		template <typename... Args>
+		inline Ty& Emplace(AssetID id, Args&&... args) noexcept;
+
+		inline [[nodiscard]] Ty* Find(AssetID id) noexcept;
+		inline [[nodiscard]] const Ty* Find(AssetID id) const noexcept;
+
+		/* Returns false if @id wasn't stored. */
+		inline bool Erase(AssetID id) noexcept;
+
+		inline [[nodiscard]] bool Contains(AssetID id) const noexcept { return Find(id) != nullptr; }
+		inline [[nodiscard]] uint32_t Size() const noexcept { return m_Size; }
+	private:
+		struct Slot
+		{
+			std::optional<Ty> Asset;
+			uint32_t Generation = 0;
+		};
+
+		inline [[nodiscard]] const Slot* FindSlot(AssetID id) const noexcept;
+	private:
+		static constexpr uint32_t S_PageShift = 8;
+		static constexpr uint32_t S_PageSize = 1u << S_PageShift; /* Slots per page. */
+		static constexpr uint32_t S_PageMask = S_PageSize - 1;
+		std::vector<std::unique_ptr<Slot[]>> m_Pages; /* Null until a slot in them is used. */
+		uint32_t m_Size = 0;
+	};
+
+	template <typename Ty>
+	template <typename... Args>
+	inline Ty& SlotArray<Ty>::Emplace(AssetID id, Args&&... args) noexcept
+	{
+		uint32_t globalID = id.GlobalID();
+		uint32_t page = globalID >> S_PageShift;
+
+		if (page >= m_Pages.size())
+			m_Pages.resize(page + 1);
+
+		if (!m_Pages[page])
+			m_Pages[page] = std::make_unique<Slot[]>(S_PageSize);
+
+		Slot& slot = m_Pages[page][globalID & S_PageMask];
+
+		CM_ENGINE_ASSERT(!slot.Asset.has_value());
+
+		slot.Asset.emplace(std::forward<Args>(args)...);
+		slot.Generation = id.Generation();
+		++m_Size;
+
+		return *slot.Asset;
+	}
+
+	template <typename Ty>
+	inline [[nodiscard]] Ty* SlotArray<Ty>::Find(AssetID id) noexcept
+	{
+		const Slot* pSlot = FindSlot(id);
+		return pSlot != nullptr ? const_cast<Ty*>(&*pSlot->Asset) : nullptr;
+	}
+
+	template <typename Ty>
+	inline [[nodiscard]] const Ty* SlotArray<Ty>::Find(AssetID id) const noexcept
+	{
+		const Slot* pSlot = FindSlot(id);
+		return pSlot != nullptr ? &*pSlot->Asset : nullptr;
+	}
+
+	template <typename Ty>
+	inline bool SlotArray<Ty>::Erase(AssetID id) noexcept
+	{
+		Slot* pSlot = const_cast<Slot*>(FindSlot(id));
+
+		if (pSlot == nullptr)
+			return false;
+
+		pSlot->Asset.reset();
+		--m_Size;
+
+		return true;
+	}
+
+	template <typename Ty>
+	inline [[nodiscard]] const typename SlotArray<Ty>::Slot* SlotArray<Ty>::FindSlot(AssetID id) const noexcept
+	{
+		uint32_t globalID = id.GlobalID();
+		uint32_t page = globalID >> S_PageShift;
+
+		if (page >= m_Pages.size() || !m_Pages[page])
+			return nullptr;
+
+		const Slot& slot = m_Pages[page][globalID & S_PageMask];
+
+		if (!slot.Asset.has_value() || slot.Generation != id.Generation())
+			return nullptr;
+
+		return &slot;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,530 @@
+#include "PCH.hpp"
+#include "Asset/TextureCooker.hpp"
+#include "FileUtil.hpp"
+#include "Log.hpp"
+
+#include <immintrin.h>
+
+namespace CMEngine::Asset
+{
+	/* Mirrors DDS_PIXELFORMAT, DDS_HEADER and DDS_HEADER_DXT10. (See the DDS programming guide) */
+	struct DDSPixelFormat
+	{
+		uint32_t Size = sizeof(DDSPixelFormat);
+		uint32_t Flags = 0;
+		uint32_t FourCC = 0;
+		uint32_t RGBBitCount = 0;
+		uint32_t RBitMask = 0;
+		uint32_t GBitMask = 0;
+		uint32_t BBitMask = 0;
+		uint32_t ABitMask = 0;
+	};
+
+	struct DDSHeader
+	{
+		uint32_t Size = sizeof(DDSHeader);
+		uint32_t Flags = 0;
+		uint32_t Height = 0;
+		uint32_t Width = 0;
+		uint32_t PitchOrLinearSize = 0;
+		uint32_t Depth = 0;
+		uint32_t MipMapCount = 0;
+		uint32_t Reserved1[11] = {};
+		DDSPixelFormat PixelFormat;
+		uint32_t Caps = 0;
+		uint32_t Caps2 = 0;
+		uint32_t Caps3 = 0;
+		uint32_t Caps4 = 0;
+		uint32_t Reserved2 = 0;
+	};
+
+	struct DDSHeaderDX10
+	{
+		uint32_t DXGIFormat = 0;
+		uint32_t ResourceDimension = 0;
+		uint32_t MiscFlag = 0;
+		uint32_t ArraySize = 0;
+		uint32_t MiscFlags2 = 0;
+	};
+
+	static_assert(sizeof(DDSHeader) == 124, "DDSHeader must match DDS_HEADER.");
+	static_assert(sizeof(DDSHeaderDX10) == 20, "DDSHeaderDX10 must match DDS_HEADER_DXT10.");
+
+	inline constexpr uint32_t G_DDSMagic = 0x20534444;    /* "DDS " */
+	inline constexpr uint32_t G_DDSFourCCDX10 = 0x30315844; /* "DX10" */
+
+	inline constexpr uint32_t G_DDSDCaps = 0x1;
+	inline constexpr uint32_t G_DDSDHeight = 0x2;
+	inline constexpr uint32_t G_DDSDWidth = 0x4;
+	inline constexpr uint32_t G_DDSDPitch = 0x8;
+	inline constexpr uint32_t G_DDSDPixelFormat = 0x1000;
+	inline constexpr uint32_t G_DDSDMipMapCount = 0x20000;
+	inline constexpr uint32_t G_DDSDLinearSize = 0x80000;
+	inline constexpr uint32_t G_DDPFFourCC = 0x4;
+	inline constexpr uint32_t G_DDSCapsComplex = 0x8;
+	inline constexpr uint32_t G_DDSCapsTexture = 0x1000;
+	inline constexpr uint32_t G_DDSCapsMipMap = 0x400000;
+	inline constexpr uint32_t G_DDSDimensionTexture2D = 3; /* D3D10_RESOURCE_DIMENSION_TEXTURE2D */
+
+	/* DXGI_FORMAT values, without pulling in dxgiformat.h. */
+	static [[nodiscard]] uint32_t DXGIFormatOf(TextureFormat format) noexcept
+	{
+		switch (format)
+		{
+		case TextureFormat::RGBA8: return 28; /* DXGI_FORMAT_R8G8B8A8_UNORM */
+		case TextureFormat::BC1:   return 71; /* DXGI_FORMAT_BC1_UNORM */
+		case TextureFormat::BC3:   return 77; /* DXGI_FORMAT_BC3_UNORM */
+		case TextureFormat::BC5:   return 83; /* DXGI_FORMAT_BC5_UNORM */
+		default:                   return 0;
+		}
+	}
+
+	static [[nodiscard]] uint32_t BytesPerBlock(TextureFormat format) noexcept
+	{
+		return format == TextureFormat::BC1 ? 8 : 16;
+	}
+
+	static [[nodiscard]] size_t MipSizeBytes(TextureFormat format, uint32_t width, uint32_t height) noexcept
+	{
+		if (!IsBlockCompressed(format))
+			return static_cast<size_t>(width) * height * 4;
+
+		return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * BytesPerBlock(format);
+	}
+
+	/* A mip in linear space, 4 floats per pixel. */
+	struct LinearMip
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<float> Pixels;
+	};
+
+	/* A mip as it's encoded, RGBA8. */
+	struct ByteMip
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Pixels;
+	};
+
+	static [[nodiscard]] float SRGBToLinear(float value) noexcept
+	{
+		return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	static [[nodiscard]] float LinearToSRGB(float value) noexcept
+	{
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	static [[nodiscard]] uint8_t ToUNorm8(float value) noexcept
+	{
+		return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	/* Each output pixel is the average of it's 2x2 footprint, clamped to the edge for odd sizes. */
+	static void DownsampleBox(const LinearMip& source, LinearMip& outMip) noexcept
+	{
+		outMip.Width = std::max(1u, source.Width / 2);
+		outMip.Height = std::max(1u, source.Height / 2);
+		outMip.Pixels.resize(static_cast<size_t>(outMip.Width) * outMip.Height * 4);
+
+		std::vector<uint32_t> rows(outMip.Height);
+		std::iota(rows.begin(), rows.end(), 0u);
+
+		std::for_each(
+			std::execution::par,
+			rows.begin(),
+			rows.end(),
+			[&source, &outMip](uint32_t y)
+			{
+				uint32_t y0 = std::min(y * 2, source.Height - 1);
+				uint32_t y1 = std::min(y * 2 + 1, source.Height - 1);
+
+				const float* pRow0 = source.Pixels.data() + static_cast<size_t>(y0) * source.Width * 4;
+				const float* pRow1 = source.Pixels.data() + static_cast<size_t>(y1) * source.Width * 4;
+				float* pOut = outMip.Pixels.data() + static_cast<size_t>(y) * outMip.Width * 4;
+
+				/* A whole RGBA pixel per register... */
+				const __m128 quarter = _mm_set1_ps(0.25f);
+
+				for (uint32_t x = 0; x < outMip.Width; ++x)
+				{
+					size_t x0 = static_cast<size_t>(std::min(x * 2, source.Width - 1)) * 4;
+					size_t x1 = static_cast<size_t>(std::min(x * 2 + 1, source.Width - 1)) * 4;
+
+					__m128 sum = _mm_add_ps(
+						_mm_add_ps(_mm_loadu_ps(pRow0 + x0), _mm_loadu_ps(pRow0 + x1)),
+						_mm_add_ps(_mm_loadu_ps(pRow1 + x0), _mm_loadu_ps(pRow1 + x1))
+					);
+
+					_mm_storeu_ps(pOut + static_cast<size_t>(x) * 4, _mm_mul_ps(sum, quarter));
+				}
+			}
+		);
+	}
+
+	/* Level 0 is @image as is, every level after is filtered in linear space and converted back. */
+	static [[nodiscard]] std::vector<ByteMip> BuildMips(const DecodedImage& image, bool generateMips, bool isSRGB) noexcept
+	{
+		std::vector<ByteMip> mips;
+
+		ByteMip& top = mips.emplace_back();
+		top.Width = image.Width;
+		top.Height = image.Height;
+		top.Pixels = image.Pixels;
+
+		if (!generateMips)
+			return mips;
+
+		std::array<float, 256> toLinear = {};
+		for (uint32_t i = 0; i < 256; ++i)
+			toLinear[i] = isSRGB ? SRGBToLinear(i / 255.0f) : i / 255.0f;
+
+		LinearMip current;
+		current.Width = image.Width;
+		current.Height = image.Height;
+		current.Pixels.resize(image.Pixels.size());
+
+		for (size_t i = 0; i < image.Pixels.size(); ++i)
+			current.Pixels[i] = (i % 4) == 3 ? image.Pixels[i] / 255.0f : toLinear[image.Pixels[i]];
+
+		LinearMip next;
+
+		while (current.Width > 1 || current.Height > 1)
+		{
+			DownsampleBox(current, next);
+			std::swap(current, next);
+
+			ByteMip& mip = mips.emplace_back();
+			mip.Width = current.Width;
+			mip.Height = current.Height;
+			mip.Pixels.resize(current.Pixels.size());
+
+			for (size_t i = 0; i < current.Pixels.size(); ++i)
+			{
+				float value = current.Pixels[i];
+				mip.Pixels[i] = ToUNorm8((i % 4) == 3 || !isSRGB ? value : LinearToSRGB(value));
+			}
+		}
+
+		return mips;
+	}
+
+	static [[nodiscard]] uint16_t To565(const uint8_t* pColor) noexcept
+	{
+		return static_cast<uint16_t>(
+			((pColor[0] * 31 + 127) / 255) << 11 |
+			((pColor[1] * 63 + 127) / 255) << 5 |
+			((pColor[2] * 31 + 127) / 255)
+		);
+	}
+
+	static void From565(uint16_t color, uint8_t* pOut) noexcept
+	{
+		uint32_t r = (color >> 11) & 31;
+		uint32_t g = (color >> 5) & 63;
+		uint32_t b = color & 31;
+
+		pOut[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+		pOut[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+		pOut[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+	}
+
+	/* 4 color BC1 block of @pBlock's RGB, (16 RGBA8 pixels, row by row) always with color0 > color1,
+	 *   as BC3 ignores the 3 color mode anyway.
+	 *
+	 * Endpoints are the corners of the block's bounding box along it's dominant diagonal, inset
+	 *   slightly, (Waveren 2006) with each pixel then picking it's nearest palette entry. */
+	static void EncodeBC1Color(const uint8_t* pBlock, uint8_t* pOut) noexcept
+	{
+		uint8_t minColor[3] = { 255, 255, 255 };
+		uint8_t maxColor[3] = { 0, 0, 0 };
+
+		for (uint32_t i = 0; i < 16; ++i)
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				minColor[c] = std::min(minColor[c], pBlock[i * 4 + c]);
+				maxColor[c] = std::max(maxColor[c], pBlock[i * 4 + c]);
+			}
+
+		/* Picks which of the box's diagonals the colors lie along, by the sign of their covariance against green. */
+		int32_t center[3] = {};
+		for (uint32_t c = 0; c < 3; ++c)
+			center[c] = (minColor[c] + maxColor[c]) / 2;
+
+		int32_t covarianceRG = 0;
+		int32_t covarianceBG = 0;
+
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			int32_t g = pBlock[i * 4 + 1] - center[1];
+			covarianceRG += (pBlock[i * 4 + 0] - center[0]) * g;
+			covarianceBG += (pBlock[i * 4 + 2] - center[2]) * g;
+		}
+
+		if (covarianceRG < 0)
+			std::swap(minColor[0], maxColor[0]);
+
+		if (covarianceBG < 0)
+			std::swap(minColor[2], maxColor[2]);
+
+		/* Inset by 1/16th of the range, so the endpoints aren't pulled out by outliers... */
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			int32_t inset = (maxColor[c] - minColor[c]) / 16;
+			maxColor[c] = static_cast<uint8_t>(std::clamp(maxColor[c] - inset, 0, 255));
+			minColor[c] = static_cast<uint8_t>(std::clamp(minColor[c] + inset, 0, 255));
+		}
+
+		uint16_t color0 = To565(maxColor);
+		uint16_t color1 = To565(minColor);
+
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		uint32_t indices = 0;
+
+		/* Equal endpoints select the 3 color mode, where every index of 0 is still color0. */
+		if (color0 != color1)
+		{
+			uint8_t palette[4][3] = {};
+			From565(color0, palette[0]);
+			From565(color1, palette[1]);
+
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+				palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+			}
+
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint32_t bestIndex = 0;
+				int32_t bestDistance = std::numeric_limits<int32_t>::max();
+
+				for (uint32_t p = 0; p < 4; ++p)
+				{
+					int32_t dr = pBlock[i * 4 + 0] - palette[p][0];
+					int32_t dg = pBlock[i * 4 + 1] - palette[p][1];
+					int32_t db = pBlock[i * 4 + 2] - palette[p][2];
+					int32_t distance = dr * dr + dg * dg + db * db;
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+
+				indices |= bestIndex << (i * 2);
+			}
+		}
+
+		std::memcpy(pOut, &color0, sizeof(color0));
+		std::memcpy(pOut + 2, &color1, sizeof(color1));
+		std::memcpy(pOut + 4, &indices, sizeof(indices));
+	}
+
+	/* 8 value BC4 block of channel @channel of @pBlock, as used for BC3's alpha and both of BC5's channels. */
+	static void EncodeBC4(const uint8_t* pBlock, uint32_t channel, uint8_t* pOut) noexcept
+	{
+		uint8_t minValue = 255;
+		uint8_t maxValue = 0;
+
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			minValue = std::min(minValue, pBlock[i * 4 + channel]);
+			maxValue = std::max(maxValue, pBlock[i * 4 + channel]);
+		}
+
+		uint64_t indices = 0;
+
+		/* Index 0 is endpoint 0 in either mode, so a flat block needs nothing more. */
+		if (maxValue != minValue)
+		{
+			uint8_t palette[8] = { maxValue, minValue };
+			for (uint32_t p = 1; p < 7; ++p)
+				palette[p + 1] = static_cast<uint8_t>(((7 - p) * maxValue + p * minValue + 3) / 7);
+
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint32_t bestIndex = 0;
+				int32_t bestDistance = std::numeric_limits<int32_t>::max();
+
+				for (uint32_t p = 0; p < 8; ++p)
+				{
+					int32_t distance = std::abs(static_cast<int32_t>(pBlock[i * 4 + channel]) - palette[p]);
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+
+				indices |= static_cast<uint64_t>(bestIndex) << (i * 3);
+			}
+		}
+
+		pOut[0] = maxValue;
+		pOut[1] = minValue;
+
+		for (uint32_t i = 0; i < 6; ++i)
+			pOut[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+	}
+
+	static void EncodeBlock(TextureFormat format, const uint8_t* pBlock, uint8_t* pOut) noexcept
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1:
+			EncodeBC1Color(pBlock, pOut);
+			break;
+		case TextureFormat::BC3:
+			EncodeBC4(pBlock, 3, pOut);
+			EncodeBC1Color(pBlock, pOut + 8);
+			break;
+		case TextureFormat::BC5:
+			EncodeBC4(pBlock, 0, pOut);
+			EncodeBC4(pBlock, 1, pOut + 8);
+			break;
+		default:
+			break;
+		}
+	}
+
+	/* Writes @mip as @format to @pOut, (MipSizeBytes of it) encoding each row of blocks in parallel. */
+	static void EncodeMip(const ByteMip& mip, TextureFormat format, std::byte* pOut) noexcept
+	{
+		if (!IsBlockCompressed(format))
+		{
+			std::memcpy(pOut, mip.Pixels.data(), mip.Pixels.size());
+			return;
+		}
+
+		uint32_t blocksX = (mip.Width + 3) / 4;
+		uint32_t blocksY = (mip.Height + 3) / 4;
+		uint32_t blockBytes = BytesPerBlock(format);
+
+		std::vector<uint32_t> blockRows(blocksY);
+		std::iota(blockRows.begin(), blockRows.end(), 0u);
+
+		std::for_each(
+			std::execution::par,
+			blockRows.begin(),
+			blockRows.end(),
+			[&mip, format, pOut, blocksX, blockBytes](uint32_t blockY)
+			{
+				uint8_t block[16 * 4] = {};
+
+				for (uint32_t blockX = 0; blockX < blocksX; ++blockX)
+				{
+					/* Mips smaller than a block repeat their edge pixels... */
+					for (uint32_t y = 0; y < 4; ++y)
+						for (uint32_t x = 0; x < 4; ++x)
+						{
+							uint32_t sourceX = std::min(blockX * 4 + x, mip.Width - 1);
+							uint32_t sourceY = std::min(blockY * 4 + y, mip.Height - 1);
+
+							std::memcpy(
+								block + (y * 4 + x) * 4,
+								mip.Pixels.data() + (static_cast<size_t>(sourceY) * mip.Width + sourceX) * 4,
+								4
+							);
+						}
+
+					size_t blockIndex = static_cast<size_t>(blockY) * blocksX + blockX;
+					EncodeBlock(format, block, reinterpret_cast<uint8_t*>(pOut) + blockIndex * blockBytes);
+				}
+			}
+		);
+	}
+
+	static [[nodiscard]] TextureFormat ResolveFormat(const DecodedImage& image, TextureFormat format) noexcept
+	{
+		if (format == TextureFormat::Unknown)
+		{
+			bool isOpaque = true;
+
+			for (size_t i = 3; i < image.Pixels.size() && isOpaque; i += 4)
+				isOpaque = image.Pixels[i] == 255;
+
+			format = isOpaque ? TextureFormat::BC1 : TextureFormat::BC3;
+		}
+
+		/* D3D11 requires the top mip of a block compressed texture be a whole number of blocks. */
+		if (IsBlockCompressed(format) && (image.Width % 4 != 0 || image.Height % 4 != 0))
+		{
+			CM_ENGINE_LOG_WARN(
+				"(TextureCooker) Internal warning: Texture isn't a multiple of 4 pixels, it's cooked as RGBA8 instead. Size: {}x{}",
+				image.Width,
+				image.Height
+			);
+
+			return TextureFormat::RGBA8;
+		}
+
+		return format;
+	}
+
+	[[nodiscard]] std::vector<std::byte> CookTexture(const DecodedImage& image, const TextureCookOptions& options) noexcept
+	{
+		if (image.Width == 0 || image.Height == 0 || image.Pixels.size() != static_cast<size_t>(image.Width) * image.Height * 4)
+			return {};
+
+		TextureFormat format = ResolveFormat(image, options.Format);
+		std::vector<ByteMip> mips = BuildMips(image, options.GenerateMips, options.IsSRGB);
+
+		DDSHeader header;
+		header.Flags = G_DDSDCaps | G_DDSDHeight | G_DDSDWidth | G_DDSDPixelFormat | G_DDSDMipMapCount;
+		header.Flags |= IsBlockCompressed(format) ? G_DDSDLinearSize : G_DDSDPitch;
+		header.Height = image.Height;
+		header.Width = image.Width;
+		header.PitchOrLinearSize = static_cast<uint32_t>(
+			IsBlockCompressed(format) ? MipSizeBytes(format, image.Width, image.Height) : static_cast<size_t>(image.Width) * 4
+		);
+		header.MipMapCount = static_cast<uint32_t>(mips.size());
+		header.PixelFormat.Flags = G_DDPFFourCC;
+		header.PixelFormat.FourCC = G_DDSFourCCDX10;
+		header.Caps = G_DDSCapsTexture;
+
+		if (mips.size() > 1)
+			header.Caps |= G_DDSCapsComplex | G_DDSCapsMipMap;
+
+		DDSHeaderDX10 headerDX10;
+		headerDX10.DXGIFormat = DXGIFormatOf(format);
+		headerDX10.ResourceDimension = G_DDSDimensionTexture2D;
+		headerDX10.ArraySize = 1;
+
+		size_t offset = sizeof(G_DDSMagic) + sizeof(header) + sizeof(headerDX10);
+		size_t sizeBytes = offset;
+
+		for (const ByteMip& mip : mips)
+			sizeBytes += MipSizeBytes(format, mip.Width, mip.Height);
+
+		std::vector<std::byte> file(sizeBytes);
+		std::memcpy(file.data(), &G_DDSMagic, sizeof(G_DDSMagic));
+		std::memcpy(file.data() + sizeof(G_DDSMagic), &header, sizeof(header));
+		std::memcpy(file.data() + sizeof(G_DDSMagic) + sizeof(header), &headerDX10, sizeof(headerDX10));
+
+		for (const ByteMip& mip : mips)
+		{
+			EncodeMip(mip, format, file.data() + offset);
+			offset += MipSizeBytes(format, mip.Width, mip.Height);
+		}
+
+		return file;
+	}
+
+	[[nodiscard]] bool WriteCookedTexture(const std::filesystem::path& cookedPath, const DecodedImage& image, const TextureCookOptions& options) noexcept
+	{
+		std::vector<std::byte> file = CookTexture(image, options);
+
+		if (file.empty())
+			return false;
+
+		return WriteFileReplacing(cookedPath, file);
+	}
+}
\ No newline at end of file
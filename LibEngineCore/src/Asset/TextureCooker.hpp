@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Platform/Core/IImageDecoder.hpp"
+#include "Platform/Core/ITexture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace CMEngine::Asset
+{
+	/* Cooked textures are plain DDS files, so any DDS viewer (or DDSTextureLoader) can read them. */
+	inline constexpr const wchar_t* G_CookedTextureExtension = L".dds";
+
+	struct TextureCookOptions
+	{
+		/* Unknown picks BC3 if any pixel isn't fully opaque, otherwise BC1.
+		 *   Block compressed formats fall back to RGBA8 if the image isn't a multiple of 4 pixels. */
+		TextureFormat Format = TextureFormat::Unknown;
+		bool GenerateMips = true;
+		bool IsSRGB = true; /* Color data is filtered in linear space, disable for normal maps and masks. */
+	};
+
+	/* Builds a box filtered mip chain of @image, encodes every mip as @options.Format, (block rows on every
+	 *   core) and returns it as a DDS file with a DX10 header, ready to be handed to IGraphics::CreateTexture.
+	 * Returns an empty vector if @image is empty. */
+	[[nodiscard]] std::vector<std::byte> CookTexture(const DecodedImage& image, const TextureCookOptions& options) noexcept;
+
+	/* Cooks @image and writes it to @cookedPath through a temporary file, so a partially written file is never read. */
+	[[nodiscard]] bool WriteCookedTexture(const std::filesystem::path& cookedPath, const DecodedImage& image, const TextureCookOptions& options) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "PCH.hpp"
+#include "Asset/VertexInterleave.hpp"
+
+#include <immintrin.h>
+
+namespace CMEngine::Asset
+{
+	static_assert(sizeof(Vertex) == 8 * sizeof(float), "InterleaveVertices writes each Vertex as 8 tightly packed floats.");
+
+	/* Read with a stride of 0 in place of absent streams, 4 floats so a 16 byte load stays inside it. */
+	alignas(16) inline constexpr float G_ZeroStream[4] = {};
+
+	void InterleaveVertices(
+		const float* pPositions,
+		const float* pNormals,
+		const float* pTexCoords,
+		std::span<Vertex> outVertices
+	) noexcept
+	{
+		size_t numVertices = outVertices.size();
+
+		if (numVertices == 0)
+			return;
+
+		size_t positionStride = pPositions != nullptr ? 3 : 0;
+		size_t normalStride = pNormals != nullptr ? 3 : 0;
+		size_t texCoordStride = pTexCoords != nullptr ? 3 : 0;
+
+		if (pPositions == nullptr)
+			pPositions = G_ZeroStream;
+
+		if (pNormals == nullptr)
+			pNormals = G_ZeroStream;
+
+		if (pTexCoords == nullptr)
+			pTexCoords = G_ZeroStream;
+
+		float* pOut = reinterpret_cast<float*>(outVertices.data());
+		size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+		/* A 16 byte load of the last element would read 4 bytes past the end of it's stream,
+		 *   so it's left to the scalar loop below. */
+		for (; i + 1 < numVertices; ++i)
+		{
+			__m128 pos = _mm_loadu_ps(pPositions + i * positionStride);       /* px py pz -- */
+			__m128 normal = _mm_loadu_ps(pNormals + i * normalStride);        /* nx ny nz -- */
+			__m128 texCoord = _mm_loadu_ps(pTexCoords + i * texCoordStride);  /* u  v  -- -- */
+
+			__m128 zx = _mm_shuffle_ps(pos, normal, _MM_SHUFFLE(0, 0, 2, 2)); /* pz pz nx nx */
+			__m128 low = _mm_shuffle_ps(pos, zx, _MM_SHUFFLE(2, 0, 1, 0));     /* px py pz nx */
+			__m128 high = _mm_shuffle_ps(normal, texCoord, _MM_SHUFFLE(1, 0, 2, 1)); /* ny nz u v */
+
+			_mm_storeu_ps(pOut + i * 8, low);
+			_mm_storeu_ps(pOut + i * 8 + 4, high);
+		}
+#endif
+
+		for (; i < numVertices; ++i)
+		{
+			const float* pPos = pPositions + i * positionStride;
+			const float* pNormal = pNormals + i * normalStride;
+			const float* pTexCoord = pTexCoords + i * texCoordStride;
+
+			outVertices[i] = Vertex{
+				Float3(pPos[0], pPos[1], pPos[2]),
+				Float3(pNormal[0], pNormal[1], pNormal[2]),
+				Float2(pTexCoord[0], pTexCoord[1])
+			};
+		}
+	}
+}
\ No newline at end of file
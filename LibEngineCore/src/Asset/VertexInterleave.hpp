@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+
+#include <span>
+
+namespace CMEngine::Asset
+{
+	/* Writes @outVertices.size() vertices from separate position, normal and texcoord streams
+	 *   in a single pass. Each stream holds 3 floats per vertex, (the layout assimp stores every
+	 *   attribute in) of which only x and y are read for texcoords. A nullptr stream reads as zeros.
+	 *
+	 * Absent streams are resolved once up front, rather than per vertex. With SSE each vertex is
+	 *   three 16 byte loads, (one per stream) shuffled into two 16 byte stores, as Vertex is exactly 32 bytes.
+	 *   (See Tools/VertexBenchmark) */
+	void InterleaveVertices(
+		const float* pPositions,
+		const float* pNormals,
+		const float* pTexCoords,
+		std::span<Vertex> outVertices
+	) noexcept;
+}
\ No newline at end of file
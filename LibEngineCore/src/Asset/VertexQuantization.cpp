@@ -0,0 +1,204 @@
+#include "PCH.hpp"
+#include "Asset/VertexQuantization.hpp"
+
+#include <DirectXPackedVector.h>
+
+namespace CMEngine::Asset
+{
+	static constexpr float S_UNorm16Max = 65535.0f;
+	static constexpr float S_SNorm16Max = 32767.0f;
+
+	/* Axes thinner than this fraction of the largest one (ex. a flat plane) are widened to it,
+	 *   otherwise dividing normals by VertexQuantization::Scale would blow up. */
+	static constexpr float S_MinRelativeScale = 1e-4f;
+
+	static [[nodiscard]] uint16_t EncodeUNorm16(float value) noexcept
+	{
+		return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * S_UNorm16Max));
+	}
+
+	static [[nodiscard]] int16_t EncodeSNorm16(float value) noexcept
+	{
+		return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * S_SNorm16Max));
+	}
+
+	/* D3D maps both -32768 and -32767 to -1.0 */
+	static [[nodiscard]] float DecodeSNorm16(int16_t value) noexcept
+	{
+		return std::max(static_cast<float>(value) / S_SNorm16Max, -1.0f);
+	}
+
+	static [[nodiscard]] float SignNotZero(float value) noexcept
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	static [[nodiscard]] Float3 NormalizeOr(Float3 v, Float3 fallback) noexcept
+	{
+		float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+
+		if (length <= 0.0f || !std::isfinite(length))
+			return fallback;
+
+		return v * (1.0f / length);
+	}
+
+	/* Projects @n onto the octahedron |x| + |y| + |z| = 1, folding the lower hemisphere over the upper. */
+	static void EncodeOctahedral(Float3 n, int16_t (&outEncoded)[2]) noexcept
+	{
+		float invL1 = 1.0f / (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+
+		float x = n.x * invL1;
+		float y = n.y * invL1;
+
+		if (n.z < 0.0f)
+		{
+			float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+			float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+
+			x = foldedX;
+			y = foldedY;
+		}
+
+		outEncoded[0] = EncodeSNorm16(x);
+		outEncoded[1] = EncodeSNorm16(y);
+	}
+
+	/* Must match DecodeNormal in Gltf_Common_VS. */
+	static [[nodiscard]] Float3 DecodeOctahedral(const int16_t (&encoded)[2]) noexcept
+	{
+		float x = DecodeSNorm16(encoded[0]);
+		float y = DecodeSNorm16(encoded[1]);
+		float z = 1.0f - std::abs(x) - std::abs(y);
+
+		float t = std::max(-z, 0.0f);
+
+		x += x >= 0.0f ? -t : t;
+		y += y >= 0.0f ? -t : t;
+
+		return NormalizeOr(Float3(x, y, z), Float3(0.0f, 0.0f, 1.0f));
+	}
+
+	void QuantizeVertices(MeshData& data) noexcept
+	{
+		using DirectX::PackedVector::XMConvertFloatToHalf;
+
+		data.QuantizedVertices.clear();
+
+		if (data.Vertices.empty())
+		{
+			data.Quantization = VertexQuantization();
+			return;
+		}
+
+		Float3 min = data.Vertices.front().Pos;
+		Float3 max = min;
+
+		for (const Vertex& vertex : data.Vertices)
+		{
+			min.x = std::min(min.x, vertex.Pos.x);
+			min.y = std::min(min.y, vertex.Pos.y);
+			min.z = std::min(min.z, vertex.Pos.z);
+
+			max.x = std::max(max.x, vertex.Pos.x);
+			max.y = std::max(max.y, vertex.Pos.y);
+			max.z = std::max(max.z, vertex.Pos.z);
+		}
+
+		Float3 size(max.x - min.x, max.y - min.y, max.z - min.z);
+		float maxSize = std::max({ size.x, size.y, size.z });
+		float minScale = maxSize > 0.0f ? maxSize * S_MinRelativeScale : 1.0f;
+
+		VertexQuantization& quantization = data.Quantization;
+		quantization.Min = min;
+		quantization.Scale = Float3(
+			std::max(size.x, minScale),
+			std::max(size.y, minScale),
+			std::max(size.z, minScale)
+		);
+
+		const Float3& scale = quantization.Scale;
+		Float3 invScale(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+
+		data.QuantizedVertices.resize(data.Vertices.size());
+
+		for (size_t i = 0; i < data.Vertices.size(); ++i)
+		{
+			const Vertex& vertex = data.Vertices[i];
+			QuantizedVertex& quantized = data.QuantizedVertices[i];
+
+			quantized.Pos[0] = EncodeUNorm16((vertex.Pos.x - min.x) * invScale.x);
+			quantized.Pos[1] = EncodeUNorm16((vertex.Pos.y - min.y) * invScale.y);
+			quantized.Pos[2] = EncodeUNorm16((vertex.Pos.z - min.z) * invScale.z);
+			quantized.Pos[3] = 0;
+
+			/* Undone by the scale folded into the instance transform, (see the header) */
+			Float3 normal = NormalizeOr(vertex.Normal * invScale, Float3(0.0f, 0.0f, 1.0f));
+			EncodeOctahedral(normal, quantized.Normal);
+
+			quantized.TexCoord[0] = XMConvertFloatToHalf(vertex.TexCoord.x);
+			quantized.TexCoord[1] = XMConvertFloatToHalf(vertex.TexCoord.y);
+		}
+	}
+
+	[[nodiscard]] Vertex DequantizeVertex(const QuantizedVertex& vertex, const VertexQuantization& quantization) noexcept
+	{
+		using DirectX::PackedVector::XMConvertHalfToFloat;
+
+		const Float3& min = quantization.Min;
+		const Float3& scale = quantization.Scale;
+
+		Vertex out;
+		out.Pos = Float3(
+			min.x + (vertex.Pos[0] / S_UNorm16Max) * scale.x,
+			min.y + (vertex.Pos[1] / S_UNorm16Max) * scale.y,
+			min.z + (vertex.Pos[2] / S_UNorm16Max) * scale.z
+		);
+
+		out.Normal = NormalizeOr(DecodeOctahedral(vertex.Normal) * scale, Float3(0.0f, 0.0f, 1.0f));
+		out.TexCoord = Float2(XMConvertHalfToFloat(vertex.TexCoord[0]), XMConvertHalfToFloat(vertex.TexCoord[1]));
+
+		return out;
+	}
+
+	[[nodiscard]] QuantizationError MeasureQuantizationError(const MeshData& data) noexcept
+	{
+		QuantizationError error;
+
+		if (!data.IsQuantized())
+			return error;
+
+		float maxCosAngle = 1.0f;
+
+		for (size_t i = 0; i < data.Vertices.size(); ++i)
+		{
+			const Vertex& original = data.Vertices[i];
+			Vertex decoded = DequantizeVertex(data.QuantizedVertices[i], data.Quantization);
+
+			float dx = decoded.Pos.x - original.Pos.x;
+			float dy = decoded.Pos.y - original.Pos.y;
+			float dz = decoded.Pos.z - original.Pos.z;
+
+			error.MaxPosition = std::max(error.MaxPosition, std::sqrt(dx * dx + dy * dy + dz * dz));
+
+			Float3 normal = NormalizeOr(original.Normal, Float3(0.0f, 0.0f, 1.0f));
+			float cosAngle = normal.x * decoded.Normal.x + normal.y * decoded.Normal.y + normal.z * decoded.Normal.z;
+
+			maxCosAngle = std::min(maxCosAngle, cosAngle);
+
+			error.MaxTexCoord = std::max({
+				error.MaxTexCoord,
+				std::abs(decoded.TexCoord.x - original.TexCoord.x),
+				std::abs(decoded.TexCoord.y - original.TexCoord.y)
+			});
+		}
+
+		const Float3& scale = data.Quantization.Scale;
+		float diagonal = std::sqrt(scale.x * scale.x + scale.y * scale.y + scale.z * scale.z);
+
+		error.MaxPositionRelative = diagonal > 0.0f ? error.MaxPosition / diagonal : 0.0f;
+		error.MaxNormalDegrees = DirectX::XMConvertToDegrees(std::acos(std::clamp(maxCosAngle, -1.0f, 1.0f)));
+
+		return error;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+
+namespace CMEngine::Asset
+{
+	/* Part of every CookKey, bump it whenever QuantizeVertices' encoding changes. */
+	inline constexpr uint32_t G_VertexQuantizationVersion = 1;
+
+	/* Worst case error of a mesh's QuantizedVertices against it's full precision Vertices. */
+	struct QuantizationError
+	{
+		float MaxPosition = 0.0f;         /* Object space distance. */
+		float MaxPositionRelative = 0.0f; /* MaxPosition over the length of the AABB's diagonal. */
+		float MaxNormalDegrees = 0.0f;    /* Angle between the original and decoded normal. */
+		float MaxTexCoord = 0.0f;
+	};
+
+	/* Fills data.QuantizedVertices and data.Quantization from data.Vertices.
+	 *
+	 * Positions are stored as unorm16 within the mesh's AABB. Rather than decoding them per vertex,
+	 *   the renderer folds VertexQuantization into each instance's transform. That transform then
+	 *   also scales normals by VertexQuantization::Scale, so normals are divided by it before
+	 *   octahedral encoding, and come out right once renormalized in the shader. */
+	void QuantizeVertices(MeshData& data) noexcept;
+
+	/* Decodes @vertex the same way Gltf_Common_VS does, back into object space. */
+	[[nodiscard]] Vertex DequantizeVertex(const QuantizedVertex& vertex, const VertexQuantization& quantization) noexcept;
+
+	[[nodiscard]] QuantizationError MeasureQuantizationError(const MeshData& data) noexcept;
+}
\ No newline at end of file
@@ -5,24 +5,42 @@
 
 namespace CMEngine::Renderer
 {
-	BatchRenderer::BatchRenderer(ECS::ECS& ecs, AGraphics& graphics, Asset::AssetManager& assetManager) noexcept
+	/* Clears the per-frame instances of a batch, but keeps their allocations. */
+	static void ClearBatch(Batch& batch) noexcept
+	{
+		batch.OffsetInstances = 0;
+		batch.NumInstances = 0;
+		batch.Instances.clear();
+		batch.MaterialIndices.clear();
+		batch.TextureSlices.clear();
+		batch.ClusterRanges.clear();
+		batch.ClusterRangeOffsets.clear();
+	}
+
+	BatchRenderer::BatchRenderer(ECS::ECS& ecs, AGraphics& graphics, StateCache& stateCache, UploadRing& uploadRing, Asset::AssetManager& assetManager) noexcept
 		: m_ECS(ecs),
 		  m_Graphics(graphics),
-		  m_AssetManager(assetManager)
+		  m_StateCache(stateCache),
+		  m_UploadRing(uploadRing),
+		  m_AssetManager(assetManager),
+		  m_TextureTable(graphics, assetManager)
 	{
 		/* approx. 10 kb of vertices... */
 		constexpr size_t InitialVertexBufferSize = (1024 * 10) / sizeof(Asset::Vertex);
-		constexpr size_t InitialIndexBufferSize = (1024) / sizeof(Asset::Index);
+		constexpr size_t InitialIndexBufferSize = (1024) / sizeof(Asset::Index16);
 
 		m_Vertices.reserve(InitialVertexBufferSize);
-		m_Indices.reserve(InitialIndexBufferSize);
+		m_Indices16.reserve(InitialIndexBufferSize);
 
 		m_VB_Vertices  = m_Graphics.CreateBuffer(GPUBufferType::Vertex);
+		m_VB_QuantizedVertices = m_Graphics.CreateBuffer(GPUBufferType::Vertex);
 		m_VB_Instances = m_Graphics.CreateBuffer(GPUBufferType::Vertex, GPUBufferFlag::Dynamic);
-		m_IB_Indices   = m_Graphics.CreateBuffer(GPUBufferType::Index);
-		m_CB_Material  = m_Graphics.CreateBuffer(GPUBufferType::Constant, GPUBufferFlag::Dynamic);
+		m_IB_Indices16 = m_Graphics.CreateBuffer(GPUBufferType::Index);
+		m_IB_Indices32 = m_Graphics.CreateBuffer(GPUBufferType::Index);
+		m_SB_Materials = m_Graphics.CreateBuffer(GPUBufferType::Structured, GPUBufferFlag::Dynamic, sizeof(Asset::MaterialData));
 
-		constexpr std::array<InputElement, 4> Elements = {
+		/* Vertex and instance elements are declared separately, as every vertex format pairs with every instance format. */
+		constexpr std::array<InputElement, 3> VertexElements = {
 			InputElement(
 				"POSITION",
 				0, // Semantic index
@@ -49,7 +67,41 @@ namespace CMEngine::Renderer
 				G_InputElement_InferByteOffset,
 				InputClass::PerVertex,
 				0
+			)
+		};
+
+		/* Must match Asset::QuantizedVertex. */
+		constexpr std::array<InputElement, 3> QuantizedVertexElements = {
+			InputElement(
+				"POSITION",
+				0,
+				DataFormat::UNorm16x4,
+				0,
+				0,
+				InputClass::PerVertex,
+				0
+			),
+			InputElement(
+				"NORMAL",
+				0,
+				DataFormat::SNorm16x2,
+				0,
+				G_InputElement_InferByteOffset,
+				InputClass::PerVertex,
+				0
 			),
+			InputElement(
+				"TEXCOORD",
+				0,
+				DataFormat::Float16x2,
+				0,
+				G_InputElement_InferByteOffset,
+				InputClass::PerVertex,
+				0
+			)
+		};
+
+		constexpr std::array<InputElement, 3> BasicInstanceElements = {
 			InputElement(
 				"INST_TRANSFORM",
 				G_InputElement_ExpandAsMultiple,
@@ -58,27 +110,101 @@ namespace CMEngine::Renderer
 				G_InputElement_InferByteOffset,
 				InputClass::PerInstance,
 				1
+			),
+			InputElement(
+				"INST_MATERIAL",
+				0,
+				DataFormat::UInt32,
+				1,
+				G_InputElement_InferByteOffset,
+				InputClass::PerInstance,
+				1
+			),
+			InputElement(
+				"INST_TEXTURE",
+				0,
+				DataFormat::UInt32,
+				1,
+				G_InputElement_InferByteOffset,
+				InputClass::PerInstance,
+				1
 			)
 		};
 
-		ShaderID gltfBasicVertexId = m_Graphics.GetShader(L"Gltf_Basic_VS");
-		m_IL_Basic = m_Graphics.CreateInputLayout(
-			std::span<const InputElement>(Elements.data(), Elements.size()),
-			gltfBasicVertexId
-		);
+		constexpr std::array<InputElement, 3> CompactInstanceElements = {
+			InputElement(
+				"INST_TRANSFORM",
+				G_InputElement_ExpandAsMultiple,
+				DataFormat::Mat3x4,
+				1,
+				G_InputElement_InferByteOffset,
+				InputClass::PerInstance,
+				1
+			),
+			InputElement(
+				"INST_MATERIAL_FLAGS",
+				0,
+				DataFormat::UInt32,
+				1,
+				G_InputElement_InferByteOffset,
+				InputClass::PerInstance,
+				1
+			),
+			InputElement(
+				"INST_TEXTURE",
+				0,
+				DataFormat::UInt32,
+				1,
+				G_InputElement_InferByteOffset,
+				InputClass::PerInstance,
+				1
+			)
+		};
+
+		/* Shader lookups are by name, so resolve them once instead of every Flush... */
+		m_VS_Basic = m_Graphics.GetShader(L"Gltf_Basic_VS");
+		m_VS_Compact = m_Graphics.GetShader(L"Gltf_Compact_VS");
+		m_VS_BasicQuantized = m_Graphics.GetShader(L"Gltf_Basic_Quantized_VS");
+		m_VS_CompactQuantized = m_Graphics.GetShader(L"Gltf_Compact_Quantized_VS");
+		m_PS_Basic = m_Graphics.GetShader(L"Gltf_Basic_PS");
+		m_PS_Texture = m_Graphics.GetShader(L"Gltf_Texture_PS");
+
+		auto createInputLayout = [this](
+			std::span<const InputElement> vertexElements,
+			std::span<const InputElement> instanceElements,
+			ShaderID vertexShader
+		)
+		{
+			std::vector<InputElement> elements(vertexElements.begin(), vertexElements.end());
+			elements.insert(elements.end(), instanceElements.begin(), instanceElements.end());
+
+			return m_Graphics.CreateInputLayout(elements, vertexShader);
+		};
+
+		m_IL_Basic = createInputLayout(VertexElements, BasicInstanceElements, m_VS_Basic);
+		m_IL_Compact = createInputLayout(VertexElements, CompactInstanceElements, m_VS_Compact);
+		m_IL_BasicQuantized = createInputLayout(QuantizedVertexElements, BasicInstanceElements, m_VS_BasicQuantized);
+		m_IL_CompactQuantized = createInputLayout(QuantizedVertexElements, CompactInstanceElements, m_VS_CompactQuantized);
+
+		m_UnloadSubscription = m_AssetManager.SubscribeUnload([this](Asset::AssetID id) { OnAssetUnloaded(id); });
+	}
+
+	BatchRenderer::~BatchRenderer() noexcept
+	{
+		m_AssetManager.UnsubscribeUnload(m_UnloadSubscription);
 	}
 
 	void BatchRenderer::BeginBatch() noexcept
 	{
 		/* Clear previous per-frame instances. */
 		for (auto& [key, batch] : m_Batches)
-		{
-			batch.OffsetInstances = 0;
-			batch.NumInstances = 0;
-			batch.Instances.clear();
-		}
+			ClearBatch(batch);
+
+		m_NumTransparentBatches = 0;
 
 		m_Instances.clear();
+		m_CompactInstances.clear();
+		m_Submissions.clear();
 	}
 
 	void BatchRenderer::EndBatch() noexcept
@@ -87,33 +213,135 @@ namespace CMEngine::Renderer
 		{
 			CollectMeshes();
 
-			m_Graphics.SetBuffer(m_VB_Vertices, m_Vertices.data(), m_Vertices.size() * sizeof(Asset::Vertex));
-			m_Graphics.SetBuffer(m_IB_Indices, m_Indices.data(), m_Indices.size() * sizeof(Asset::Index));
+			m_VertexBytes = m_Vertices.size() * sizeof(Asset::Vertex) +
+				m_QuantizedVertices.size() * sizeof(Asset::QuantizedVertex);
+
+			/* Either vertex arena may be empty, if every mesh was (or wasn't) quantized... */
+			if (!m_Vertices.empty())
+				m_Graphics.SetBuffer(m_VB_Vertices, m_Vertices.data(), m_Vertices.size() * sizeof(Asset::Vertex));
+
+			if (!m_QuantizedVertices.empty())
+				m_Graphics.SetBuffer(m_VB_QuantizedVertices, m_QuantizedVertices.data(), m_QuantizedVertices.size() * sizeof(Asset::QuantizedVertex));
+
+			/* Most content never needs the 32-bit arena... */
+			if (!m_Indices16.empty())
+				m_Graphics.SetBuffer(m_IB_Indices16, m_Indices16.data(), m_Indices16.size() * sizeof(Asset::Index16));
+
+			if (!m_Indices32.empty())
+				m_Graphics.SetBuffer(m_IB_Indices32, m_Indices32.data(), m_Indices32.size() * sizeof(Asset::Index32));
 		}
 
+		UpdateMaterialTable();
+		m_TextureTable.Update();
+		CullSubmissions();
+		QueueSubmissions();
+
 		/* First iteration to get total number of instances (potentially save allocations). */
 		size_t totalInstances = 0;
 		for (const auto& [key, batch] : m_Batches)
 			totalInstances += batch.Instances.size();
+
+		for (size_t i = 0; i < m_NumTransparentBatches; ++i)
+			totalInstances += m_TransparentBatches[i].second.Instances.size();
 		
-		m_Instances.reserve(totalInstances);
+		bool isCompact = m_InstanceFormat == InstanceFormat::Compact;
+
+		if (isCompact)
+			m_CompactInstances.reserve(totalInstances);
+		else
+			m_Instances.reserve(totalInstances);
+
+		ConstView<ECS::ECSSparseSet<TransformComponent>> sparseSet = m_ECS.GetSparseSet<TransformComponent>();
+
+		m_ClusterCuller.BeginFrame();
 
 		/* Consolidate all instances into a single buffer... */
 		size_t currentInstanceOffset = 0;
-		for (auto& [key, batch] : m_Batches)
+
+		auto appendInstances = [&](const Key& key, Batch& batch)
 		{
 			batch.OffsetInstances = (uint32_t)currentInstanceOffset;
 			batch.NumInstances = (uint32_t)batch.Instances.size();
 
-			ConstView<ECS::ECSSparseSet<TransformComponent>> sparseSet = m_ECS.GetSparseSet<TransformComponent>();
-			for (ECS::Entity e : batch.Instances)
-				if (const TransformComponent* pTransform = sparseSet->Get(e); pTransform)
-					m_Instances.emplace_back(pTransform->ModelMatrix);
+			if (batch.Instances.empty())
+				return;
+
+			/* Culling already dropped instances of meshes that weren't collected. */
+			const MeshMeta& metadata = m_MeshMetadata[key.MeshID];
+
+			/* A single meshlet has the same bounds as the instance, which was already culled. */
+			bool isClusterCulled = m_ClusterCullingEnabled &&
+				m_ClusterCuller.HasCamera() &&
+				key.LOD == 0 &&
+				metadata.Clusters.Ranges.size() > 1;
+
+			if (isClusterCulled)
+				batch.ClusterRangeOffsets.emplace_back(0);
+
+			for (size_t i = 0; i < batch.Instances.size(); ++i)
+			{
+				const TransformComponent* pTransform = sparseSet->Get(batch.Instances[i]);
+
+				if (!pTransform)
+					continue;
+
+				if (isClusterCulled)
+				{
+					m_ClusterCuller.Cull(metadata.Clusters, pTransform->ModelMatrix, batch.ClusterRanges);
+					batch.ClusterRangeOffsets.emplace_back((uint32_t)batch.ClusterRanges.size());
+				}
+
+				/* Quantized positions are in [0, 1] across the mesh's AABB, so the dequantization is folded in here
+				 *   instead of being decoded per vertex. */
+				Math::Mat4 transform = metadata.IsQuantized ?
+					DirectX::XMMatrixMultiply(pTransform->ModelMatrix, metadata.Dequantize) :
+					pTransform->ModelMatrix;
+
+				if (isCompact)
+					m_CompactInstances.emplace_back(transform, batch.MaterialIndices[i], batch.TextureSlices[i]);
+				else
+					m_Instances.emplace_back(transform, batch.MaterialIndices[i], batch.TextureSlices[i]);
+			}
 			
 			currentInstanceOffset += batch.Instances.size();
+		};
+
+		for (auto& [key, batch] : m_Batches)
+			appendInstances(key, batch);
+
+		for (size_t i = 0; i < m_NumTransparentBatches; ++i)
+			appendInstances(m_TransparentBatches[i].first, m_TransparentBatches[i].second);
+
+		m_InstanceBytes = isCompact ?
+			m_CompactInstances.size() * sizeof(CompactBatchInstance) :
+			m_Instances.size() * sizeof(BatchInstance);
+
+		/* Everything was culled, nothing to upload, (the ring's buffer always exists, so it's still safe to bind) */
+		if (m_InstanceBytes == 0)
+		{
+			m_InstancesInRing = true;
+			m_InstanceOffsetBytes = 0;
+			return;
 		}
 
-		m_Graphics.SetBuffer(m_VB_Instances, m_Instances.data(), m_Instances.size() * sizeof(BatchInstance));
+		const void* pInstances = isCompact ?
+			static_cast<const void*>(m_CompactInstances.data()) :
+			static_cast<const void*>(m_Instances.data());
+
+		/* Packed into this frame's mapping of the upload ring, and bound at it's offset in Flush... */
+		UploadAllocation allocation = m_UploadRing.Allocate(m_InstanceBytes);
+		m_InstancesInRing = allocation.IsValid();
+
+		if (m_InstancesInRing)
+		{
+			std::memcpy(allocation.pData, pInstances, m_InstanceBytes);
+			m_InstanceOffsetBytes = allocation.OffsetBytes;
+			return;
+		}
+
+		/* The ring grows next frame, until then the instances get a buffer of their own. */
+		m_Graphics.SetBuffer(m_VB_Instances, pInstances, m_InstanceBytes);
+		m_InstanceOffsetBytes = 0;
 	}
 
 	void BatchRenderer::SubmitMesh(MeshComponent mesh) noexcept
@@ -135,13 +363,389 @@ namespace CMEngine::Renderer
 		if (!meshID || !materialID)
 			return;
 
-		m_Batches[Key(e, meshID, materialID, textureID)].Instances.emplace_back(e);
+		uint32_t materialIndex = RegisterMaterial(materialID);
+
+		if (materialIndex == S_InvalidMaterialIndex)
+			return;
+
+		/* Instances whose texture doesn't exist are drawn untextured... */
+		TextureSlot textureSlot;
+
+		if (textureID)
+			textureSlot = m_TextureTable.Register(textureID);
+
+		m_Submissions.emplace_back(Key(e, meshID, textureSlot.Page), materialIndex, textureSlot.Slice);
+	}
+
+	[[nodiscard]] uint32_t BatchRenderer::RegisterMaterial(Asset::AssetID materialID) noexcept
+	{
+		if (auto it = m_MaterialIndices.find(materialID); it != m_MaterialIndices.end())
+			return it->second;
+
+		ConstView<Asset::Material> material;
+		m_AssetManager.GetMaterial(materialID, material);
+
+		if (material.Null())
+			return S_InvalidMaterialIndex;
+
+		/* Unloaded materials' indices are reused first, so the table only grows with the materials resident at once... */
+		if (!m_FreeMaterialIndices.empty())
+		{
+			uint32_t index = m_FreeMaterialIndices.back();
+			m_FreeMaterialIndices.pop_back();
+
+			m_MaterialTable[index] = material->Data;
+			m_MaterialIDs[index] = materialID;
+			m_MaterialIndices.emplace(materialID, index);
+
+			m_MaterialTableDirty = true;
+			return index;
+		}
+
+		uint32_t index = (uint32_t)m_MaterialTable.size();
+
+		/* Has to fit in CompactBatchInstance's packed material index... */
+		if (index >= CompactBatchInstance::S_MaxMaterials)
+		{
+			CM_ENGINE_LOG_WARN(
+				"(BatchRenderer) Internal warning: Material table is full, the instance is ignored. Max materials: {}",
+				CompactBatchInstance::S_MaxMaterials
+			);
+
+			return S_InvalidMaterialIndex;
+		}
+
+		m_MaterialTable.emplace_back(material->Data);
+		m_MaterialIDs.emplace_back(materialID);
+		m_MaterialIndices.emplace(materialID, index);
+
+		m_MaterialTableDirty = true;
+		return index;
+	}
+
+	void BatchRenderer::UpdateMaterialTable() noexcept
+	{
+		for (size_t i = 0; i < m_MaterialTable.size(); ++i)
+		{
+			ConstView<Asset::Material> material;
+			m_AssetManager.GetMaterial(m_MaterialIDs[i], material);
+
+			/* Unloaded, (see OnAssetUnloaded) so the index is unused until it's reused... */
+			if (material.Null())
+				continue;
+
+			if (std::memcmp(&m_MaterialTable[i], &material->Data, sizeof(Asset::MaterialData)) == 0)
+				continue;
+
+			m_MaterialTable[i] = material->Data;
+			m_MaterialTableDirty = true;
+		}
+
+		if (!m_MaterialTableDirty)
+			return;
+
+		m_Graphics.SetBuffer(m_SB_Materials, m_MaterialTable.data(), m_MaterialTable.size() * sizeof(Asset::MaterialData));
+
+		++m_NumMaterialUploads;
+		m_MaterialTableDirty = false;
+	}
+
+	void BatchRenderer::OnAssetUnloaded(Asset::AssetID id) noexcept
+	{
+		switch (id.Type())
+		{
+		case Asset::AssetType::Mesh:
+		{
+			if (m_MeshMetadata.erase(id) == 0)
+				return;
+
+			std::erase_if(m_Batches, [&](const auto& batch) { return batch.first.MeshID == id; });
+
+			/* It's stale ID is then dropped from m_SubmittedMeshes, and every mesh after it is packed down into it's range... */
+			m_MeshSubmitted = true;
+			return;
+		}
+		case Asset::AssetType::Material:
+		{
+			auto it = m_MaterialIndices.find(id);
+
+			if (it == m_MaterialIndices.end())
+				return;
+
+			m_MaterialIDs[it->second] = Asset::AssetID();
+			m_FreeMaterialIndices.emplace_back(it->second);
+			m_MaterialIndices.erase(it);
+			return;
+		}
+		case Asset::AssetType::Texture:
+			m_TextureTable.Release(id);
+			return;
+		default:
+			return;
+		}
+	}
+
+	void BatchRenderer::SetCamera(const CameraComponent& camera) noexcept
+	{
+		m_Frustum.Extract(camera.Matrices);
+		m_Culler.SetFrustum(m_Frustum);
+		m_OcclusionCuller.SetCamera(camera.Matrices);
+		m_ClusterCuller.SetCamera(m_Frustum, camera.Data.Origin);
+		m_DepthSorter.SetCamera(camera.Matrices);
+
+		m_CameraOrigin = camera.Data.Origin;
+		m_LODProjScale = 1.0f / std::tan(Math::AngleToRadians(camera.Data.FovAngle) * 0.5f);
+	}
+
+	void BatchRenderer::CullSubmissions() noexcept
+	{
+		ConstView<ECS::ECSSparseSet<TransformComponent>> sparseSet = m_ECS.GetSparseSet<TransformComponent>();
+
+		m_LODStats = LODStats();
+
+		if (sparseSet.Null())
+		{
+			m_Submissions.clear();
+			return;
+		}
+
+		/* Instances without a transform or collected mesh can't be placed or drawn anyways... */
+		std::erase_if(
+			m_Submissions,
+			[&](const Submission& submission)
+			{
+				const Key& key = submission.BatchKey;
+
+				return sparseSet->Get(key.Entity) == nullptr ||
+					m_MeshMetadata.find(key.MeshID) == m_MeshMetadata.end();
+			}
+		);
+
+		m_Culler.Clear();
+		m_Culler.Reserve(m_Submissions.size());
+
+		for (const Submission& submission : m_Submissions)
+		{
+			const Key& key = submission.BatchKey;
+			m_Culler.Push(m_MeshMetadata[key.MeshID].Bounds, sparseSet->Get(key.Entity)->ModelMatrix);
+		}
+
+		m_Culler.Cull();
+
+		m_Visible.resize(m_Submissions.size());
+		for (size_t i = 0; i < m_Submissions.size(); ++i)
+			m_Visible[i] = (uint8_t)m_Culler.IsVisible(i);
+
+		m_OcclusionCuller.BeginFrame();
+
+		if (m_OcclusionEnabled && m_OcclusionCuller.HasCamera())
+			OccludeSubmissions();
+	}
+
+	void BatchRenderer::QueueSubmissions() noexcept
+	{
+		ConstView<ECS::ECSSparseSet<TransformComponent>> sparseSet = m_ECS.GetSparseSet<TransformComponent>();
+
+		m_QueueStats = RenderQueueStats();
+
+		/* CullSubmissions already dropped every submission in this case... */
+		if (sparseSet.Null())
+			return;
+
+		/* The culler already has every submission's world-space center, so all depths are computed in one pass. */
+		bool isDepthSorted = m_DepthSorter.HasCamera();
+
+		if (isDepthSorted)
+			m_DepthSorter.Compute(m_Culler.CenterX(), m_Culler.CenterY(), m_Culler.CenterZ());
+
+		/* Culled instances never reach a batch, and therefore never reach the instance buffer. */
+		m_SortedSubmissions.clear();
+
+		for (size_t i = 0; i < m_Submissions.size(); ++i)
+		{
+			if (!m_Visible[i])
+				continue;
+
+			RenderQueue queue = SelectRenderQueue(m_MaterialTable[m_Submissions[i].MaterialIndex]);
+			uint32_t depthKey = 0;
+
+			if (isDepthSorted)
+				depthKey = queue == RenderQueue::Opaque ?
+					m_DepthSorter.FrontToBackKey(i) :
+					m_DepthSorter.BackToFrontKey(i);
+
+			m_SortedSubmissions.emplace_back(((uint64_t)queue << 32) | depthKey, (uint32_t)i);
+		}
+
+		std::sort(m_SortedSubmissions.begin(), m_SortedSubmissions.end());
+
+		/* Each LOD of a mesh is it's own batch, so the LOD is only picked for what's left.
+		 *   Opaque instances are appended to their batch front-to-back, so each batch is drawn front-to-back,
+		 *   while transparent ones can only share a batch with their immediate neighbours to stay in order. */
+		for (const auto& [sortKey, index] : m_SortedSubmissions)
+		{
+			const Submission& submission = m_Submissions[index];
+			const MeshMeta& metadata = m_MeshMetadata[submission.BatchKey.MeshID];
+
+			Key key = submission.BatchKey;
+			key.LOD = SelectLOD(metadata, sparseSet->Get(key.Entity)->ModelMatrix);
+
+			Batch* pBatch = nullptr;
+
+			if ((RenderQueue)(sortKey >> 32) == RenderQueue::Opaque)
+			{
+				pBatch = &m_Batches[key];
+				++m_QueueStats.NumOpaque;
+			}
+			else
+			{
+				if (m_NumTransparentBatches == 0 || !(m_TransparentBatches[m_NumTransparentBatches - 1].first == key))
+				{
+					if (m_NumTransparentBatches == m_TransparentBatches.size())
+						m_TransparentBatches.emplace_back(key, Batch());
+					else
+					{
+						m_TransparentBatches[m_NumTransparentBatches].first = key;
+						ClearBatch(m_TransparentBatches[m_NumTransparentBatches].second);
+					}
+
+					++m_NumTransparentBatches;
+					++m_QueueStats.NumTransparentRuns;
+				}
+
+				pBatch = &m_TransparentBatches[m_NumTransparentBatches - 1].second;
+				++m_QueueStats.NumTransparent;
+			}
+
+			pBatch->Instances.emplace_back(key.Entity);
+			pBatch->MaterialIndices.emplace_back(submission.MaterialIndex);
+			pBatch->TextureSlices.emplace_back(submission.TextureSlice);
+
+			++m_LODStats.NumInstances[key.LOD];
+			m_LODStats.NumTriangles += metadata.LODs[key.LOD].NumIndices / 3;
+			m_LODStats.NumFullTriangles += metadata.NumIndices / 3;
+		}
+	}
+
+	void BatchRenderer::OccludeSubmissions() noexcept
+	{
+		ConstView<ECS::ECSSparseSet<OccluderComponent>> occluders = m_ECS.GetSparseSet<OccluderComponent>();
+
+		if (occluders.Null())
+			return;
+
+		ConstView<ECS::ECSSparseSet<TransformComponent>> sparseSet = m_ECS.GetSparseSet<TransformComponent>();
+
+		/* Only occluders that survived frustum culling can hide anything on screen... */
+		for (size_t i = 0; i < m_Submissions.size(); ++i)
+		{
+			const Key& key = m_Submissions[i].BatchKey;
+
+			if (!m_Visible[i] || !occluders->Contains(key.Entity))
+				continue;
+
+			ConstView<Asset::Mesh> mesh;
+			m_AssetManager.GetMesh(key.MeshID, mesh);
+
+			if (mesh.NonNull())
+				m_OcclusionCuller.AddOccluder(mesh->Data, sparseSet->Get(key.Entity)->ModelMatrix);
+		}
+
+		if (!m_OcclusionCuller.HasOccluders())
+			return;
+
+		m_OcclusionCuller.Rasterize();
+
+		m_OcclusionQueries.clear();
+		m_OcclusionQueryIndices.clear();
+
+		for (size_t i = 0; i < m_Submissions.size(); ++i)
+		{
+			if (!m_Visible[i])
+				continue;
+
+			const Key& key = m_Submissions[i].BatchKey;
+
+			OcclusionQuery& query = m_OcclusionQueries.emplace_back();
+			query.pBounds = &m_MeshMetadata[key.MeshID].Bounds;
+			query.pModelMatrix = &sparseSet->Get(key.Entity)->ModelMatrix;
+
+			m_OcclusionQueryIndices.emplace_back((uint32_t)i);
+		}
+
+		m_OcclusionResults.resize(m_OcclusionQueries.size());
+		m_OcclusionCuller.Test(m_OcclusionQueries, m_OcclusionResults);
+
+		for (size_t i = 0; i < m_OcclusionResults.size(); ++i)
+			if (!m_OcclusionResults[i])
+				m_Visible[m_OcclusionQueryIndices[i]] = 0;
+	}
+
+	[[nodiscard]] uint8_t BatchRenderer::SelectLOD(const MeshMeta& metadata, const Math::Mat4& modelMatrix) const noexcept
+	{
+		if (!m_LODEnabled || metadata.LODs.size() <= 1 || m_LODProjScale <= 0.0f)
+			return 0;
+
+		DirectX::XMFLOAT4X4 m;
+		DirectX::XMStoreFloat4x4(&m, modelMatrix);
+
+		/* ModelMatrix is stored transposed, so each row holds a world axis with it's translation in w. */
+		const Asset::MeshBounds& bounds = metadata.Bounds;
+		const float center[3] = { bounds.Center.x, bounds.Center.y, bounds.Center.z };
+		const float origin[3] = { m_CameraOrigin.x, m_CameraOrigin.y, m_CameraOrigin.z };
+
+		float distanceSq = 0.0f;
+		for (size_t row = 0; row < 3; ++row)
+		{
+			float worldCenter = m.m[row][3];
+
+			for (size_t col = 0; col < 3; ++col)
+				worldCenter += m.m[row][col] * center[col];
+
+			float delta = worldCenter - origin[row];
+			distanceSq += delta * delta;
+		}
+
+		/* Errors are in object space, so they're scaled by the largest axis scale to stay conservative. */
+		float maxScaleSq = 0.0f;
+		for (size_t col = 0; col < 3; ++col)
+		{
+			float scaleSq = m.m[0][col] * m.m[0][col] +
+				m.m[1][col] * m.m[1][col] +
+				m.m[2][col] * m.m[2][col];
+
+			maxScaleSq = std::max(maxScaleSq, scaleSq);
+		}
+
+		float scale = std::sqrt(maxScaleSq);
+
+		/* Distance to the nearest point of the bounding sphere, as that's where the error would be most visible. */
+		float distance = std::sqrt(distanceSq) - bounds.Radius * scale;
+
+		if (distance <= 0.0f)
+			return 0;
+
+		/* Fraction of the screen's height covered by an object space length, at that distance. */
+		float screenScale = scale * m_LODProjScale / (2.0f * distance);
+
+		uint8_t lod = 0;
+		for (size_t i = 1; i < metadata.LODs.size(); ++i)
+		{
+			if (metadata.LODs[i].Error * screenScale > m_LODThreshold)
+				break;
+
+			lod = static_cast<uint8_t>(i);
+		}
+
+		return lod;
 	}
 
 	void BatchRenderer::CollectMeshes() noexcept
 	{
 		size_t totalVertices = 0;
-		size_t totalIndices = 0;
+		size_t totalQuantizedVertices = 0;
+		size_t totalIndices16 = 0;
+		size_t totalIndices32 = 0;
 
 		/* Remove all submitted meshes with an invalid mesh id... */
 		std::erase_if(
@@ -156,18 +760,41 @@ namespace CMEngine::Renderer
 					return true;
 
 				/* Accumulate total buffer sizes while meshes are retrieved... */
-				totalVertices += meshAsset->Data.Vertices.size();
-				totalIndices += meshAsset->Data.Indices.size();
+				if (meshAsset->Data.IsQuantized())
+					totalQuantizedVertices += meshAsset->Data.QuantizedVertices.size();
+				else
+					totalVertices += meshAsset->Data.Vertices.size();
+
+				/* Each LOD's indices follow the full mesh's... */
+				size_t numIndices = meshAsset->Data.Indices.size() + meshAsset->Data.LODIndices.size();
+
+				if (meshAsset->Data.Width == Asset::IndexWidth::Bits16)
+					totalIndices16 += numIndices;
+				else
+					totalIndices32 += numIndices;
 
 				return false;
 			}
 		);
 
-		m_Vertices.resize(totalVertices);
-		m_Indices.resize(totalIndices);
+		/* Meshes are unloaded too, (see OnAssetUnloaded) so the arenas don't keep the most they've ever held... */
+		auto resizeArena = [](auto& arena, size_t size)
+			{
+				arena.resize(size);
+
+				if (arena.capacity() > size * 2)
+					arena.shrink_to_fit();
+			};
+
+		resizeArena(m_Vertices, totalVertices);
+		resizeArena(m_QuantizedVertices, totalQuantizedVertices);
+		resizeArena(m_Indices16, totalIndices16);
+		resizeArena(m_Indices32, totalIndices32);
 
 		uint32_t offsetVertices = 0;
-		uint32_t offsetIndices = 0;
+		uint32_t offsetQuantizedVertices = 0;
+		uint32_t offsetIndices16 = 0;
+		uint32_t offsetIndices32 = 0;
 
 		uint32_t currentOffsetVertices = 0;
 		uint32_t currentOffsetIndices = 0;
@@ -179,13 +806,22 @@ namespace CMEngine::Renderer
 
 			/* Null checks aren't necessary because of previous filtering... */
 			const auto& vertices = meshAsset->Data.Vertices;
+			const auto& quantizedVertices = meshAsset->Data.QuantizedVertices;
 			const auto& indices = meshAsset->Data.Indices;
+			const auto& lodIndices = meshAsset->Data.LODIndices;
 
-			currentOffsetVertices = offsetVertices;
+			/* Each vertex format and index width has it's own arena, and therefore it's own offsets... */
+			bool isQuantized = meshAsset->Data.IsQuantized();
+			uint32_t& offsetMeshVertices = isQuantized ? offsetQuantizedVertices : offsetVertices;
+
+			Asset::IndexWidth width = meshAsset->Data.Width;
+			uint32_t& offsetIndices = width == Asset::IndexWidth::Bits16 ? offsetIndices16 : offsetIndices32;
+
+			currentOffsetVertices = offsetMeshVertices;
 			currentOffsetIndices = offsetIndices;
 
-			offsetVertices += (uint32_t)vertices.size();
-			offsetIndices += (uint32_t)indices.size();
+			offsetMeshVertices += (uint32_t)vertices.size();
+			offsetIndices += (uint32_t)(indices.size() + lodIndices.size());
 
 			auto it = m_MeshMetadata.find(mesh.ID);
 			bool metadataExists = it != m_MeshMetadata.end();
@@ -200,19 +836,45 @@ namespace CMEngine::Renderer
 				!indicesRequireCopy)
 				continue;
 
-			if (verticesRequireCopy)
+			if (verticesRequireCopy && isQuantized)
+				std::memcpy(
+					std::to_address(m_QuantizedVertices.begin() + currentOffsetVertices),
+					quantizedVertices.data(),
+					sizeof(Asset::QuantizedVertex) * quantizedVertices.size()
+				);
+			else if (verticesRequireCopy)
 				std::memcpy(
 					std::to_address(m_Vertices.begin() + currentOffsetVertices),
 					vertices.data(),
 					sizeof(Asset::Vertex) * vertices.size()
 				);
 
+			/* Indices are local to the mesh (offset by baseVertexLocation), so narrowing them is lossless. */
+			auto copyIndices = [&](const std::vector<Asset::Index>& source, uint32_t offset)
+				{
+					if (source.empty())
+						return;
+
+					if (width == Asset::IndexWidth::Bits16)
+						std::transform(
+							source.begin(),
+							source.end(),
+							m_Indices16.begin() + offset,
+							[](Asset::Index index) { return static_cast<Asset::Index16>(index); }
+						);
+					else
+						std::memcpy(
+							std::to_address(m_Indices32.begin() + offset),
+							source.data(),
+							sizeof(Asset::Index32) * source.size()
+						);
+				};
+
 			if (indicesRequireCopy)
-				std::memcpy(
-					std::to_address(m_Indices.begin() + currentOffsetIndices),
-					indices.data(),
-					sizeof(Asset::Index) * indices.size()
-				);
+			{
+				copyIndices(indices, currentOffsetIndices);
+				copyIndices(lodIndices, currentOffsetIndices + (uint32_t)indices.size());
+			}
 
 			/* Mesh data was present, but was re-copied due to layout change. */
 			if (metadataExists)
@@ -228,6 +890,30 @@ namespace CMEngine::Renderer
 			metadata.OffsetIndices = currentOffsetIndices;
 			metadata.NumVertices = (uint32_t)vertices.size();
 			metadata.NumIndices = (uint32_t)indices.size();
+			metadata.IndexWidth = width;
+			metadata.Bounds = meshAsset->Bounds;
+			metadata.IsQuantized = isQuantized;
+
+			if (!meshAsset->Data.Meshlets.empty())
+				metadata.Clusters.Build(meshAsset->Data.Meshlets);
+
+			metadata.LODs.emplace_back(Asset::MeshLOD{ 0, (uint32_t)indices.size(), 0.0f });
+
+			for (const Asset::MeshLOD& lod : meshAsset->Data.LODs)
+				metadata.LODs.emplace_back(Asset::MeshLOD{ (uint32_t)indices.size() + lod.FirstIndex, lod.NumIndices, lod.Error });
+
+			if (isQuantized)
+			{
+				const Asset::VertexQuantization& quantization = meshAsset->Data.Quantization;
+
+				/* Row vector scale then translate, transposed to match the model matrix. */
+				metadata.Dequantize = DirectX::XMMatrixTranspose(
+					DirectX::XMMatrixMultiply(
+						DirectX::XMMatrixScaling(quantization.Scale.x, quantization.Scale.y, quantization.Scale.z),
+						DirectX::XMMatrixTranslation(quantization.Min.x, quantization.Min.y, quantization.Min.z)
+					)
+				);
+			}
 		}
 
 		m_MeshSubmitted = false;
@@ -235,66 +921,155 @@ namespace CMEngine::Renderer
 
 	void BatchRenderer::Flush() noexcept
 	{
-		ShaderID basicVSID = m_Graphics.GetShader(L"Gltf_Basic_VS");
-		ShaderID basicPSID = m_Graphics.GetShader(L"Gltf_Basic_PS");
-		ShaderID texturePSID = m_Graphics.GetShader(L"Gltf_Texture_PS");
+		bool isCompact = m_InstanceFormat == InstanceFormat::Compact;
 
-		constexpr uint32_t OffsetBytes = 0;
-		constexpr uint32_t StartIndex = 0;
+		spdlog::stopwatch stopwatch;
 
-		m_Graphics.BindVertexBuffer(m_VB_Vertices, sizeof(Asset::Vertex), OffsetBytes, S_VB_Vertices_Register);
-		m_Graphics.BindVertexBuffer(m_VB_Instances, sizeof(BatchInstance), OffsetBytes, S_VB_Instances_Register);
-		m_Graphics.BindIndexBuffer(m_IB_Indices, DataFormat::UInt16, StartIndex);
+		/* Opaque batches first, then transparent ones back-to-front... */
+		m_DrawItems.clear();
 
-		m_Graphics.BindInputLayout(m_IL_Basic);
+		for (const auto& [key, batch] : m_Batches)
+			if (batch.NumInstances != 0)
+				m_DrawItems.emplace_back(DrawItem{ &key, &batch, BlendMode::Opaque });
 
-		m_Graphics.BindShader(basicVSID);
-		m_Graphics.BindShader(basicPSID);
+		for (size_t i = 0; i < m_NumTransparentBatches; ++i)
+			if (m_TransparentBatches[i].second.NumInstances != 0)
+				m_DrawItems.emplace_back(DrawItem{ &m_TransparentBatches[i].first, &m_TransparentBatches[i].second, BlendMode::AlphaBlend });
 
-		Asset::AssetID lastMaterialID;
-		Asset::AssetID lastTextureID;
+		size_t numLists = std::max<size_t>((m_DrawItems.size() + S_BatchesPerCommandList - 1) / S_BatchesPerCommandList, 1);
 
-		for (const auto& [key, batch] : m_Batches)
+		if (m_CommandLists.size() < numLists)
+			m_CommandLists.resize(numLists);
+
+		/* Recording only reads the batches, so each list is recorded on it's own thread... */
+		if (numLists <= 1)
+			RecordBatches(m_CommandLists[0], 0, m_DrawItems.size());
+		else
 		{
-			ConstView<Asset::Material> material;
-			m_AssetManager.GetMaterial(key.MaterialID, material);
+			m_CommandListIndices.resize(numLists);
+			std::iota(m_CommandListIndices.begin(), m_CommandListIndices.end(), 0u);
 
-			CM_ENGINE_ASSERT(material.NonNull());
+			std::for_each(
+				std::execution::par,
+				m_CommandListIndices.begin(),
+				m_CommandListIndices.end(),
+				[this](uint32_t list)
+				{
+					size_t first = (size_t)list * S_BatchesPerCommandList;
+					RecordBatches(m_CommandLists[list], first, std::min(first + S_BatchesPerCommandList, m_DrawItems.size()));
+				}
+			);
+		}
 
-			if (key.MaterialID != lastMaterialID)
-			{
-				m_Graphics.SetBuffer(m_CB_Material, &material->Data, sizeof(material->Data));
-				m_Graphics.BindConstantBufferPS(m_CB_Material, S_CB_Material_Register);
-			}
+		m_CommandListStats = CommandListStats();
+		m_CommandListStats.NumLists = (uint32_t)numLists;
+		m_CommandListStats.RecordMillis = std::chrono::duration<float, std::milli>(stopwatch.elapsed()).count();
+
+		stopwatch.reset();
+
+		/* Redundant binds (ex. the same buffers as last frame) are dropped by the state cache. */
+		m_StateCache.BindVertexBuffer(
+			m_InstancesInRing ? m_UploadRing.Buffer() : m_VB_Instances,
+			isCompact ? sizeof(CompactBatchInstance) : sizeof(BatchInstance),
+			m_InstanceOffsetBytes,
+			S_VB_Instances_Register
+		);
+
+		/* Every batch reads it's instances' materials from the same table... */
+		if (!m_MaterialTable.empty())
+			m_StateCache.BindStructuredBufferPS(m_SB_Materials, S_SB_Materials_Register);
+
+		/* Lists only bind what they need, the state cache drops whatever the previous list already bound. */
+		for (size_t i = 0; i < numLists; ++i)
+		{
+			const CommandList& list = m_CommandLists[i];
+			list.Replay(m_StateCache, m_Graphics);
+
+			m_CommandListStats.NumCommands += (uint32_t)list.NumCommands();
+			m_CommandListStats.NumDraws += list.NumDraws();
+		}
 
-			bool wasTextureDependent = lastTextureID.IsRegistered();
-			bool isTextureDependent = key.TextureID.IsRegistered();
-			bool differentTextureID = key.TextureID != lastTextureID;
+		/* Anything drawn after the batches expects the default state... */
+		m_StateCache.BindBlendMode(BlendMode::Opaque);
 
-			lastMaterialID = key.MaterialID;
-			lastTextureID = key.TextureID;
+		m_CommandListStats.ReplayMillis = std::chrono::duration<float, std::milli>(stopwatch.elapsed()).count();
+	}
+
+	void BatchRenderer::RecordBatches(CommandList& list, size_t firstItem, size_t lastItem) const noexcept
+	{
+		constexpr uint32_t OffsetBytes = 0;
+		constexpr uint32_t StartIndex = 0;
 
-			auto texture = m_ECS.TryGetComponent<TextureComponent>(key.Entity);
+		bool isCompact = m_InstanceFormat == InstanceFormat::Compact;
 
-			/* Current texture use is different from previous.. */
-			if (isTextureDependent != wasTextureDependent)
-				m_Graphics.BindShader(isTextureDependent ? texturePSID : basicPSID);
+		list.Reset();
 
+		for (size_t item = firstItem; item < lastItem; ++item)
+		{
+			const Key& key = *m_DrawItems[item].pKey;
+			const Batch& batch = *m_DrawItems[item].pBatch;
 
-			if (texture.NonNull() &&
-				isTextureDependent &&
-				differentTextureID)
-				m_Graphics.BindTexture(texture->Texture);
+			list.BindBlendMode(m_DrawItems[item].Blend);
+
+			/* Every texture of a page shares one texture array, so textures alone never split a batch. */
+			bool isTextured = key.TexturePage != TextureSlot::S_InvalidPage &&
+				m_TextureTable.GetPage(key.TexturePage) != nullptr;
+
+			list.BindShader(isTextured ? m_PS_Texture : m_PS_Basic);
+
+			if (isTextured)
+				list.BindTexture(m_TextureTable.GetPage(key.TexturePage));
 
 			auto it = m_MeshMetadata.find(key.MeshID);
 			CM_ENGINE_ASSERT(it != m_MeshMetadata.end());
 
-			MeshMeta& metadata = it->second;
+			const MeshMeta& metadata = it->second;
+			const Asset::MeshLOD& lod = metadata.LODs[key.LOD];
+
+			/* The vertex stream, layout and shader only change between quantized and full precision meshes. */
+			if (metadata.IsQuantized)
+			{
+				list.BindVertexBuffer(m_VB_QuantizedVertices, sizeof(Asset::QuantizedVertex), OffsetBytes, S_VB_Vertices_Register);
+				list.BindInputLayout(isCompact ? m_IL_CompactQuantized : m_IL_BasicQuantized);
+				list.BindShader(isCompact ? m_VS_CompactQuantized : m_VS_BasicQuantized);
+			}
+			else
+			{
+				list.BindVertexBuffer(m_VB_Vertices, sizeof(Asset::Vertex), OffsetBytes, S_VB_Vertices_Register);
+				list.BindInputLayout(isCompact ? m_IL_Compact : m_IL_Basic);
+				list.BindShader(isCompact ? m_VS_Compact : m_VS_Basic);
+			}
+
+			/* Consecutive batches of the same index width don't rebind, the state cache drops it on replay. */
+			if (metadata.IndexWidth == Asset::IndexWidth::Bits16)
+				list.BindIndexBuffer(m_IB_Indices16, DataFormat::UInt16, StartIndex);
+			else
+				list.BindIndexBuffer(m_IB_Indices32, DataFormat::UInt32, StartIndex);
+
+			/* Each instance culled it's own meshlets, so each draws it's own ranges... */
+			if (!batch.ClusterRangeOffsets.empty())
+			{
+				for (size_t i = 0; i + 1 < batch.ClusterRangeOffsets.size(); ++i)
+					for (uint32_t r = batch.ClusterRangeOffsets[i]; r < batch.ClusterRangeOffsets[i + 1]; ++r)
+					{
+						const IndexRange& range = batch.ClusterRanges[r];
+
+						list.DrawIndexedInstanced(
+							range.NumIndices,
+							1,
+							metadata.OffsetIndices + range.FirstIndex,
+							metadata.OffsetVertices,
+							batch.OffsetInstances + (uint32_t)i
+						);
+					}
+
+				continue;
+			}
 
-			m_Graphics.DrawIndexedInstanced(
-				metadata.NumIndices,
+			list.DrawIndexedInstanced(
+				lod.NumIndices,
 				batch.NumInstances,
-				metadata.OffsetIndices,
+				metadata.OffsetIndices + lod.FirstIndex,
 				metadata.OffsetVertices,
 				batch.OffsetInstances
 			);
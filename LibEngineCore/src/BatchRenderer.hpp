@@ -6,8 +6,17 @@
 #include "Types.hpp"
 #include "ECS/ECS.hpp"
 #include "Asset/AssetManager.hpp"
+#include "Culling.hpp"
+#include "Occlusion.hpp"
+#include "ClusterCulling.hpp"
+#include "StateCache.hpp"
+#include "TextureTable.hpp"
+#include "RenderQueue.hpp"
+#include "CommandList.hpp"
+#include "UploadRing.hpp"
 
 #include <vector>
+#include <array>
 #include <map>
 #include <functional> // std::hash
 
@@ -16,55 +25,88 @@ namespace CMEngine::Renderer
 	struct Key
 	{
 		inline constexpr Key(
-			ECS::Entity e, /* For optionally retrieving Resource<ITexture>... */
+			ECS::Entity e,
 			Asset::AssetID meshID,
-			Asset::AssetID materialID,
-			Asset::AssetID textureID = Asset::AssetID()
+			uint16_t texturePage = TextureSlot::S_InvalidPage
 		) noexcept
 			: Entity(e),
 			  MeshID(meshID),
-			  MaterialID(materialID),
-			  TextureID(textureID)
+			  TexturePage(texturePage)
 		{
 		}
 
 		inline [[nodiscard]] bool operator==(const Key& other) const noexcept
 		{
 			return MeshID == other.MeshID &&
-				MaterialID == other.MaterialID &&
-				TextureID == other.TextureID;
+				LOD == other.LOD &&
+				TexturePage == other.TexturePage;
 		}
 
-		/* Strict weak ordering... */
+		/* Strict weak ordering... (LODs of the same mesh stay adjacent) */
 		inline [[nodiscard]] bool operator<(const Key& rhs) const noexcept
 		{
 			if (MeshID != rhs.MeshID)
 				return MeshID < rhs.MeshID;
-			if (MaterialID != rhs.MaterialID)
-				return MaterialID < rhs.MaterialID;
-			return TextureID < rhs.TextureID;
+			if (LOD != rhs.LOD)
+				return LOD < rhs.LOD;
+			return TexturePage < rhs.TexturePage;
 		}
 
 		/* TODO: Move to Batch as Representative (first entity added) */
 		ECS::Entity Entity; /* Not sorted, we don't care about any key's entity. */
 		Asset::AssetID MeshID;
-		Asset::AssetID MaterialID;
-		Asset::AssetID TextureID;
+		uint16_t TexturePage = TextureSlot::S_InvalidPage; /* Texture array the batch samples from, if textured. */
+		uint8_t LOD = 0; /* Into MeshMeta::LODs, picked per instance once it's survived culling. */
+		/* NOTE: Materials and texture slices aren't part of the key, each instance indexes the material table and
+		 *   it's texture array instead. */
+	};
+
+	/* A single SubmitInstance call, before culling. */
+	struct Submission
+	{
+		inline constexpr Submission(const Key& key, uint32_t materialIndex, uint32_t textureSlice) noexcept
+			: BatchKey(key),
+			  MaterialIndex(materialIndex),
+			  TextureSlice(textureSlice)
+		{
+		}
+
+		Key BatchKey;
+		uint32_t MaterialIndex = 0;
+		uint32_t TextureSlice = 0;
 	};
 
 	struct MeshMeta
 	{
 		Asset::AssetID MeshID;
-		int32_t OffsetVertices = 0; /* int32_t for conformity with ID3D11DeviceContext::DrawIndexedInstanced's baseVertexLocation. */
+		int32_t OffsetVertices = 0; /* int32_t for conformity with ID3D11DeviceContext::DrawIndexedInstanced's baseVertexLocation. (Into the arena IsQuantized selects) */
 		uint32_t OffsetIndices = 0; 
 		uint32_t NumVertices = 0;
 		uint32_t NumIndices = 0;
+		Asset::IndexWidth IndexWidth = Asset::IndexWidth::Bits16; /* Selects the index arena OffsetIndices is into. */
+		Asset::MeshBounds Bounds;
+		/* Maps QuantizedVertex positions back into object space, stored transposed like TransformComponent::ModelMatrix,
+		 *   and folded into each of the mesh's instance transforms. */
+		Math::Mat4 Dequantize = Math::IdentityMatrix();
+		ClusterBounds Clusters; /* Empty unless the mesh was split into meshlets at import, and only covers LOD 0. */
+		/* [0] is the full mesh. FirstIndex is relative to OffsetIndices, as each LOD's indices follow the last's in the arena. */
+		std::vector<Asset::MeshLOD> LODs;
+		bool IsQuantized = false;
+	};
+
+	struct LODStats
+	{
+		std::array<uint32_t, Asset::G_MaxMeshLODs> NumInstances = {}; /* Per LOD. */
+		uint64_t NumTriangles = 0;     /* Of every visible instance, before cluster culling. */
+		uint64_t NumFullTriangles = 0; /* Had every visible instance been drawn at LOD 0. */
 	};
 
 	struct BatchInstance
 	{
-		inline BatchInstance(const Math::Mat4& transform) noexcept
-			: Transform(transform)
+		inline BatchInstance(const Math::Mat4& transform, uint32_t materialIndex, uint32_t textureSlice) noexcept
+			: Transform(transform),
+			  MaterialIndex(materialIndex),
+			  TextureSlice(textureSlice)
 		{
 		}
 
@@ -74,6 +116,42 @@ namespace CMEngine::Renderer
 		BatchInstance& operator=(BatchInstance&&) = default;
 
 		Math::Mat4 Transform;
+		uint32_t MaterialIndex = 0; /* Into the material table. */
+		uint32_t TextureSlice = 0; /* Into the batch's texture array. (Key::TexturePage) */
+	};
+
+	/* 48 byte affine transform, a packed material index / flags word, and a texture slice.
+	 * 56 bytes in total, compared to BatchInstance's 80. (Mat4's alignment pads the material index and slice) */
+	struct CompactBatchInstance
+	{
+		static constexpr uint32_t S_MaterialBits = 24;
+		static constexpr uint32_t S_MaterialMask = (1u << S_MaterialBits) - 1;
+		static constexpr uint32_t S_MaxMaterials = S_MaterialMask + 1;
+
+		inline CompactBatchInstance(const Math::Mat4& transform, uint32_t materialIndex, uint32_t textureSlice, uint8_t flags = 0) noexcept
+			: Transform(Math::ToMat3x4(transform)),
+			  MaterialAndFlags(Pack(materialIndex, flags)),
+			  TextureSlice(textureSlice)
+		{
+		}
+
+		/* Material index in the low 24 bits, flags in the high 8 bits. (Must match Gltf_Compact_VS) */
+		inline static constexpr [[nodiscard]] uint32_t Pack(uint32_t materialIndex, uint8_t flags) noexcept
+		{
+			return (materialIndex & S_MaterialMask) | (static_cast<uint32_t>(flags) << S_MaterialBits);
+		}
+
+		Math::Mat3x4 Transform;
+		uint32_t MaterialAndFlags = 0;
+		uint32_t TextureSlice = 0;
+	};
+
+	static_assert(sizeof(CompactBatchInstance) == 56, "CompactBatchInstance must be tightly packed, as it's uploaded as is.");
+
+	enum class InstanceFormat : uint8_t
+	{
+		Basic,  /* BatchInstance, Gltf_Basic_VS */
+		Compact /* CompactBatchInstance, Gltf_Compact_VS */
 	};
 
 	struct Batch
@@ -82,14 +160,21 @@ namespace CMEngine::Renderer
 		uint32_t OffsetInstances = 0;
 		/* ECS::Entity's with TransformComponent's, MaterialComponent's, TextureComponent's, etc. */
 		std::vector<ECS::Entity> Instances;
+		std::vector<uint32_t> MaterialIndices; /* Parallel to Instances. */
+		std::vector<uint32_t> TextureSlices;   /* Parallel to Instances. */
+
+		/* Only used if the batch's mesh is cluster culled, in which case every instance draws it's own visible
+		 *   ranges. Instance i's ranges are ClusterRanges[ClusterRangeOffsets[i]..ClusterRangeOffsets[i + 1]] */
+		std::vector<IndexRange> ClusterRanges;
+		std::vector<uint32_t> ClusterRangeOffsets;
 	};
 
 	class BatchRenderer
 	{
 		friend class Renderer;
 	public:
-		BatchRenderer(ECS::ECS& ecs, AGraphics& graphics, Asset::AssetManager& assetManager) noexcept;
-		~BatchRenderer() noexcept = default;
+		BatchRenderer(ECS::ECS& ecs, AGraphics& graphics, StateCache& stateCache, UploadRing& uploadRing, Asset::AssetManager& assetManager) noexcept;
+		~BatchRenderer() noexcept;
 	public:
 		void BeginBatch() noexcept;
 		void EndBatch() noexcept;
@@ -102,29 +187,162 @@ namespace CMEngine::Renderer
 			Asset::AssetID materialID,
 			Asset::AssetID textureID = Asset::AssetID()
 		) noexcept;
+
+		/* Updates the frustum used to cull submitted instances in EndBatch. */
+		void SetCamera(const CameraComponent& camera) noexcept;
+
+		/* Instances with an OccluderComponent are rasterized into a CPU depth buffer, which all
+		 *   frustum visible instances are then tested against. (Enabled by default) */
+		inline void SetOcclusionCulling(bool enabled) noexcept { m_OcclusionEnabled = enabled; }
+
+		inline [[nodiscard]] const FrustumCuller& GetCuller() const noexcept { return m_Culler; }
+		inline [[nodiscard]] const OcclusionStats& GetOcclusionStats() const noexcept { return m_OcclusionCuller.Stats(); }
+
+		/* Instances of meshes with meshlets have each meshlet frustum and cone culled. (Enabled by default) */
+		inline void SetClusterCulling(bool enabled) noexcept { m_ClusterCullingEnabled = enabled; }
+		inline [[nodiscard]] const ClusterCullStats& GetClusterCullStats() const noexcept { return m_ClusterCuller.Stats(); }
+
+		/* Instances of meshes with LODs are drawn at the coarsest LOD whose error projects to at most @threshold,
+		 *   as a fraction of the screen's height. (Enabled by default, at about a pixel at 1080p) */
+		inline void SetLODSelection(bool enabled) noexcept { m_LODEnabled = enabled; }
+		inline void SetLODThreshold(float threshold) noexcept { m_LODThreshold = threshold; }
+		inline [[nodiscard]] const LODStats& GetLODStats() const noexcept { return m_LODStats; }
+
+		/* Instances of materials with a base color alpha below 1 are blended, after every opaque instance. */
+		inline [[nodiscard]] const RenderQueueStats& GetRenderQueueStats() const noexcept { return m_QueueStats; }
+
+		/* Only takes effect on the next EndBatch. (Compact by default) */
+		inline void SetInstanceFormat(InstanceFormat format) noexcept { m_InstanceFormat = format; }
+		inline [[nodiscard]] InstanceFormat GetInstanceFormat() const noexcept { return m_InstanceFormat; }
+		inline [[nodiscard]] size_t InstanceBytes() const noexcept { return m_InstanceBytes; }
+
+		/* Of both vertex arenas, as of the last upload. */
+		inline [[nodiscard]] size_t VertexBytes() const noexcept { return m_VertexBytes; }
+		inline [[nodiscard]] size_t NumQuantizedVertices() const noexcept { return m_QuantizedVertices.size(); }
+
+		inline [[nodiscard]] size_t NumMaterials() const noexcept { return m_MaterialTable.size() - m_FreeMaterialIndices.size(); }
+		inline [[nodiscard]] uint32_t NumMaterialUploads() const noexcept { return m_NumMaterialUploads; }
+
+		inline [[nodiscard]] const TextureTable& GetTextureTable() const noexcept { return m_TextureTable; }
+
+		/* Of the last Flush. */
+		inline [[nodiscard]] const CommandListStats& GetCommandListStats() const noexcept { return m_CommandListStats; }
 	private:
+		/* A non-empty batch to draw, in draw order. */
+		struct DrawItem
+		{
+			const Key* pKey = nullptr;
+			const Batch* pBatch = nullptr;
+			BlendMode Blend = BlendMode::Opaque;
+		};
+
+		/* Returns the material's index into the material table, adding it if it isn't already present.
+		 * Returns S_InvalidMaterialIndex if the material doesn't exist. */
+		[[nodiscard]] uint32_t RegisterMaterial(Asset::AssetID materialID) noexcept;
+
+		/* Re-reads every registered material, and re-uploads the table only if any have changed. */
+		void UpdateMaterialTable() noexcept;
+
+		/* Drops everything cached of an asset AssetManager unloaded, so it's arena ranges, material index
+		 *   and texture slice are freed for whatever is registered next. */
+		void OnAssetUnloaded(Asset::AssetID id) noexcept;
+
 		void CollectMeshes() noexcept;
+		void CullSubmissions() noexcept;
+		void OccludeSubmissions() noexcept;
+
+		/* Moves every visible submission into it's queue's batches, in the queue's depth order. */
+		void QueueSubmissions() noexcept;
+
+		[[nodiscard]] uint8_t SelectLOD(const MeshMeta& metadata, const Math::Mat4& modelMatrix) const noexcept;
 
 		void Flush() noexcept;
+
+		/* Records m_DrawItems[firstItem..lastItem) into @list, which is reset first. Safe to call concurrently
+		 *   for different lists, as it only reads the batches. */
+		void RecordBatches(CommandList& list, size_t firstItem, size_t lastItem) const noexcept;
 	private:
 		static constexpr uint32_t S_VB_Vertices_Register = 0;
 		static constexpr uint32_t S_VB_Instances_Register = 1;
-		static constexpr uint32_t S_CB_Material_Register = 0;
+		static constexpr uint32_t S_SB_Materials_Register = 1; /* t0 is used by textures. */
+		static constexpr uint32_t S_InvalidMaterialIndex = ~static_cast<uint32_t>(0);
+		static constexpr float S_DefaultLODThreshold = 1.0f / 1080.0f;
+		static constexpr size_t S_BatchesPerCommandList = 128;
 		ECS::ECS& m_ECS;
 		AGraphics& m_Graphics;
+		StateCache& m_StateCache;
+		UploadRing& m_UploadRing;
 		Asset::AssetManager& m_AssetManager;
 		std::vector<Asset::Vertex> m_Vertices;
-		std::vector<Asset::Index> m_Indices;
+		std::vector<Asset::QuantizedVertex> m_QuantizedVertices; /* Meshes quantized at import. */
+		std::vector<Asset::Index16> m_Indices16;
+		std::vector<Asset::Index32> m_Indices32;
 		std::vector<BatchInstance> m_Instances;
+		std::vector<CompactBatchInstance> m_CompactInstances;
 		std::vector<MeshComponent> m_SubmittedMeshes;
+		/* Every instance submitted this frame, before culling. Only visible ones are moved into m_Batches. */
+		std::vector<Submission> m_Submissions;
+		std::vector<uint8_t> m_Visible; /* Per submission, after frustum and occlusion culling. */
+		/* (Queue << 32 | depth key, submission index) of every visible submission. */
+		std::vector<std::pair<uint64_t, uint32_t>> m_SortedSubmissions;
 		std::unordered_map<Asset::AssetID, MeshMeta> m_MeshMetadata;
-		/* Ensure Batch's are sorted based on their mesh, material, and/or texture id's. (Olog(n))... */
-		std::map<Key, Batch> m_Batches;
+		/* Ensure Batch's are sorted based on their mesh and/or texture id's. (Olog(n))... */
+		std::map<Key, Batch> m_Batches; /* RenderQueue::Opaque */
+		/* RenderQueue::Transparent, in draw order. Consecutive instances of the same key share a batch.
+		 *   Only the first m_NumTransparentBatches are in use, the rest are kept to reuse their allocations. */
+		std::vector<std::pair<Key, Batch>> m_TransparentBatches;
+		size_t m_NumTransparentBatches = 0;
+		Frustum m_Frustum;
+		FrustumCuller m_Culler;
+		OcclusionCuller m_OcclusionCuller;
+		ClusterCuller m_ClusterCuller;
+		DepthSorter m_DepthSorter;
+		RenderQueueStats m_QueueStats;
+		LODStats m_LODStats;
+		Float3 m_CameraOrigin;
+		float m_LODProjScale = 0.0f; /* cot(fov / 2), 0 until a camera is set. */
+		float m_LODThreshold = S_DefaultLODThreshold;
+		std::vector<OcclusionQuery> m_OcclusionQueries;
+		std::vector<uint32_t> m_OcclusionQueryIndices;
+		std::vector<uint8_t> m_OcclusionResults;
+		/* Every material referenced so far, uploaded as a single StructuredBuffer<MaterialData>. */
+		std::vector<Asset::MaterialData> m_MaterialTable;
+		std::vector<Asset::AssetID> m_MaterialIDs; /* Parallel to m_MaterialTable. */
+		std::unordered_map<Asset::AssetID, uint32_t> m_MaterialIndices;
+		std::vector<uint32_t> m_FreeMaterialIndices; /* Of unloaded materials, reused by RegisterMaterial. */
+		/* Every texture referenced so far, packed into a texture array per size. */
+		TextureTable m_TextureTable;
+		std::vector<DrawItem> m_DrawItems;
+		std::vector<CommandList> m_CommandLists; /* Only grows, so every list keeps it's allocations across frames. */
+		std::vector<uint32_t> m_CommandListIndices;
+		CommandListStats m_CommandListStats;
 		Resource<IInputLayout> m_IL_Basic;
+		Resource<IInputLayout> m_IL_Compact;
+		Resource<IInputLayout> m_IL_BasicQuantized;
+		Resource<IInputLayout> m_IL_CompactQuantized;
 		Resource<IBuffer> m_VB_Vertices;
-		Resource<IBuffer> m_VB_Instances;
-		Resource<IBuffer> m_IB_Indices;
-		Resource<IBuffer> m_CB_Material;
+		Resource<IBuffer> m_VB_QuantizedVertices;
+		Resource<IBuffer> m_VB_Instances; /* Only used the frame the upload ring overflows. */
+		Resource<IBuffer> m_IB_Indices16;
+		Resource<IBuffer> m_IB_Indices32;
+		Resource<IBuffer> m_SB_Materials;
+		ShaderID m_VS_Basic;
+		ShaderID m_VS_Compact;
+		ShaderID m_VS_BasicQuantized;
+		ShaderID m_VS_CompactQuantized;
+		ShaderID m_PS_Basic;
+		ShaderID m_PS_Texture;
+		uint32_t m_UnloadSubscription = 0; /* See Asset::AssetManager::SubscribeUnload. */
+		uint32_t m_NumMaterialUploads = 0; /* Since construction. */
+		size_t m_InstanceBytes = 0; /* Uploaded by the last EndBatch. */
+		uint32_t m_InstanceOffsetBytes = 0; /* Into the upload ring. */
+		size_t m_VertexBytes = 0;
+		InstanceFormat m_InstanceFormat = InstanceFormat::Compact;
 		bool m_MeshSubmitted = false;
+		bool m_MaterialTableDirty = false;
+		bool m_InstancesInRing = false;
+		bool m_OcclusionEnabled = true;
+		bool m_ClusterCullingEnabled = true;
+		bool m_LODEnabled = true;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "PCH.hpp"
+#include "CPUFeatures.hpp"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace CMEngine
+{
+	static [[nodiscard]] bool QueryAVX2() noexcept
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		int info[4] = {};
+
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+
+		bool hasFMA = (info[2] & (1 << 12)) != 0;
+		bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+		bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+		if (!hasFMA || !hasOSXSAVE || !hasAVX)
+			return false;
+
+		/* The OS has to save the YMM registers on context switches too, (XCR0 bits 1 and 2) or they can't be used... */
+		if ((_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+		return false;
+#endif
+	}
+
+	[[nodiscard]] bool CPUSupportsAVX2() noexcept
+	{
+		static const bool isSupported = QueryAVX2();
+		return isSupported;
+	}
+}
\ No newline at end of file
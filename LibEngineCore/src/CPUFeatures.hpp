@@ -0,0 +1,8 @@
+#pragma once
+
+namespace CMEngine
+{
+	/* Whether both the CPU and OS support AVX2 and FMA, (queried once) so the AVX2 kernels (see AVX2Kernels.hpp)
+	 *   can be picked at runtime, and the engine still runs on CPUs without them. */
+	[[nodiscard]] bool CPUSupportsAVX2() noexcept;
+}
\ No newline at end of file
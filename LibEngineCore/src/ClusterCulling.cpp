@@ -0,0 +1,211 @@
+#include "PCH.hpp"
+#include "ClusterCulling.hpp"
+#include "CPUFeatures.hpp"
+#include "AVX2Kernels.hpp"
+
+namespace CMEngine::Renderer
+{
+	void ClusterBounds::Build(std::span<const Asset::Meshlet> meshlets) noexcept
+	{
+		size_t padded = ((meshlets.size() + ClusterCuller::S_LaneWidth - 1) / ClusterCuller::S_LaneWidth) * ClusterCuller::S_LaneWidth;
+
+		/* Padded lanes are zero sized at the origin, with a cone that never culls. (Their results are never read) */
+		CenterX.assign(padded, 0.0f);
+		CenterY.assign(padded, 0.0f);
+		CenterZ.assign(padded, 0.0f);
+		Radius.assign(padded, 0.0f);
+		AxisX.assign(padded, 0.0f);
+		AxisY.assign(padded, 0.0f);
+		AxisZ.assign(padded, 0.0f);
+		Cutoff.assign(padded, 1.0f);
+		Ranges.clear();
+		Ranges.reserve(meshlets.size());
+
+		for (size_t i = 0; i < meshlets.size(); ++i)
+		{
+			const Asset::Meshlet& meshlet = meshlets[i];
+
+			CenterX[i] = meshlet.Center.x;
+			CenterY[i] = meshlet.Center.y;
+			CenterZ[i] = meshlet.Center.z;
+			Radius[i] = meshlet.Radius;
+			AxisX[i] = meshlet.ConeAxis.x;
+			AxisY[i] = meshlet.ConeAxis.y;
+			AxisZ[i] = meshlet.ConeAxis.z;
+			Cutoff[i] = meshlet.ConeCutoff;
+
+			Ranges.emplace_back(IndexRange{ meshlet.FirstIndex, meshlet.NumIndices });
+		}
+	}
+
+	void ClusterCuller::SetCamera(const Frustum& frustum, const Float3& cameraPos) noexcept
+	{
+		m_Frustum = frustum;
+		m_CameraPos = cameraPos;
+		m_HasCamera = true;
+	}
+
+	void ClusterCuller::BeginFrame() noexcept
+	{
+		m_Stats = ClusterCullStats();
+	}
+
+	size_t ClusterCuller::Cull(const ClusterBounds& bounds, const Math::Mat4& modelMatrix, std::vector<IndexRange>& outRanges) noexcept
+	{
+		using namespace DirectX;
+
+		size_t count = bounds.Ranges.size();
+		size_t padded = bounds.CenterX.size();
+
+		if (count == 0)
+			return 0;
+
+		++m_Stats.NumInstances;
+		m_Stats.NumTested += (uint32_t)count;
+
+		XMFLOAT4X4 m;
+		XMStoreFloat4x4(&m, modelMatrix);
+
+		/* ModelMatrix is stored transposed, so world = m * p, and a world plane dotted with it
+		 *   is the plane (m^T * plane) dotted with p. The length of it's xyz is how far one unit
+		 *   of object space radius reaches along the world plane's normal. */
+		float planeX[Frustum::S_NumPlanes];
+		float planeY[Frustum::S_NumPlanes];
+		float planeZ[Frustum::S_NumPlanes];
+		float planeW[Frustum::S_NumPlanes];
+		float planeScale[Frustum::S_NumPlanes];
+
+		for (size_t p = 0; p < Frustum::S_NumPlanes; ++p)
+		{
+			const XMFLOAT4& plane = m_Frustum.Planes[p];
+
+			planeX[p] = plane.x * m.m[0][0] + plane.y * m.m[1][0] + plane.z * m.m[2][0];
+			planeY[p] = plane.x * m.m[0][1] + plane.y * m.m[1][1] + plane.z * m.m[2][1];
+			planeZ[p] = plane.x * m.m[0][2] + plane.y * m.m[1][2] + plane.z * m.m[2][2];
+			planeW[p] = plane.x * m.m[0][3] + plane.y * m.m[1][3] + plane.z * m.m[2][3] + plane.w;
+			planeScale[p] = std::sqrt(planeX[p] * planeX[p] + planeY[p] * planeY[p] + planeZ[p] * planeZ[p]);
+		}
+
+		XMVECTOR determinant;
+		XMMATRIX inverse = XMMatrixInverse(&determinant, modelMatrix);
+
+		XMFLOAT4X4 inv;
+		XMStoreFloat4x4(&inv, inverse);
+
+		const float camera[3] = { m_CameraPos.x, m_CameraPos.y, m_CameraPos.z };
+		float eye[3] = {};
+
+		for (size_t row = 0; row < 3; ++row)
+			eye[row] = inv.m[row][0] * camera[0] + inv.m[row][1] * camera[1] + inv.m[row][2] * camera[2] + inv.m[row][3];
+
+		/* A mirroring transform flips the winding, so the cones would be facing the wrong way. */
+		bool coneCulling = XMVectorGetX(determinant) > 0.0f;
+
+		m_Visible.resize(padded);
+
+		uint32_t numFrustumCulled = 0;
+		uint32_t numConeCulled = 0;
+		bool useAVX2 = false;
+
+#if defined(ENGINE_CORE_ENABLE_AVX2)
+		static_assert(S_LaneWidth == AVX2::G_LaneWidth);
+		static_assert(Frustum::S_NumPlanes == AVX2::G_NumFrustumPlanes);
+
+		useAVX2 = CPUSupportsAVX2();
+
+		if (useAVX2)
+		{
+			AVX2::ClusterBoundsArrays arrays;
+			arrays.pCenterX = bounds.CenterX.data();
+			arrays.pCenterY = bounds.CenterY.data();
+			arrays.pCenterZ = bounds.CenterZ.data();
+			arrays.pRadius = bounds.Radius.data();
+			arrays.pAxisX = bounds.AxisX.data();
+			arrays.pAxisY = bounds.AxisY.data();
+			arrays.pAxisZ = bounds.AxisZ.data();
+			arrays.pCutoff = bounds.Cutoff.data();
+
+			AVX2::CullClusters(
+				planeX,
+				planeY,
+				planeZ,
+				planeW,
+				planeScale,
+				eye,
+				coneCulling,
+				arrays,
+				padded,
+				count,
+				m_Visible.data(),
+				numFrustumCulled,
+				numConeCulled
+			);
+		}
+#endif
+
+		if (!useAVX2)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				bool isInside = true;
+
+				for (size_t p = 0; p < Frustum::S_NumPlanes; ++p)
+				{
+					float dist = planeX[p] * bounds.CenterX[i] + planeY[p] * bounds.CenterY[i] + planeZ[p] * bounds.CenterZ[i] + planeW[p];
+
+					if (dist + planeScale[p] * bounds.Radius[i] < 0.0f)
+					{
+						isInside = false;
+						break;
+					}
+				}
+
+				float dx = bounds.CenterX[i] - eye[0];
+				float dy = bounds.CenterY[i] - eye[1];
+				float dz = bounds.CenterZ[i] - eye[2];
+
+				float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+				float facing = dx * bounds.AxisX[i] + dy * bounds.AxisY[i] + dz * bounds.AxisZ[i];
+
+				bool isBackfacing = coneCulling && facing >= bounds.Cutoff[i] * length + bounds.Radius[i];
+
+				m_Visible[i] = (uint8_t)(isInside && !isBackfacing);
+
+				numFrustumCulled += isInside ? 0 : 1;
+				numConeCulled += isInside && isBackfacing ? 1 : 0;
+			}
+		}
+
+		m_Stats.NumFrustumCulled += numFrustumCulled;
+		m_Stats.NumConeCulled += numConeCulled;
+
+		/* Meshlets are consecutive ranges of the mesh's indices, so runs of visible ones collapse into a single draw. */
+		size_t firstOut = outRanges.size();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (!m_Visible[i])
+				continue;
+
+			const IndexRange& range = bounds.Ranges[i];
+
+			if (outRanges.size() > firstOut)
+			{
+				IndexRange& last = outRanges.back();
+
+				if (last.FirstIndex + last.NumIndices == range.FirstIndex)
+				{
+					last.NumIndices += range.NumIndices;
+					continue;
+				}
+			}
+
+			outRanges.emplace_back(range);
+		}
+
+		size_t numAppended = outRanges.size() - firstOut;
+		m_Stats.NumRanges += (uint32_t)numAppended;
+
+		return numAppended;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "PCH.hpp"
+#include "CommandList.hpp"
+
+namespace CMEngine::Renderer
+{
+	void CommandList::Reset() noexcept
+	{
+		m_Commands.clear();
+		m_Data.clear();
+		m_NumDraws = 0;
+	}
+
+	void CommandList::BindVertexBuffer(const Resource<IBuffer>& buffer, uint32_t strideBytes, uint32_t offsetBytes, uint32_t slot) noexcept
+	{
+		Command& command = Push(CommandType::BindVertexBuffer);
+		command.Buffer = { &buffer, strideBytes, offsetBytes, slot };
+	}
+
+	void CommandList::BindIndexBuffer(const Resource<IBuffer>& buffer, DataFormat indexFormat, uint32_t startIndex) noexcept
+	{
+		Command& command = Push(CommandType::BindIndexBuffer);
+		command.IndexBuffer = { &buffer, indexFormat, startIndex };
+	}
+
+	void CommandList::BindInputLayout(const Resource<IInputLayout>& inputLayout) noexcept
+	{
+		Command& command = Push(CommandType::BindInputLayout);
+		command.pInputLayout = &inputLayout;
+	}
+
+	void CommandList::BindShader(ShaderID id) noexcept
+	{
+		Command& command = Push(CommandType::BindShader);
+		command.Shader = { id.Index, id.Type, id.AssignedType };
+	}
+
+	void CommandList::BindTexture(const Resource<ITexture>& texture) noexcept
+	{
+		Command& command = Push(CommandType::BindTexture);
+		command.pTexture = &texture;
+	}
+
+	void CommandList::BindConstantBufferVS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		Command& command = Push(CommandType::BindConstantBufferVS);
+		command.Buffer = { &buffer, 0, 0, slot };
+	}
+
+	void CommandList::BindConstantBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		Command& command = Push(CommandType::BindConstantBufferPS);
+		command.Buffer = { &buffer, 0, 0, slot };
+	}
+
+	void CommandList::BindStructuredBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		Command& command = Push(CommandType::BindStructuredBufferPS);
+		command.Buffer = { &buffer, 0, 0, slot };
+	}
+
+	void CommandList::BindBlendMode(BlendMode mode) noexcept
+	{
+		Command& command = Push(CommandType::BindBlendMode);
+		command.Blend = mode;
+	}
+
+	void CommandList::SetBuffer(const Resource<IBuffer>& buffer, const void* pData, size_t numBytes) noexcept
+	{
+		CM_ENGINE_ASSERT(numBytes <= std::numeric_limits<uint32_t>::max());
+
+		uint32_t dataOffset = (uint32_t)m_Data.size();
+
+		m_Data.resize(m_Data.size() + numBytes);
+		std::memcpy(m_Data.data() + dataOffset, pData, numBytes);
+
+		Command& command = Push(CommandType::SetBuffer);
+		command.Update = { &buffer, dataOffset, (uint32_t)numBytes };
+	}
+
+	void CommandList::Draw(uint32_t numVertices, uint32_t startVertexLocation) noexcept
+	{
+		Command& command = Push(CommandType::Draw);
+		command.Draw = { numVertices, 1, startVertexLocation, 0, 0 };
+
+		++m_NumDraws;
+	}
+
+	void CommandList::DrawIndexed(uint32_t numIndices, uint32_t startIndexLocation, int32_t baseVertexLocation) noexcept
+	{
+		Command& command = Push(CommandType::DrawIndexed);
+		command.Draw = { numIndices, 1, startIndexLocation, baseVertexLocation, 0 };
+
+		++m_NumDraws;
+	}
+
+	void CommandList::DrawIndexedInstanced(
+		uint32_t indicesPerInstance,
+		uint32_t totalInstances,
+		uint32_t startIndexLocation,
+		int32_t baseVertexLocation,
+		uint32_t startInstanceLocation
+	) noexcept
+	{
+		Command& command = Push(CommandType::DrawIndexedInstanced);
+		command.Draw = { indicesPerInstance, totalInstances, startIndexLocation, baseVertexLocation, startInstanceLocation };
+
+		++m_NumDraws;
+	}
+
+	void CommandList::Replay(StateCache& stateCache, IGraphics& graphics) const noexcept
+	{
+		for (const Command& command : m_Commands)
+			switch (command.Type)
+			{
+			case CommandType::BindVertexBuffer:
+				stateCache.BindVertexBuffer(*command.Buffer.pBuffer, command.Buffer.StrideBytes, command.Buffer.OffsetBytes, command.Buffer.Slot);
+				break;
+			case CommandType::BindIndexBuffer:
+				stateCache.BindIndexBuffer(*command.IndexBuffer.pBuffer, command.IndexBuffer.Format, command.IndexBuffer.StartIndex);
+				break;
+			case CommandType::BindInputLayout:
+				stateCache.BindInputLayout(*command.pInputLayout);
+				break;
+			case CommandType::BindShader:
+				stateCache.BindShader(ShaderID(command.Shader.Index, command.Shader.Type, command.Shader.AssignedType));
+				break;
+			case CommandType::BindTexture:
+				stateCache.BindTexture(*command.pTexture);
+				break;
+			case CommandType::BindConstantBufferVS:
+				stateCache.BindConstantBufferVS(*command.Buffer.pBuffer, command.Buffer.Slot);
+				break;
+			case CommandType::BindConstantBufferPS:
+				stateCache.BindConstantBufferPS(*command.Buffer.pBuffer, command.Buffer.Slot);
+				break;
+			case CommandType::BindStructuredBufferPS:
+				stateCache.BindStructuredBufferPS(*command.Buffer.pBuffer, command.Buffer.Slot);
+				break;
+			case CommandType::BindBlendMode:
+				stateCache.BindBlendMode(command.Blend);
+				break;
+			case CommandType::SetBuffer:
+				graphics.SetBuffer(*command.Update.pBuffer, m_Data.data() + command.Update.DataOffset, command.Update.NumBytes);
+				break;
+			case CommandType::Draw:
+				graphics.Draw(command.Draw.NumIndices, command.Draw.StartIndex);
+				break;
+			case CommandType::DrawIndexed:
+				graphics.DrawIndexed(command.Draw.NumIndices, command.Draw.StartIndex, command.Draw.BaseVertex);
+				break;
+			case CommandType::DrawIndexedInstanced:
+				graphics.DrawIndexedInstanced(
+					command.Draw.NumIndices,
+					command.Draw.NumInstances,
+					command.Draw.StartIndex,
+					command.Draw.BaseVertex,
+					command.Draw.StartInstance
+				);
+
+				break;
+			}
+	}
+
+	[[nodiscard]] Command& CommandList::Push(CommandType type) noexcept
+	{
+		Command& command = m_Commands.emplace_back();
+		command.Type = type;
+
+		return command;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Platform/Core/IGraphics.hpp"
+#include "StateCache.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace CMEngine::Renderer
+{
+	enum class CommandType : uint8_t
+	{
+		BindVertexBuffer,
+		BindIndexBuffer,
+		BindInputLayout,
+		BindShader,
+		BindTexture,
+		BindConstantBufferVS,
+		BindConstantBufferPS,
+		BindStructuredBufferPS,
+		BindBlendMode,
+		SetBuffer,
+		Draw,
+		DrawIndexed,
+		DrawIndexedInstanced
+	};
+
+	/* A single recorded command. Resources are referenced rather than owned, (or copied) so anything
+	 *   recorded must outlive the replay. */
+	struct Command
+	{
+		struct BufferBind
+		{
+			const Resource<IBuffer>* pBuffer;
+			uint32_t StrideBytes;
+			uint32_t OffsetBytes;
+			uint32_t Slot;
+		};
+
+		struct IndexBufferBind
+		{
+			const Resource<IBuffer>* pBuffer;
+			DataFormat Format;
+			uint32_t StartIndex;
+		};
+
+		struct ShaderBind
+		{
+			uint32_t Index;
+			ShaderType Type;
+			AssignedShaderType AssignedType;
+		};
+
+		struct BufferUpdate
+		{
+			const Resource<IBuffer>* pBuffer;
+			uint32_t DataOffset; /* Into the list's data. */
+			uint32_t NumBytes;
+		};
+
+		/* Draw and DrawIndexed use the subset they need, with vertices in place of indices for Draw. */
+		struct DrawArgs
+		{
+			uint32_t NumIndices;
+			uint32_t NumInstances;
+			uint32_t StartIndex;
+			int32_t BaseVertex;
+			uint32_t StartInstance;
+		};
+
+		CommandType Type;
+
+		union
+		{
+			BufferBind Buffer; /* Vertex, constant and structured buffer binds. */
+			IndexBufferBind IndexBuffer;
+			const Resource<IInputLayout>* pInputLayout;
+			ShaderBind Shader;
+			const Resource<ITexture>* pTexture;
+			BlendMode Blend;
+			BufferUpdate Update;
+			DrawArgs Draw;
+		};
+	};
+
+	static_assert(std::is_trivially_copyable_v<Command>, "Command must stay POD, as lists are recycled without destruction.");
+	static_assert(sizeof(Command) <= 32, "Command should stay within half a cache line.");
+
+	struct CommandListStats
+	{
+		uint32_t NumLists = 0;
+		uint32_t NumCommands = 0;
+		uint32_t NumDraws = 0;
+		float RecordMillis = 0.0f;
+		float ReplayMillis = 0.0f;
+	};
+
+	/* An API-agnostic stream of binds, buffer updates and draws, mirroring IGraphics.
+	 *
+	 * A list is recorded by a single thread, without touching IGraphics, so separate lists can be recorded
+	 *   in parallel. Lists are then replayed in order on the thread owning IGraphics. Binds are replayed
+	 *   through a StateCache, so each list can bind everything it needs without repeating what the
+	 *   previous list left bound. */
+	class CommandList
+	{
+	public:
+		CommandList() = default;
+		~CommandList() = default;
+	public:
+		/* Removes every command, but keeps the allocations for the next recording. */
+		void Reset() noexcept;
+
+		void BindVertexBuffer(const Resource<IBuffer>& buffer, uint32_t strideBytes, uint32_t offsetBytes, uint32_t slot) noexcept;
+		void BindIndexBuffer(const Resource<IBuffer>& buffer, DataFormat indexFormat, uint32_t startIndex) noexcept;
+		void BindInputLayout(const Resource<IInputLayout>& inputLayout) noexcept;
+		void BindShader(ShaderID id) noexcept;
+		void BindTexture(const Resource<ITexture>& texture) noexcept;
+		void BindConstantBufferVS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept;
+		void BindConstantBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept;
+		void BindStructuredBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept;
+		void BindBlendMode(BlendMode mode) noexcept;
+
+		/* @pData is copied into the list. */
+		void SetBuffer(const Resource<IBuffer>& buffer, const void* pData, size_t numBytes) noexcept;
+
+		void Draw(uint32_t numVertices, uint32_t startVertexLocation) noexcept;
+		void DrawIndexed(uint32_t numIndices, uint32_t startIndexLocation, int32_t baseVertexLocation) noexcept;
+
+		void DrawIndexedInstanced(
+			uint32_t indicesPerInstance,
+			uint32_t totalInstances,
+			uint32_t startIndexLocation,
+			int32_t baseVertexLocation,
+			uint32_t startInstanceLocation
+		) noexcept;
+
+		/* Issues every command in the order they were recorded. */
+		void Replay(StateCache& stateCache, IGraphics& graphics) const noexcept;
+
+		inline [[nodiscard]] size_t NumCommands() const noexcept { return m_Commands.size(); }
+		inline [[nodiscard]] uint32_t NumDraws() const noexcept { return m_NumDraws; }
+		inline [[nodiscard]] bool Empty() const noexcept { return m_Commands.empty(); }
+	private:
+		[[nodiscard]] Command& Push(CommandType type) noexcept;
+	private:
+		std::vector<Command> m_Commands;
+		std::vector<std::byte> m_Data; /* Copied SetBuffer data. */
+		uint32_t m_NumDraws = 0;
+	};
+}
\ No newline at end of file
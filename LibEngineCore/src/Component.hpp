@@ -67,14 +67,13 @@ namespace CMEngine
 
 	struct TextureComponent : public Component
 	{
-		inline TextureComponent(Asset::AssetID id, Resource<ITexture>&& texture) noexcept
+		/* NOTE: The texture itself is owned by the renderer's TextureTable, which creates it on first use. */
+		inline TextureComponent(Asset::AssetID id) noexcept
 			: ID(id)
 		{
-			Texture = std::move(texture);
 		}
 
 		Asset::AssetID ID;
-		Resource<ITexture> Texture;
 	};
 
 	struct MeshComponent : public Component
@@ -87,6 +86,11 @@ namespace CMEngine
 		Asset::AssetID ID;
 	};
 
+	/* Tags an entity's mesh to be rasterized into the CPU occlusion buffer, hiding instances behind it. */
+	struct OccluderComponent : public Component
+	{
+	};
+
 	struct CameraComponent : public Component
 	{
 		inline CameraComponent(const CameraData& data) noexcept
@@ -0,0 +1,206 @@
+#include "PCH.hpp"
+#include "Culling.hpp"
+#include "CPUFeatures.hpp"
+#include "AVX2Kernels.hpp"
+
+namespace CMEngine::Renderer
+{
+	void Frustum::Extract(const CameraMatrices& matrices) noexcept
+	{
+		using namespace DirectX;
+
+		/* CameraMatrices are stored transposed, so Proj^T * View^T = (View * Proj)^T,
+		 *   whose rows are the columns of the row-vector view-projection. (Gribb-Hartmann) */
+		XMMATRIX viewProjT = XMMatrixMultiply(matrices.Proj, matrices.View);
+
+		const XMVECTOR& r0 = viewProjT.r[0];
+		const XMVECTOR& r1 = viewProjT.r[1];
+		const XMVECTOR& r2 = viewProjT.r[2];
+		const XMVECTOR& r3 = viewProjT.r[3];
+
+		const std::array<XMVECTOR, S_NumPlanes> planes = {
+			XMVectorAdd(r3, r0),      /* Left */
+			XMVectorSubtract(r3, r0), /* Right */
+			XMVectorAdd(r3, r1),      /* Bottom */
+			XMVectorSubtract(r3, r1), /* Top */
+			r2,                       /* Near (D3D clip space z is [0, w]) */
+			XMVectorSubtract(r3, r2)  /* Far */
+		};
+
+		for (size_t i = 0; i < S_NumPlanes; ++i)
+			XMStoreFloat4(&Planes[i], XMPlaneNormalize(planes[i]));
+	}
+
+	void FrustumCuller::SetFrustum(const Frustum& frustum) noexcept
+	{
+		m_Frustum = frustum;
+		m_HasFrustum = true;
+	}
+
+	void FrustumCuller::Clear() noexcept
+	{
+		m_CenterX.clear();
+		m_CenterY.clear();
+		m_CenterZ.clear();
+		m_ExtentX.clear();
+		m_ExtentY.clear();
+		m_ExtentZ.clear();
+		m_Radius.clear();
+		m_Visible.clear();
+
+		m_Count = 0;
+		m_NumVisible = 0;
+	}
+
+	void FrustumCuller::Reserve(size_t numInstances) noexcept
+	{
+		size_t padded = numInstances + S_LaneWidth;
+
+		m_CenterX.reserve(padded);
+		m_CenterY.reserve(padded);
+		m_CenterZ.reserve(padded);
+		m_ExtentX.reserve(padded);
+		m_ExtentY.reserve(padded);
+		m_ExtentZ.reserve(padded);
+		m_Radius.reserve(padded);
+		m_Visible.reserve(padded);
+	}
+
+	size_t FrustumCuller::Push(const Asset::MeshBounds& bounds, const Math::Mat4& modelMatrix) noexcept
+	{
+		DirectX::XMFLOAT4X4 m;
+		DirectX::XMStoreFloat4x4(&m, modelMatrix);
+
+		/* ModelMatrix is stored transposed, so each row holds a world axis with it's translation in w. */
+		const float center[3] = { bounds.Center.x, bounds.Center.y, bounds.Center.z };
+		const float extents[3] = { bounds.Extents.x, bounds.Extents.y, bounds.Extents.z };
+
+		float worldCenter[3] = {};
+		float worldExtents[3] = {};
+
+		for (size_t row = 0; row < 3; ++row)
+		{
+			worldCenter[row] = m.m[row][3];
+
+			for (size_t col = 0; col < 3; ++col)
+			{
+				worldCenter[row] += m.m[row][col] * center[col];
+				worldExtents[row] += std::abs(m.m[row][col]) * extents[col];
+			}
+		}
+
+		/* The sphere is scaled by the largest axis scale, so it stays conservative under non-uniform scaling. */
+		float maxScaleSq = 0.0f;
+		for (size_t col = 0; col < 3; ++col)
+		{
+			float scaleSq = m.m[0][col] * m.m[0][col] +
+				m.m[1][col] * m.m[1][col] +
+				m.m[2][col] * m.m[2][col];
+
+			maxScaleSq = std::max(maxScaleSq, scaleSq);
+		}
+
+		m_CenterX.emplace_back(worldCenter[0]);
+		m_CenterY.emplace_back(worldCenter[1]);
+		m_CenterZ.emplace_back(worldCenter[2]);
+		m_ExtentX.emplace_back(worldExtents[0]);
+		m_ExtentY.emplace_back(worldExtents[1]);
+		m_ExtentZ.emplace_back(worldExtents[2]);
+		m_Radius.emplace_back(bounds.Radius * std::sqrt(maxScaleSq));
+
+		return m_Count++;
+	}
+
+	void FrustumCuller::Cull() noexcept
+	{
+		if (!m_HasFrustum)
+		{
+			m_Visible.assign(m_Count, 1);
+			m_NumVisible = m_Count;
+			return;
+		}
+
+		/* Pad every stream so the last lane group can be loaded without bounds checks.
+		 *   (Padded lanes are zero sized at the origin, their results are never read) */
+		size_t padded = ((m_Count + S_LaneWidth - 1) / S_LaneWidth) * S_LaneWidth;
+
+		m_CenterX.resize(padded);
+		m_CenterY.resize(padded);
+		m_CenterZ.resize(padded);
+		m_ExtentX.resize(padded);
+		m_ExtentY.resize(padded);
+		m_ExtentZ.resize(padded);
+		m_Radius.resize(padded);
+		m_Visible.resize(padded);
+
+		size_t numChunks = (padded + S_ChunkSize - 1) / S_ChunkSize;
+
+		if (numChunks <= 1)
+			CullRange(0, padded);
+		else
+		{
+			m_Chunks.resize(numChunks);
+			std::iota(m_Chunks.begin(), m_Chunks.end(), 0u);
+
+			std::for_each(
+				std::execution::par,
+				m_Chunks.begin(),
+				m_Chunks.end(),
+				[this, padded](uint32_t chunk)
+				{
+					size_t first = (size_t)chunk * S_ChunkSize;
+					CullRange(first, std::min(first + S_ChunkSize, padded));
+				}
+			);
+		}
+
+		m_NumVisible = (size_t)std::count(m_Visible.begin(), m_Visible.begin() + m_Count, (uint8_t)1);
+	}
+
+	void FrustumCuller::CullRange(size_t first, size_t last) noexcept
+	{
+#if defined(ENGINE_CORE_ENABLE_AVX2)
+		static_assert(S_LaneWidth == AVX2::G_LaneWidth);
+		static_assert(Frustum::S_NumPlanes == AVX2::G_NumFrustumPlanes);
+		static_assert(sizeof(DirectX::XMFLOAT4) == sizeof(float) * 4, "AVX2::CullFrustum reads the planes as packed floats.");
+
+		if (CPUSupportsAVX2())
+		{
+			AVX2::CullFrustum(
+				&m_Frustum.Planes[0].x,
+				m_CenterX.data(),
+				m_CenterY.data(),
+				m_CenterZ.data(),
+				m_ExtentX.data(),
+				m_ExtentY.data(),
+				m_ExtentZ.data(),
+				m_Radius.data(),
+				first,
+				last,
+				m_Visible.data()
+			);
+
+			return;
+		}
+#endif
+
+		for (size_t i = first; i < last; ++i)
+		{
+			bool inside = true;
+
+			for (const DirectX::XMFLOAT4& plane : m_Frustum.Planes)
+			{
+				float dist = plane.x * m_CenterX[i] + plane.y * m_CenterY[i] + plane.z * m_CenterZ[i] + plane.w;
+				float boxRadius = std::abs(plane.x) * m_ExtentX[i] + std::abs(plane.y) * m_ExtentY[i] + std::abs(plane.z) * m_ExtentZ[i];
+
+				if (dist + std::min(boxRadius, m_Radius[i]) < 0.0f)
+				{
+					inside = false;
+					break;
+				}
+			}
+
+			m_Visible[i] = (uint8_t)inside;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+#include "Component.hpp"
+#include "Math.hpp"
+
+#include <cstdint>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace CMEngine::Renderer
+{
+	/* Six world-space planes extracted from a camera's view-projection.
+	 *
+	 * Each plane is stored as (a, b, c, d), with the normal (a, b, c) pointing
+	 *   into the frustum, so a point p is inside a plane if dot(n, p) + d >= 0. */
+	struct Frustum
+	{
+		static constexpr size_t S_NumPlanes = 6;
+
+		Frustum() = default;
+		~Frustum() = default;
+
+		/* NOTE: Expects the matrices as stored in CameraMatrices, (transposed for HLSL) */
+		void Extract(const CameraMatrices& matrices) noexcept;
+
+		std::array<DirectX::XMFLOAT4, S_NumPlanes> Planes = {};
+	};
+
+	/* Tests world-space bounds of submitted instances against a Frustum.
+	 *
+	 * Bounds are stored as SoA, padded to a multiple of S_LaneWidth, so CPUs with AVX2
+	 *   can test 8 spheres/AABB's per plane at once. Chunks of S_ChunkSize instances
+	 *   are distributed across threads with std::execution::par. */
+	class FrustumCuller
+	{
+	public:
+		FrustumCuller() = default;
+		~FrustumCuller() = default;
+	public:
+		void SetFrustum(const Frustum& frustum) noexcept;
+
+		/* Removes all previously pushed bounds. */
+		void Clear() noexcept;
+		void Reserve(size_t numInstances) noexcept;
+
+		/* Transforms the object-space bounds by modelMatrix (as stored in TransformComponent),
+		 *   and appends the result. Returns the index to query with IsVisible after Cull. */
+		size_t Push(const Asset::MeshBounds& bounds, const Math::Mat4& modelMatrix) noexcept;
+
+		void Cull() noexcept;
+
+		inline [[nodiscard]] bool IsVisible(size_t index) const noexcept { return m_Visible[index] != 0; }
+
+		/* World-space centers of every pushed bounds, in push order. */
+		inline [[nodiscard]] std::span<const float> CenterX() const noexcept { return std::span<const float>(m_CenterX.data(), m_Count); }
+		inline [[nodiscard]] std::span<const float> CenterY() const noexcept { return std::span<const float>(m_CenterY.data(), m_Count); }
+		inline [[nodiscard]] std::span<const float> CenterZ() const noexcept { return std::span<const float>(m_CenterZ.data(), m_Count); }
+		inline [[nodiscard]] size_t Count() const noexcept { return m_Count; }
+		inline [[nodiscard]] size_t NumVisible() const noexcept { return m_NumVisible; }
+		inline [[nodiscard]] bool HasFrustum() const noexcept { return m_HasFrustum; }
+	private:
+		void CullRange(size_t first, size_t last) noexcept;
+	private:
+		static constexpr size_t S_LaneWidth = 8;
+		static constexpr size_t S_ChunkSize = 1024; /* Must be a multiple of S_LaneWidth. */
+		Frustum m_Frustum;
+		std::vector<float> m_CenterX;
+		std::vector<float> m_CenterY;
+		std::vector<float> m_CenterZ;
+		std::vector<float> m_ExtentX;
+		std::vector<float> m_ExtentY;
+		std::vector<float> m_ExtentZ;
+		std::vector<float> m_Radius;
+		std::vector<uint8_t> m_Visible;
+		std::vector<uint32_t> m_Chunks;
+		size_t m_Count = 0;
+		size_t m_NumVisible = 0;
+		bool m_HasFrustum = false;
+	};
+}
\ No newline at end of file
@@ -17,5 +17,8 @@ namespace CMEngine
 	void EngineCore::Update() noexcept
 	{
 		m_Platform.Update();
+
+		/* Finished asynchronous loads are only registered here, so their callbacks run at a known point of the frame. */
+		m_AssetManager.Update();
 	}
 }
\ No newline at end of file
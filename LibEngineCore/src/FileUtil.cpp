@@ -0,0 +1,73 @@
+#include "PCH.hpp"
+#include "FileUtil.hpp"
+#include "Log.hpp"
+
+namespace CMEngine
+{
+	[[nodiscard]] bool WriteFileReplacing(
+		const std::filesystem::path& path,
+		const std::function<bool(std::ofstream& stream)>& write
+	) noexcept
+	{
+		/* Thread IDs are unique system wide while the thread lives, so this also holds across processes... */
+		std::filesystem::path tempPath = path;
+		tempPath += std::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+		std::error_code error;
+		bool isWritten = false;
+
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+
+			if (!stream.is_open())
+			{
+				CM_ENGINE_LOG_WARN(
+					"(FileUtil) Internal warning: Failed to open temporary file for writing. Path: {}",
+					tempPath.generic_string()
+				);
+
+				return false;
+			}
+
+			isWritten = write(stream) && stream.flush();
+		}
+
+		if (!isWritten)
+		{
+			CM_ENGINE_LOG_WARN(
+				"(FileUtil) Internal warning: Failed to write file. Path: {}",
+				path.generic_string()
+			);
+
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		std::filesystem::rename(tempPath, path, error);
+
+		if (error)
+		{
+			CM_ENGINE_LOG_WARN(
+				"(FileUtil) Internal warning: Failed to replace file. Path: {}, Error: {}",
+				path.generic_string(), error.message()
+			);
+
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	[[nodiscard]] bool WriteFileReplacing(const std::filesystem::path& path, std::span<const std::byte> bytes) noexcept
+	{
+		return WriteFileReplacing(
+			path,
+			[&](std::ofstream& stream)
+			{
+				stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+				return static_cast<bool>(stream);
+			}
+		);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+
+namespace CMEngine
+{
+	/* Writes @path through a temporary file beside it, which only replaces @path once @write returns true,
+	 *   so readers (and anything interrupted mid write) never see a partial file. The temporary file is
+	 *   unique per thread, so concurrent writers of the same path can't clobber each other's, and is
+	 *   removed on any failure. Warns about, and returns false on, any failure other than @write's own. */
+	[[nodiscard]] bool WriteFileReplacing(
+		const std::filesystem::path& path,
+		const std::function<bool(std::ofstream& stream)>& write
+	) noexcept;
+
+	[[nodiscard]] bool WriteFileReplacing(const std::filesystem::path& path, std::span<const std::byte> bytes) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "PCH.hpp"
+#include "Hash.hpp"
+
+#include <bit>
+
+namespace CMEngine
+{
+	inline constexpr uint64_t G_Prime1 = 0x9E3779B185EBCA87ull;
+	inline constexpr uint64_t G_Prime2 = 0xC2B2AE3D27D4EB4Full;
+	inline constexpr uint64_t G_Prime3 = 0x165667B19E3779F9ull;
+	inline constexpr uint64_t G_Prime4 = 0x85EBCA77C2B2AE63ull;
+	inline constexpr uint64_t G_Prime5 = 0x27D4EB2F165667C5ull;
+
+	static [[nodiscard]] uint64_t Read64(const std::byte* pBytes) noexcept
+	{
+		uint64_t value;
+		std::memcpy(&value, pBytes, sizeof(value));
+		return value;
+	}
+
+	static [[nodiscard]] uint32_t Read32(const std::byte* pBytes) noexcept
+	{
+		uint32_t value;
+		std::memcpy(&value, pBytes, sizeof(value));
+		return value;
+	}
+
+	static [[nodiscard]] uint64_t Round(uint64_t lane, uint64_t input) noexcept
+	{
+		lane += input * G_Prime2;
+		lane = std::rotl(lane, 31);
+		return lane * G_Prime1;
+	}
+
+	static [[nodiscard]] uint64_t MergeRound(uint64_t hash, uint64_t lane) noexcept
+	{
+		hash ^= Round(0, lane);
+		return hash * G_Prime1 + G_Prime4;
+	}
+
+	XXHash64::XXHash64(uint64_t seed) noexcept
+	{
+		Reset(seed);
+	}
+
+	void XXHash64::Reset(uint64_t seed) noexcept
+	{
+		m_Lanes[0] = seed + G_Prime1 + G_Prime2;
+		m_Lanes[1] = seed + G_Prime2;
+		m_Lanes[2] = seed;
+		m_Lanes[3] = seed - G_Prime1;
+		m_Seed = seed;
+		m_TotalBytes = 0;
+		m_BufferedBytes = 0;
+	}
+
+	void XXHash64::Update(std::span<const std::byte> bytes) noexcept
+	{
+		const std::byte* pBytes = bytes.data();
+		const std::byte* pEnd = pBytes + bytes.size();
+
+		m_TotalBytes += bytes.size();
+
+		/* Still not a full stripe... */
+		if (m_BufferedBytes + bytes.size() < S_StripeBytes)
+		{
+			if (!bytes.empty())
+				std::memcpy(m_Buffer + m_BufferedBytes, pBytes, bytes.size());
+
+			m_BufferedBytes += bytes.size();
+			return;
+		}
+
+		if (m_BufferedBytes != 0)
+		{
+			size_t fillBytes = S_StripeBytes - m_BufferedBytes;
+			std::memcpy(m_Buffer + m_BufferedBytes, pBytes, fillBytes);
+			pBytes += fillBytes;
+
+			for (size_t i = 0; i < 4; ++i)
+				m_Lanes[i] = Round(m_Lanes[i], Read64(m_Buffer + i * 8));
+
+			m_BufferedBytes = 0;
+		}
+
+		for (; pEnd - pBytes >= static_cast<ptrdiff_t>(S_StripeBytes); pBytes += S_StripeBytes)
+			for (size_t i = 0; i < 4; ++i)
+				m_Lanes[i] = Round(m_Lanes[i], Read64(pBytes + i * 8));
+
+		m_BufferedBytes = static_cast<size_t>(pEnd - pBytes);
+
+		if (m_BufferedBytes != 0)
+			std::memcpy(m_Buffer, pBytes, m_BufferedBytes);
+	}
+
+	[[nodiscard]] uint64_t XXHash64::Digest() const noexcept
+	{
+		uint64_t hash = 0;
+
+		if (m_TotalBytes >= S_StripeBytes)
+		{
+			hash = std::rotl(m_Lanes[0], 1) + std::rotl(m_Lanes[1], 7) +
+				std::rotl(m_Lanes[2], 12) + std::rotl(m_Lanes[3], 18);
+
+			for (size_t i = 0; i < 4; ++i)
+				hash = MergeRound(hash, m_Lanes[i]);
+		}
+		else
+			hash = m_Seed + G_Prime5;
+
+		hash += m_TotalBytes;
+
+		const std::byte* pBytes = m_Buffer;
+		const std::byte* pEnd = m_Buffer + m_BufferedBytes;
+
+		for (; pEnd - pBytes >= 8; pBytes += 8)
+		{
+			hash ^= Round(0, Read64(pBytes));
+			hash = std::rotl(hash, 27) * G_Prime1 + G_Prime4;
+		}
+
+		if (pEnd - pBytes >= 4)
+		{
+			hash ^= static_cast<uint64_t>(Read32(pBytes)) * G_Prime1;
+			hash = std::rotl(hash, 23) * G_Prime2 + G_Prime3;
+			pBytes += 4;
+		}
+
+		for (; pBytes < pEnd; ++pBytes)
+		{
+			hash ^= static_cast<uint64_t>(*pBytes) * G_Prime5;
+			hash = std::rotl(hash, 11) * G_Prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= G_Prime2;
+		hash ^= hash >> 29;
+		hash *= G_Prime3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+
+	[[nodiscard]] uint64_t XXHash64::Hash(std::span<const std::byte> bytes, uint64_t seed) noexcept
+	{
+		XXHash64 hasher(seed);
+		hasher.Update(bytes);
+
+		return hasher.Digest();
+	}
+}
\ No newline at end of file
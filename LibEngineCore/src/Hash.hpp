@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace CMEngine
+{
+	/* Streaming XXH64, (same output as the reference xxHash implementation) so large
+	 *   inputs can be hashed in pieces as they're read, without being held in memory at once. */
+	class XXHash64
+	{
+	public:
+		XXHash64(uint64_t seed = 0) noexcept;
+		~XXHash64() = default;
+	public:
+		void Reset(uint64_t seed = 0) noexcept;
+		void Update(std::span<const std::byte> bytes) noexcept;
+
+		/* Doesn't modify the state, so more bytes can still be appended after. */
+		[[nodiscard]] uint64_t Digest() const noexcept;
+
+		static [[nodiscard]] uint64_t Hash(std::span<const std::byte> bytes, uint64_t seed = 0) noexcept;
+	private:
+		static constexpr size_t S_StripeBytes = 32;
+		uint64_t m_Lanes[4] = {};
+		uint64_t m_Seed = 0;
+		uint64_t m_TotalBytes = 0;
+		std::byte m_Buffer[S_StripeBytes] = {}; /* Bytes not yet making up a full stripe. */
+		size_t m_BufferedBytes = 0;
+	};
+}
\ No newline at end of file
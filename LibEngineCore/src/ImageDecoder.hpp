@@ -0,0 +1,14 @@
+#pragma once
+
+#ifdef ENGINE_CORE_PLATFORM_WINIMPL
+	#include "Platform/WinImpl/ImageDecoder_WinImpl.hpp"
+#else
+	#error Failed to include proper ImageDecoder implementation.
+#endif
+
+namespace CMEngine
+{
+#ifdef ENGINE_CORE_PLATFORM_WINIMPL
+	using AImageDecoder = Platform::WinImpl::ImageDecoder;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "PCH.hpp"
+#include "LZ4.hpp"
+
+namespace CMEngine::LZ4
+{
+	inline constexpr size_t G_MinMatch = 4;
+	inline constexpr size_t G_LastLiterals = 5; /* A block always ends with at least this many literals... */
+	inline constexpr size_t G_MatchFindLimit = 12; /* ...and it's last match starts at least this far from the end. */
+	inline constexpr size_t G_MaxOffset = 65535;
+	inline constexpr uint32_t G_HashLog = 12;
+	inline constexpr size_t G_SkipTrigger = 6; /* Steps faster over input that isn't matching. */
+	inline constexpr size_t G_WildCopyBytes = 16; /* Short copies are done as whole chunks of this, where there's room to overrun. */
+
+	static [[nodiscard]] uint32_t Read32(const std::byte* pBytes) noexcept
+	{
+		uint32_t value;
+		std::memcpy(&value, pBytes, sizeof(value));
+		return value;
+	}
+
+	static [[nodiscard]] uint32_t HashSequence(uint32_t sequence) noexcept
+	{
+		return (sequence * 2654435761u) >> (32 - G_HashLog);
+	}
+
+	/* Writes the remainder of a length past it's token's 4 bits, as a run of 255's and a final byte. */
+	static [[nodiscard]] std::byte* WriteLength(std::byte* pDst, size_t length) noexcept
+	{
+		for (; length >= 255; length -= 255)
+			*pDst++ = std::byte{ 255 };
+
+		*pDst++ = static_cast<std::byte>(length);
+		return pDst;
+	}
+
+	static [[nodiscard]] std::byte* WriteLiterals(std::byte* pDst, std::byte* pToken, const std::byte* pLiterals, size_t numLiterals) noexcept
+	{
+		if (numLiterals >= 15)
+		{
+			*pToken = std::byte{ 15 << 4 };
+			pDst = WriteLength(pDst, numLiterals - 15);
+		}
+		else
+			*pToken = static_cast<std::byte>(numLiterals << 4);
+
+		if (numLiterals != 0)
+			std::memcpy(pDst, pLiterals, numLiterals);
+
+		return pDst + numLiterals;
+	}
+
+	[[nodiscard]] size_t Compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept
+	{
+		if (dst.size() < CompressBound(src.size()))
+			return 0;
+
+		const std::byte* pSrc = src.data();
+		std::byte* pDst = dst.data();
+		size_t numBytes = src.size();
+		size_t anchor = 0;
+
+		if (numBytes > G_MatchFindLimit)
+		{
+			/* Positions are stored + 1, so 0 is empty. */
+			std::vector<uint32_t> table(size_t(1) << G_HashLog, 0);
+
+			size_t matchLimit = numBytes - G_LastLiterals;
+			size_t findLimit = numBytes - G_MatchFindLimit;
+			size_t position = 0;
+			size_t numMisses = 0;
+
+			while (position < findLimit)
+			{
+				uint32_t sequence = Read32(pSrc + position);
+				uint32_t& slot = table[HashSequence(sequence)];
+				size_t candidate = slot;
+				slot = static_cast<uint32_t>(position + 1);
+
+				if (candidate == 0 ||
+					position - (candidate - 1) > G_MaxOffset ||
+					Read32(pSrc + candidate - 1) != sequence)
+				{
+					position += 1 + (numMisses++ >> G_SkipTrigger);
+					continue;
+				}
+
+				size_t match = candidate - 1;
+				numMisses = 0;
+
+				/* Extend backwards over anything the previous literals already matched... */
+				while (position > anchor && match > 0 && pSrc[position - 1] == pSrc[match - 1])
+				{
+					--position;
+					--match;
+				}
+
+				size_t matchLength = G_MinMatch;
+
+				while (position + matchLength < matchLimit && pSrc[position + matchLength] == pSrc[match + matchLength])
+					++matchLength;
+
+				std::byte* pToken = pDst++;
+				pDst = WriteLiterals(pDst, pToken, pSrc + anchor, position - anchor);
+
+				size_t offset = position - match;
+				*pDst++ = static_cast<std::byte>(offset & 0xFF);
+				*pDst++ = static_cast<std::byte>(offset >> 8);
+
+				size_t extraLength = matchLength - G_MinMatch;
+
+				if (extraLength >= 15)
+				{
+					*pToken |= std::byte{ 15 };
+					pDst = WriteLength(pDst, extraLength - 15);
+				}
+				else
+					*pToken |= static_cast<std::byte>(extraLength);
+
+				position += matchLength;
+				anchor = position;
+
+				/* Also remember a position inside the match, which helps with repeating data. */
+				if (position - 2 + sizeof(uint32_t) <= numBytes)
+					table[HashSequence(Read32(pSrc + position - 2))] = static_cast<uint32_t>(position - 2 + 1);
+			}
+		}
+
+		std::byte* pToken = pDst++;
+		pDst = WriteLiterals(pDst, pToken, pSrc + anchor, numBytes - anchor);
+
+		return static_cast<size_t>(pDst - dst.data());
+	}
+
+	/* Returns false if the length runs past @src, or past @maxLength. */
+	static [[nodiscard]] bool ReadLength(std::span<const std::byte> src, size_t& position, size_t maxLength, size_t& length) noexcept
+	{
+		while (true)
+		{
+			if (position >= src.size())
+				return false;
+
+			size_t next = static_cast<size_t>(src[position++]);
+			length += next;
+
+			if (length > maxLength)
+				return false;
+			else if (next != 255)
+				return true;
+		}
+	}
+
+	[[nodiscard]] bool Decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept
+	{
+		size_t srcPosition = 0;
+		size_t dstPosition = 0;
+
+		while (true)
+		{
+			if (srcPosition >= src.size())
+				return false;
+
+			uint8_t token = static_cast<uint8_t>(src[srcPosition++]);
+			size_t numLiterals = token >> 4;
+
+			if (numLiterals == 15 && !ReadLength(src, srcPosition, dst.size(), numLiterals))
+				return false;
+
+			if (numLiterals > src.size() - srcPosition || numLiterals > dst.size() - dstPosition)
+				return false;
+
+			/* Most literal runs are short, so are copied as one chunk where both sides have room for it... */
+			if (numLiterals <= G_WildCopyBytes &&
+				src.size() - srcPosition >= G_WildCopyBytes &&
+				dst.size() - dstPosition >= G_WildCopyBytes)
+				std::memcpy(dst.data() + dstPosition, src.data() + srcPosition, G_WildCopyBytes);
+			else if (numLiterals != 0)
+				std::memcpy(dst.data() + dstPosition, src.data() + srcPosition, numLiterals);
+
+			srcPosition += numLiterals;
+			dstPosition += numLiterals;
+
+			/* The last sequence is only literals... */
+			if (srcPosition == src.size())
+				return dstPosition == dst.size();
+
+			if (src.size() - srcPosition < 2)
+				return false;
+
+			size_t offset = static_cast<size_t>(src[srcPosition]) | (static_cast<size_t>(src[srcPosition + 1]) << 8);
+			srcPosition += 2;
+
+			if (offset == 0 || offset > dstPosition)
+				return false;
+
+			size_t matchLength = token & 15;
+
+			if (matchLength == 15 && !ReadLength(src, srcPosition, dst.size(), matchLength))
+				return false;
+
+			matchLength += G_MinMatch;
+
+			if (matchLength > dst.size() - dstPosition)
+				return false;
+
+			std::byte* pOut = dst.data() + dstPosition;
+			const std::byte* pMatch = pOut - offset;
+
+			/* Overlapping matches repeat the bytes they've just written, so are copied forwards in chunks no larger than
+			 *   the offset. Chunks may overrun the match, which is fine as long as there's room, as it's overwritten after. */
+			size_t room = dst.size() - dstPosition;
+
+			if (offset >= G_WildCopyBytes && matchLength + G_WildCopyBytes <= room)
+				for (size_t i = 0; i < matchLength; i += G_WildCopyBytes)
+					std::memcpy(pOut + i, pMatch + i, G_WildCopyBytes);
+			else if (offset >= 8 && matchLength + 8 <= room)
+				for (size_t i = 0; i < matchLength; i += 8)
+					std::memcpy(pOut + i, pMatch + i, 8);
+			else if (offset >= matchLength)
+				std::memcpy(pOut, pMatch, matchLength);
+			else
+				for (size_t i = 0; i < matchLength; ++i)
+					pOut[i] = pMatch[i];
+
+			dstPosition += matchLength;
+		}
+	}
+}
\ No newline at end of file
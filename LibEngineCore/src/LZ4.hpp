@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace CMEngine::LZ4
+{
+	/* The LZ4 block format, (readable by the reference implementation's LZ4_decompress_safe) without
+	 *   the frame format around it, so the uncompressed size has to be stored alongside.
+	 *
+	 * Decompression is in the order of GB/s, so compressed data is usually faster to load than to read
+	 *   from disk uncompressed, and is bounds checked throughout, so corrupt input fails rather than overruns. */
+
+	/* The most @srcBytes can compress to, (i.e. for incompressible input) */
+	inline constexpr [[nodiscard]] size_t CompressBound(size_t srcBytes) noexcept
+	{
+		return srcBytes + srcBytes / 255 + 16;
+	}
+
+	/* Returns the compressed size, or 0 if @dst is smaller than CompressBound(@src.size()) */
+	[[nodiscard]] size_t Compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept;
+
+	/* Returns false if @src is corrupt, or doesn't decompress to exactly @dst.size() bytes. */
+	[[nodiscard]] bool Decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept;
+}
\ No newline at end of file
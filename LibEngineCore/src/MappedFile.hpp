@@ -0,0 +1,14 @@
+#pragma once
+
+#ifdef ENGINE_CORE_PLATFORM_WINIMPL
+	#include "Platform/WinImpl/MappedFile_WinImpl.hpp"
+#else
+	#error Failed to include proper MappedFile implementation.
+#endif
+
+namespace CMEngine
+{
+#ifdef ENGINE_CORE_PLATFORM_WINIMPL
+	using AMappedFile = Platform::WinImpl::MappedFile;
+#endif
+}
\ No newline at end of file
@@ -42,6 +42,16 @@ namespace CMEngine::Math
 		return DirectX::XMMatrixIdentity();
 	}
 
+	[[nodiscard]] Mat3x4 ToMat3x4(const Mat4& transposed) noexcept
+	{
+		Mat3x4 out;
+
+		for (size_t row = 0; row < 3; ++row)
+			DirectX::XMStoreFloat4(&out.Rows[row], transposed.r[row]);
+
+		return out;
+	}
+
 	void ViewMatrixLookAtLH(
 		Mat4& outMatrix,
 		const Float3& origin,
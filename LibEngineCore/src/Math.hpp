@@ -8,6 +8,13 @@ namespace CMEngine::Math
 {
 	using Mat4 = DirectX::XMMATRIX;
 
+	/* A 3x4 affine matrix, laid out as the first three rows of a transposed Mat4.
+	 *   (i.e. each row holds a world axis with it's translation in w, the fourth row is implicitly (0, 0, 0, 1)) */
+	struct Mat3x4
+	{
+		DirectX::XMFLOAT4 Rows[3] = {};
+	};
+
 	inline constexpr [[nodiscard]] float AngleToRadians(float angle) noexcept;
 
 	inline constexpr [[nodiscard]] DirectX::XMFLOAT3 ToXMFloat3(Float2 float2, float z = 0.0f) noexcept;
@@ -26,6 +33,9 @@ namespace CMEngine::Math
 
 	[[nodiscard]] Mat4 IdentityMatrix() noexcept;
 
+	/* Drops the last row of a transposed affine Mat4, (as stored in TransformComponent) */
+	[[nodiscard]] Mat3x4 ToMat3x4(const Mat4& transposed) noexcept;
+
 	void ViewMatrixLookAtLH(
 		Mat4& outMatrix,
 		const Float3& origin,
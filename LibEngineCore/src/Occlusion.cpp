@@ -0,0 +1,366 @@
+#include "PCH.hpp"
+#include "Occlusion.hpp"
+#include "CPUFeatures.hpp"
+#include "AVX2Kernels.hpp"
+
+namespace CMEngine::Renderer
+{
+	OcclusionCuller::OcclusionCuller() noexcept
+	{
+		uint32_t width = S_Width;
+		uint32_t height = S_Height;
+
+		/* Level 0 is the full resolution depth buffer, every level after is the max of a 2x2 footprint. */
+		for (;;)
+		{
+			DepthMip& mip = m_Mips.emplace_back();
+			mip.Width = width;
+			mip.Height = height;
+			mip.Depth.resize((size_t)width * height, 1.0f);
+
+			if (width == 1 && height == 1)
+				break;
+
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+		}
+
+		m_Bands.resize(S_NumBands);
+		std::iota(m_Bands.begin(), m_Bands.end(), 0u);
+	}
+
+	void OcclusionCuller::SetCamera(const CameraMatrices& matrices) noexcept
+	{
+		/* CameraMatrices are stored transposed, Proj^T * View^T = (View * Proj)^T... */
+		DirectX::XMMATRIX viewProj = DirectX::XMMatrixTranspose(
+			DirectX::XMMatrixMultiply(matrices.Proj, matrices.View)
+		);
+
+		DirectX::XMStoreFloat4x4(&m_ViewProj, viewProj);
+		m_HasCamera = true;
+	}
+
+	void OcclusionCuller::BeginFrame() noexcept
+	{
+		m_Triangles.clear();
+		m_Stats = OcclusionStats();
+	}
+
+	void OcclusionCuller::AddOccluder(const Asset::MeshData& data, const Math::Mat4& modelMatrix) noexcept
+	{
+		using namespace DirectX;
+
+		if (!m_HasCamera || data.Indices.size() < 3)
+			return;
+
+		/* ModelMatrix is stored transposed, so transpose back to the row-vector convention of m_ViewProj. */
+		XMMATRIX modelViewProj = XMMatrixMultiply(XMMatrixTranspose(modelMatrix), XMLoadFloat4x4(&m_ViewProj));
+
+		++m_Stats.NumOccluders;
+
+		for (size_t i = 0; i + 2 < data.Indices.size(); i += 3)
+		{
+			float x[3], y[3], z[3];
+			bool crossesNear = false;
+
+			for (size_t v = 0; v < 3; ++v)
+			{
+				const Float3& pos = data.Vertices[data.Indices[i + v]].Pos;
+				XMFLOAT4 clip;
+				XMStoreFloat4(&clip, XMVector3Transform(XMVectorSet(pos.x, pos.y, pos.z, 1.0f), modelViewProj));
+
+				/* Clipping isn't worth it for occluders, dropping the triangle is still conservative. */
+				if (clip.w < S_NearW || clip.z < 0.0f)
+				{
+					crossesNear = true;
+					break;
+				}
+
+				float invW = 1.0f / clip.w;
+				x[v] = (clip.x * invW * 0.5f + 0.5f) * (float)S_Width;
+				y[v] = (0.5f - clip.y * invW * 0.5f) * (float)S_Height;
+				z[v] = clip.z * invW;
+			}
+
+			if (crossesNear)
+				continue;
+
+			float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+
+			/* Occluders are closed meshes, so either winding is fine. Orient so the inside of every edge is positive. */
+			if (area < 0.0f)
+			{
+				std::swap(x[1], x[2]);
+				std::swap(y[1], y[2]);
+				std::swap(z[1], z[2]);
+				area = -area;
+			}
+
+			if (area < 1e-6f)
+				continue;
+
+			ScreenTriangle tri = {};
+
+			float minX = std::min({ x[0], x[1], x[2] });
+			float maxX = std::max({ x[0], x[1], x[2] });
+			float minY = std::min({ y[0], y[1], y[2] });
+			float maxY = std::max({ y[0], y[1], y[2] });
+
+			tri.MinX = std::max(0, (int32_t)std::floor(minX));
+			tri.MaxX = std::min((int32_t)S_Width - 1, (int32_t)std::floor(maxX));
+			tri.MinY = std::max(0, (int32_t)std::floor(minY));
+			tri.MaxY = std::min((int32_t)S_Height - 1, (int32_t)std::floor(maxY));
+
+			if (tri.MinX > tri.MaxX || tri.MinY > tri.MaxY)
+				continue;
+
+			for (size_t e = 0; e < 3; ++e)
+			{
+				size_t a = e;
+				size_t b = (e + 1) % 3;
+
+				tri.EdgeA[e] = -(y[b] - y[a]);
+				tri.EdgeB[e] = x[b] - x[a];
+				tri.EdgeC[e] = (y[b] - y[a]) * x[a] - (x[b] - x[a]) * y[a];
+
+				/* Inner conservative, coverage is still tested at pixel centers, but against each edge moved
+				 *   inwards by half a pixel, so only pixels the triangle fully covers are written. (An edge function
+				 *   is smallest at one of the pixel's corners, which lies 0.5 * (|A| + |B|) below it's center) */
+				tri.EdgeC[e] -= 0.5f * (std::abs(tri.EdgeA[e]) + std::abs(tri.EdgeB[e]));
+			}
+
+			/* Depth plane from barycentrics (edge 1-2 weights vertex 0, edge 2-0 weights vertex 1, edge 0-1 weights vertex 2). */
+			float invArea = 1.0f / area;
+			float dz1 = z[1] - z[0];
+			float dz2 = z[2] - z[0];
+
+			float e20A = -(y[0] - y[2]);
+			float e20B = x[0] - x[2];
+			float e20C = (y[0] - y[2]) * x[2] - (x[0] - x[2]) * y[2];
+			float e01A = -(y[1] - y[0]);
+			float e01B = x[1] - x[0];
+			float e01C = (y[1] - y[0]) * x[0] - (x[1] - x[0]) * y[0];
+
+			tri.DepthA = (e20A * dz1 + e01A * dz2) * invArea;
+			tri.DepthB = (e20B * dz1 + e01B * dz2) * invArea;
+			tri.DepthC = z[0] + (e20C * dz1 + e01C * dz2) * invArea;
+
+			/* Store the farthest depth over the whole pixel, rather than at it's center. */
+			tri.DepthC += 0.5f * (std::abs(tri.DepthA) + std::abs(tri.DepthB));
+
+			m_Triangles.emplace_back(tri);
+		}
+
+		m_Stats.NumOccluderTriangles = (uint32_t)m_Triangles.size();
+	}
+
+	void OcclusionCuller::Rasterize() noexcept
+	{
+		spdlog::stopwatch stopwatch;
+
+		std::fill(m_Mips[0].Depth.begin(), m_Mips[0].Depth.end(), 1.0f);
+
+		/* Bands cover disjoint rows, so they can be rasterized without synchronization. */
+		std::for_each(
+			std::execution::par,
+			m_Bands.begin(),
+			m_Bands.end(),
+			[this](uint32_t band)
+			{
+				RasterizeBand(band * S_BandHeight, (band + 1) * S_BandHeight);
+			}
+		);
+
+		BuildHiZ();
+
+		m_Stats.RasterizeMillis = std::chrono::duration<float, std::milli>(stopwatch.elapsed()).count();
+	}
+
+	void OcclusionCuller::RasterizeBand(uint32_t firstRow, uint32_t lastRow) noexcept
+	{
+		for (const ScreenTriangle& tri : m_Triangles)
+			if (tri.MaxY >= (int32_t)firstRow && tri.MinY < (int32_t)lastRow)
+				RasterizeTriangle(tri, firstRow, lastRow);
+	}
+
+	void OcclusionCuller::RasterizeTriangle(const ScreenTriangle& tri, uint32_t firstRow, uint32_t lastRow) noexcept
+	{
+		float* pDepth = m_Mips[0].Depth.data();
+
+		int32_t rowBegin = std::max(tri.MinY, (int32_t)firstRow);
+		int32_t rowEnd = std::min(tri.MaxY + 1, (int32_t)lastRow);
+
+		/* Align to 8 pixels so every store stays inside the row. (S_Width is a multiple of 8) */
+		int32_t columnBegin = tri.MinX & ~7;
+
+#if defined(ENGINE_CORE_ENABLE_AVX2)
+		static_assert(S_Width % AVX2::G_LaneWidth == 0);
+
+		if (CPUSupportsAVX2())
+		{
+			AVX2::RasterizeTriangle(
+				tri.EdgeA,
+				tri.EdgeB,
+				tri.EdgeC,
+				tri.DepthA,
+				tri.DepthB,
+				tri.DepthC,
+				rowBegin,
+				rowEnd,
+				columnBegin,
+				tri.MaxX,
+				pDepth,
+				S_Width
+			);
+
+			return;
+		}
+#endif
+
+		for (int32_t y = rowBegin; y < rowEnd; ++y)
+		{
+			float py = (float)y + 0.5f;
+			float* pRow = pDepth + (size_t)y * S_Width;
+
+			for (int32_t x = columnBegin; x <= tri.MaxX; ++x)
+			{
+				float px = (float)x + 0.5f;
+
+				if (tri.EdgeA[0] * px + tri.EdgeB[0] * py + tri.EdgeC[0] < 0.0f ||
+					tri.EdgeA[1] * px + tri.EdgeB[1] * py + tri.EdgeC[1] < 0.0f ||
+					tri.EdgeA[2] * px + tri.EdgeB[2] * py + tri.EdgeC[2] < 0.0f)
+					continue;
+
+				float depth = tri.DepthA * px + tri.DepthB * py + tri.DepthC;
+				pRow[x] = std::min(pRow[x], depth);
+			}
+		}
+	}
+
+	void OcclusionCuller::BuildHiZ() noexcept
+	{
+		for (size_t level = 1; level < m_Mips.size(); ++level)
+		{
+			const DepthMip& src = m_Mips[level - 1];
+			DepthMip& dst = m_Mips[level];
+
+			for (uint32_t y = 0; y < dst.Height; ++y)
+				for (uint32_t x = 0; x < dst.Width; ++x)
+				{
+					uint32_t sx0 = std::min(x * 2, src.Width - 1);
+					uint32_t sx1 = std::min(x * 2 + 1, src.Width - 1);
+					uint32_t sy0 = std::min(y * 2, src.Height - 1);
+					uint32_t sy1 = std::min(y * 2 + 1, src.Height - 1);
+
+					dst.Depth[(size_t)y * dst.Width + x] = std::max(
+						std::max(src.Depth[(size_t)sy0 * src.Width + sx0], src.Depth[(size_t)sy0 * src.Width + sx1]),
+						std::max(src.Depth[(size_t)sy1 * src.Width + sx0], src.Depth[(size_t)sy1 * src.Width + sx1])
+					);
+				}
+		}
+	}
+
+	void OcclusionCuller::Test(std::span<const OcclusionQuery> queries, std::span<uint8_t> outVisible) noexcept
+	{
+		CM_ENGINE_ASSERT(outVisible.size() >= queries.size());
+
+		spdlog::stopwatch stopwatch;
+
+		constexpr size_t ChunkSize = 256;
+		size_t numChunks = (queries.size() + ChunkSize - 1) / ChunkSize;
+
+		m_Chunks.resize(numChunks);
+		std::iota(m_Chunks.begin(), m_Chunks.end(), 0u);
+
+		std::for_each(
+			std::execution::par,
+			m_Chunks.begin(),
+			m_Chunks.end(),
+			[&](uint32_t chunk)
+			{
+				size_t first = (size_t)chunk * ChunkSize;
+				size_t last = std::min(first + ChunkSize, queries.size());
+
+				for (size_t i = first; i < last; ++i)
+					outVisible[i] = (uint8_t)!IsOccluded(*queries[i].pBounds, *queries[i].pModelMatrix);
+			}
+		);
+
+		m_Stats.NumTested = (uint32_t)queries.size();
+		m_Stats.NumOccluded = (uint32_t)std::count(outVisible.begin(), outVisible.begin() + queries.size(), (uint8_t)0);
+		m_Stats.TestMillis = std::chrono::duration<float, std::milli>(stopwatch.elapsed()).count();
+	}
+
+	[[nodiscard]] bool OcclusionCuller::IsOccluded(const Asset::MeshBounds& bounds, const Math::Mat4& modelMatrix) const noexcept
+	{
+		using namespace DirectX;
+
+		XMMATRIX modelViewProj = XMMatrixMultiply(XMMatrixTranspose(modelMatrix), XMLoadFloat4x4(&m_ViewProj));
+
+		float minX = std::numeric_limits<float>::max();
+		float minY = std::numeric_limits<float>::max();
+		float maxX = std::numeric_limits<float>::lowest();
+		float maxY = std::numeric_limits<float>::lowest();
+		float minZ = std::numeric_limits<float>::max();
+
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			XMVECTOR pos = XMVectorSet(
+				bounds.Center.x + ((corner & 1) ? bounds.Extents.x : -bounds.Extents.x),
+				bounds.Center.y + ((corner & 2) ? bounds.Extents.y : -bounds.Extents.y),
+				bounds.Center.z + ((corner & 4) ? bounds.Extents.z : -bounds.Extents.z),
+				1.0f
+			);
+
+			XMFLOAT4 clip;
+			XMStoreFloat4(&clip, XMVector3Transform(pos, modelViewProj));
+
+			/* Bounds crossing the near plane can't be projected reliably, (and are likely right in front of the camera) */
+			if (clip.w < S_NearW)
+				return false;
+
+			float invW = 1.0f / clip.w;
+			float ndcX = clip.x * invW;
+			float ndcY = clip.y * invW;
+
+			minX = std::min(minX, ndcX);
+			maxX = std::max(maxX, ndcX);
+			minY = std::min(minY, ndcY);
+			maxY = std::max(maxY, ndcY);
+			minZ = std::min(minZ, clip.z * invW);
+		}
+
+		if (minZ <= 0.0f)
+			return false;
+
+		float screenMinX = (minX * 0.5f + 0.5f) * (float)S_Width;
+		float screenMaxX = (maxX * 0.5f + 0.5f) * (float)S_Width;
+		float screenMinY = (0.5f - maxY * 0.5f) * (float)S_Height;
+		float screenMaxY = (0.5f - minY * 0.5f) * (float)S_Height;
+
+		/* Off-screen, that's for the frustum culler to decide. */
+		if (screenMaxX < 0.0f || screenMaxY < 0.0f ||
+			screenMinX >= (float)S_Width || screenMinY >= (float)S_Height)
+			return false;
+
+		int32_t x0 = std::max(0, (int32_t)std::floor(screenMinX));
+		int32_t x1 = std::min((int32_t)S_Width - 1, (int32_t)std::floor(screenMaxX));
+		int32_t y0 = std::max(0, (int32_t)std::floor(screenMinY));
+		int32_t y1 = std::min((int32_t)S_Height - 1, (int32_t)std::floor(screenMaxY));
+
+		/* Pick the finest level where the footprint spans at most 4x4 texels. */
+		size_t level = 0;
+		while (level + 1 < m_Mips.size() &&
+			((x1 >> level) - (x0 >> level) > 3 || (y1 >> level) - (y0 >> level) > 3))
+			++level;
+
+		const DepthMip& mip = m_Mips[level];
+
+		for (int32_t y = y0 >> level; y <= (y1 >> level); ++y)
+			for (int32_t x = x0 >> level; x <= (x1 >> level); ++x)
+				if (minZ <= mip.Depth[(size_t)y * mip.Width + (size_t)x])
+					return false;
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+#include "Component.hpp"
+#include "Math.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace CMEngine::Renderer
+{
+	struct OcclusionStats
+	{
+		uint32_t NumOccluders = 0;
+		uint32_t NumOccluderTriangles = 0;
+		uint32_t NumTested = 0;
+		uint32_t NumOccluded = 0;
+		float RasterizeMillis = 0.0f;
+		float TestMillis = 0.0f;
+
+		inline [[nodiscard]] uint32_t NumVisible() const noexcept { return NumTested - NumOccluded; }
+	};
+
+	struct OcclusionQuery
+	{
+		const Asset::MeshBounds* pBounds = nullptr;
+		const Math::Mat4* pModelMatrix = nullptr;
+	};
+
+	/* CPU occlusion culling against a low resolution depth buffer.
+	 *
+	 * Occluder meshes are rasterized (8 pixels at a time on CPUs with AVX2) into a S_Width x S_Height
+	 *   depth buffer, split into horizontal bands that are rasterized in parallel. A max-depth
+	 *   hierarchy (HiZ) is then built over it, so an instance's projected AABB only has to be
+	 *   compared against a handful of texels, regardless of it's size on screen.
+	 *
+	 * Everything is conservative, an instance is only occluded if it's nearest depth lies behind
+	 *   the farthest occluder depth over every texel it covers. Occluders only write texels a single
+	 *   triangle covers entirely, (at the farthest depth over the texel) so a texel straddling two of
+	 *   an occluder's triangles is left empty, and occluders of few, large triangles occlude the most.
+	 *   Triangles crossing the near plane aren't rasterized, and bounds crossing the near plane are always visible. */
+	class OcclusionCuller
+	{
+	public:
+		OcclusionCuller() noexcept;
+		~OcclusionCuller() = default;
+	public:
+		/* NOTE: Expects the matrices as stored in CameraMatrices, (transposed for HLSL) */
+		void SetCamera(const CameraMatrices& matrices) noexcept;
+
+		/* Clears all occluders, the depth buffer and stats from the previous frame. */
+		void BeginFrame() noexcept;
+
+		/* Transforms and bins the occluder's triangles for the next Rasterize call. */
+		void AddOccluder(const Asset::MeshData& data, const Math::Mat4& modelMatrix) noexcept;
+
+		/* Rasterizes all added occluders, and builds the HiZ mips. */
+		void Rasterize() noexcept;
+
+		/* Writes 0 to outVisible[i] if queries[i] is occluded, otherwise 1. Queries are tested in parallel. */
+		void Test(std::span<const OcclusionQuery> queries, std::span<uint8_t> outVisible) noexcept;
+
+		inline [[nodiscard]] bool HasCamera() const noexcept { return m_HasCamera; }
+		inline [[nodiscard]] bool HasOccluders() const noexcept { return !m_Triangles.empty(); }
+		inline [[nodiscard]] const OcclusionStats& Stats() const noexcept { return m_Stats; }
+	private:
+		/* Edge functions (E(x, y) = A * x + B * y + C) and depth plane of a screen space triangle. */
+		struct ScreenTriangle
+		{
+			float EdgeA[3];
+			float EdgeB[3];
+			float EdgeC[3];
+			float DepthA, DepthB, DepthC;
+			int32_t MinX, MaxX;
+			int32_t MinY, MaxY;
+		};
+
+		struct DepthMip
+		{
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+			std::vector<float> Depth;
+		};
+
+		void RasterizeBand(uint32_t firstRow, uint32_t lastRow) noexcept;
+		void RasterizeTriangle(const ScreenTriangle& tri, uint32_t firstRow, uint32_t lastRow) noexcept;
+		void BuildHiZ() noexcept;
+
+		[[nodiscard]] bool IsOccluded(const Asset::MeshBounds& bounds, const Math::Mat4& modelMatrix) const noexcept;
+	private:
+		static constexpr uint32_t S_Width = 256; /* Must be a multiple of 8. */
+		static constexpr uint32_t S_Height = 128;
+		static constexpr uint32_t S_BandHeight = 8;
+		static constexpr uint32_t S_NumBands = S_Height / S_BandHeight;
+		static constexpr float S_NearW = 1e-4f;
+		DirectX::XMFLOAT4X4 m_ViewProj = {}; /* Row-vector view-projection, (i.e. clip = p * m_ViewProj) */
+		std::vector<ScreenTriangle> m_Triangles;
+		std::vector<DepthMip> m_Mips; /* [0] is the rasterized depth buffer. */
+		std::vector<uint32_t> m_Bands;
+		std::vector<uint32_t> m_Chunks;
+		OcclusionStats m_Stats;
+		bool m_HasCamera = false;
+	};
+}
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <atomic>
 #include <algorithm>
 #include <condition_variable>
+#include <execution>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -17,6 +18,7 @@
 #include <memory>
 #include <map>
 #include <mutex>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <span>
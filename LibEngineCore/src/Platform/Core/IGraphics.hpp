@@ -10,9 +10,26 @@
 #include <functional>
 #include <memory>
 #include <span>
+#include <string_view>
 
 namespace CMEngine
 {
+	/* Output merger state, (blending and depth) of subsequent draws. */
+	enum class BlendMode : int8_t
+	{
+		Unspecified = -1,
+
+		Opaque,    /* Overwrites the target, depth tested and written. */
+		AlphaBlend /* Blends by the source alpha, depth tested but not written. */
+	};
+
+	/* What happens to a buffer's previous contents when it's mapped. */
+	enum class BufferMapMode : int8_t
+	{
+		Discard,    /* The previous contents are orphaned, so the GPU can keep reading them while the CPU writes. */
+		NoOverwrite /* The previous contents are kept, the caller must not write anything the GPU may still be reading. */
+	};
+
 	class IGraphics
 	{
 	public:
@@ -53,17 +70,39 @@ namespace CMEngine
 			const Resource<IInputLayout>& inputLayout
 		) noexcept = 0;
 
+		/* Returns nullptr if @data can't be decoded, or is of a format texture arrays can't be made of. (see TextureFormat) */
 		virtual [[nodiscard]] Resource<ITexture> CreateTexture(
-			std::span<std::byte> data
+			std::span<const std::byte> data
+		) noexcept = 0;
+
+		/* Creates a texture array with room for @capacity slices of @layout's size and format, (and a full mip chain)
+		 *   which are copied in with CopyTextureArraySlices. Returns nullptr if @layout can't be a slice of one.
+		 *
+		 * If @pPrevious isn't nullptr, every slice of it (a texture array of the same layout) is copied first, on the GPU,
+		 *   and the new array has room for at least as many slices. */
+		virtual [[nodiscard]] Resource<ITexture> CreateTextureArray(
+			const ITexture& layout,
+			uint32_t capacity,
+			const ITexture* pPrevious = nullptr
+		) noexcept = 0;
+
+		/* Copies each of @slices into @array, in order, from @firstSlice on, replacing whatever was there.
+		 *   Returns false if the array doesn't have room for all of them, or they can't be combined with it, leaving it as is. */
+		virtual [[nodiscard]] bool CopyTextureArraySlices(
+			const Resource<ITexture>& array,
+			uint32_t firstSlice,
+			std::span<const ITexture* const> slices
 		) noexcept = 0;
 
 		virtual void BindTexture(
 			const Resource<ITexture>& texture
 		) noexcept = 0;
 
+		/* @structureStrideBytes is only used, (and required) for GPUBufferType::Structured. */
 		virtual [[nodiscard]] Resource<IBuffer> CreateBuffer(
 			GPUBufferType type,
-			GPUBufferFlag flags = GPUBufferFlag::Default
+			GPUBufferFlag flags = GPUBufferFlag::Default,
+			uint32_t structureStrideBytes = 0
 		) noexcept = 0;
 
 		virtual void SetBuffer(
@@ -72,6 +111,23 @@ namespace CMEngine
 			size_t numBytes
 		) noexcept = 0;
 
+		/* (Re-)creates a Dynamic @buffer with @numBytes of uninitialized storage. */
+		virtual void ReserveBuffer(
+			const Resource<IBuffer>& buffer,
+			size_t numBytes
+		) noexcept = 0;
+
+		/* Returns a pointer to a Dynamic @buffer's storage, or nullptr if it couldn't be mapped.
+		 * The buffer must be unmapped before anything reading it is drawn. */
+		virtual [[nodiscard]] void* MapBuffer(
+			const Resource<IBuffer>& buffer,
+			BufferMapMode mode
+		) noexcept = 0;
+
+		virtual void UnmapBuffer(
+			const Resource<IBuffer>& buffer
+		) noexcept = 0;
+
 		virtual void BindVertexBuffer(
 			const Resource<IBuffer>& buffer, 
 			uint32_t strideBytes, 
@@ -94,5 +150,26 @@ namespace CMEngine
 			const Resource<IBuffer>& buffer,
 			uint32_t slot
 		) noexcept = 0;
+
+		virtual void BindStructuredBufferPS(
+			const Resource<IBuffer>& buffer,
+			uint32_t slot
+		) noexcept = 0;
+
+		virtual [[nodiscard]] ShaderID GetShader(
+			std::wstring_view shaderName
+		) noexcept = 0;
+
+		virtual void BindShader(
+			ShaderID id
+		) noexcept = 0;
+
+		virtual void BindBlendMode(
+			BlendMode mode
+		) noexcept = 0;
+
+		/* Incremented every time the implementation resets all bound pipeline state behind the caller's back, (ex. on resize)
+		 *   so any caller-side caching of bound state knows to start over. */
+		virtual [[nodiscard]] uint32_t StateEpoch() const noexcept = 0;
 	};
 }
\ No newline at end of file
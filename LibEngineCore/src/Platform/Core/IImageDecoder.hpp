@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace CMEngine
+{
+	struct DecodedImage
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Pixels; /* RGBA8, rows tightly packed. */
+	};
+
+	/* Decodes an encoded image, (PNG, JPG, ... whatever the platform supports) on the CPU. */
+	class IImageDecoder
+	{
+	public:
+		IImageDecoder() = default;
+		virtual ~IImageDecoder() = default;
+	public:
+		/* Returns false if @encoded couldn't be decoded, leaving @outImage empty. */
+		virtual [[nodiscard]] bool Decode(std::span<const std::byte> encoded, DecodedImage& outImage) noexcept = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace CMEngine
+{
+	/* A read-only view of a whole file, mapped into the address space rather than read into a buffer.
+	 * Pages are only read in once they're touched, and are shared with the OS's file cache. */
+	class IMappedFile
+	{
+	public:
+		IMappedFile() = default;
+		virtual ~IMappedFile() = default;
+	public:
+		/* Closes any previously opened file first. Returns false if @path couldn't be mapped, (or is empty) */
+		virtual [[nodiscard]] bool Open(const std::filesystem::path& path) noexcept = 0;
+		virtual void Close() noexcept = 0;
+
+		virtual [[nodiscard]] bool IsOpen() const noexcept = 0;
+
+		/* Empty if not open, and only valid until the file is closed. */
+		virtual [[nodiscard]] std::span<const std::byte> Bytes() const noexcept = 0;
+	};
+}
\ No newline at end of file
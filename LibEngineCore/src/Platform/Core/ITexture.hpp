@@ -2,12 +2,39 @@
 
 #include "Platform/Core/IUploadable.hpp"
 
+#include <cstdint>
+
 namespace CMEngine
 {
+	/* Textures are only ever sampled as UNORM, sRGB is handled by whoever authored them. */
+	enum class TextureFormat : uint8_t
+	{
+		Unknown,
+		RGBA8,
+		BC1, /* RGB, (1 bit alpha) 8 bytes per 4x4 block */
+		BC3, /* RGBA, 16 bytes per 4x4 block */
+		BC5  /* RG, 16 bytes per 4x4 block, (normal maps) */
+	};
+
+	inline constexpr [[nodiscard]] bool IsBlockCompressed(TextureFormat format) noexcept
+	{
+		return format == TextureFormat::BC1 || format == TextureFormat::BC3 || format == TextureFormat::BC5;
+	}
+
 	class ITexture : public IUploadable
 	{
 	public:
 		ITexture() = default;
 		~ITexture() = default;
+
+		virtual [[nodiscard]] uint32_t Width() const noexcept = 0;
+		virtual [[nodiscard]] uint32_t Height() const noexcept = 0;
+
+		/* 1 unless the texture is a texture array, (see IGraphics::CreateTextureArray) in which case it's the
+		 *   number of slices up to the last one copied into so far, rather than how many it has room for. */
+		virtual [[nodiscard]] uint32_t NumSlices() const noexcept = 0;
+
+		virtual [[nodiscard]] uint32_t NumMips() const noexcept = 0;
+		virtual [[nodiscard]] TextureFormat Format() const noexcept = 0;
 	};
 }
\ No newline at end of file
@@ -25,6 +25,10 @@ namespace CMEngine
 	public:
 		IBuffer() = default;
 		virtual ~IBuffer() = default;
+
+		/* Incremented every time the underlying native buffer is (re)created or released,
+		 *   as a re-created buffer must be re-bound even if the IBuffer instance is the same. */
+		virtual [[nodiscard]] uint32_t Revision() const noexcept = 0;
 	};
 
 	using GPUBufferFlagUnderlying = uint8_t;
@@ -74,7 +78,8 @@ namespace CMEngine
 		Invalid = -1,
 		Vertex,
 		Index,
-		Constant
+		Constant,
+		Structured /* A read-only array of structures in a shader, (StructuredBuffer<T> in HLSL) */
 	};
 
 	inline constexpr GPUBufferFlag operator|(GPUBufferFlag a, GPUBufferFlag b) noexcept
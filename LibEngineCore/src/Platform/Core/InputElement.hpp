@@ -44,9 +44,22 @@ namespace CMEngine
 		Float32x3,
 		Float32x4,
 
+		/* Half precision floats, and 16-bit normalized integers. (Read as floats by shaders) */
+		Float16x2,
+		Float16x4,
+
+		UNorm16x2,
+		UNorm16x4,
+
+		SNorm16x2,
+		SNorm16x4,
+
 		/* Set to a 4x4 of 32-bit floating point values. */
 		Mat4,
 
+		/* Set to a 3x4 of 32-bit floating point values. (3 rows of Float32x4) */
+		Mat3x4,
+
 		Count
 	};
 
@@ -66,7 +79,7 @@ namespace CMEngine
 
 	inline constexpr uint32_t G_InputElement_InferByteOffset = ~static_cast<uint32_t>(0);
 
-	/* Used for matrix DataFormat's (Mat4) to clearly indicate that a single input element
+	/* Used for matrix DataFormat's (Mat4, Mat3x4) to clearly indicate that a single input element
 		should be expanded for each row in it's matrix type.
 
 		ie., An InputElement with DataFormat::Mat4 with index
@@ -170,7 +183,17 @@ namespace CMEngine
 		case DataFormat::Float32x3:   return std::string_view("Float32x3");
 		case DataFormat::Float32x4:   return std::string_view("Float32x4");
 
+		case DataFormat::Float16x2:   return std::string_view("Float16x2");
+		case DataFormat::Float16x4:   return std::string_view("Float16x4");
+
+		case DataFormat::UNorm16x2:   return std::string_view("UNorm16x2");
+		case DataFormat::UNorm16x4:   return std::string_view("UNorm16x4");
+
+		case DataFormat::SNorm16x2:   return std::string_view("SNorm16x2");
+		case DataFormat::SNorm16x4:   return std::string_view("SNorm16x4");
+
 		case DataFormat::Mat4:		  return std::string_view("Mat4");
+		case DataFormat::Mat3x4:	  return std::string_view("Mat3x4");
 		}
 	}
 
@@ -234,9 +257,18 @@ namespace CMEngine
 		case DataFormat::Float32x3:   return sizeof(float) * 3;
 		case DataFormat::Float32x4:   return sizeof(float) * 4;
 
+		case DataFormat::Float16x2:   [[fallthrough]];
+		case DataFormat::UNorm16x2:   [[fallthrough]];
+		case DataFormat::SNorm16x2:   return sizeof(uint16_t) * 2;
+
+		case DataFormat::Float16x4:   [[fallthrough]];
+		case DataFormat::UNorm16x4:   [[fallthrough]];
+		case DataFormat::SNorm16x4:   return sizeof(uint16_t) * 4;
+
 		/* NOTE: It is up to the caller to know that this is a matrix format, as there is no
 			corresponding DXGI_FORMAT. The data format for each row is returned. */
 		case DataFormat::Mat4:		  return BytesOfFormat(DataFormat::Float32x4) * 4;
+		case DataFormat::Mat3x4:	  return BytesOfFormat(DataFormat::Float32x4) * 3;
 		}
 	}
 
@@ -244,8 +276,9 @@ namespace CMEngine
 	{
 		switch (format)
 		{
-		default:			   return false;
-		case DataFormat::Mat4: return true;
+		default:			     return false;
+		case DataFormat::Mat4:   [[fallthrough]];
+		case DataFormat::Mat3x4: return true;
 		}
 	}
 
@@ -253,8 +286,9 @@ namespace CMEngine
 	{
 		switch (format)
 		{
-		default:			   return 0;
-		case DataFormat::Mat4: return 4;
+		default:			     return 0;
+		case DataFormat::Mat4:   return 4;
+		case DataFormat::Mat3x4: return 3;
 		}
 	}
 
@@ -262,8 +296,9 @@ namespace CMEngine
 	{
 		switch (format)
 		{
-		default:			   return 0;
-		case DataFormat::Mat4: return BytesOfFormat(DataFormat::Float32x4);
+		default:			     return 0;
+		case DataFormat::Mat4:   [[fallthrough]];
+		case DataFormat::Mat3x4: return BytesOfFormat(DataFormat::Float32x4);
 		}
 	}
 }
\ No newline at end of file
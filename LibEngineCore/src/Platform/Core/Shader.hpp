@@ -18,6 +18,9 @@ namespace CMEngine
 		Quad_VS,
 		Quad_PS,
 		Gltf_Basic_VS,
+		Gltf_Compact_VS,
+		Gltf_Basic_Quantized_VS,
+		Gltf_Compact_Quantized_VS,
 		Gltf_Basic_PS,
 		Gltf_Texture_PS,
 		Custom
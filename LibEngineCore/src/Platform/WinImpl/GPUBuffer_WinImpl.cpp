@@ -108,18 +108,21 @@ namespace CMEngine::Platform::WinImpl
 
 	void GPUBufferBasic::Create(const void* pData, size_t numBytes, const ComPtr<ID3D11Device>& pDevice) noexcept
 	{
-		CM_ENGINE_ASSERT(pData != nullptr);
+		/* Only Dynamic buffers can be created without initial data, since they're written through Map... */
+		CM_ENGINE_ASSERT(pData != nullptr || FlagUnderlying(m_Flags & GPUBufferFlag::Dynamic));
 		CM_ENGINE_ASSERT(numBytes != 0);
 		CM_ENGINE_ASSERT(pDevice.Get() != nullptr);
 
 		mP_Buffer.Reset();
+		mP_Mapped = nullptr;
+		++m_Revision;
 
 		m_Desc.ByteWidth = static_cast<UINT>(numBytes);
 
 		D3D11_SUBRESOURCE_DATA subData = {};
 		subData.pSysMem = pData;
 
-		HRESULT hr = pDevice->CreateBuffer(&m_Desc, &subData, &mP_Buffer);
+		HRESULT hr = pDevice->CreateBuffer(&m_Desc, pData != nullptr ? &subData : nullptr, &mP_Buffer);
 
 		CM_ENGINE_ASSERT(!FAILED(hr));
 	}
@@ -127,6 +130,8 @@ namespace CMEngine::Platform::WinImpl
 	void GPUBufferBasic::Release() noexcept
 	{
 		mP_Buffer.Reset();
+		mP_Mapped = nullptr;
+		++m_Revision;
 
 		m_Desc.ByteWidth = 0;
 		m_Desc.StructureByteStride = 0;
@@ -146,6 +151,35 @@ namespace CMEngine::Platform::WinImpl
 		pContext->Unmap(mP_Buffer.Get(), 0);
 	}
 
+	[[nodiscard]] void* GPUBufferBasic::Map(D3D11_MAP mapType, const ComPtr<ID3D11DeviceContext>& pContext) noexcept
+	{
+		CM_ENGINE_ASSERT(FlagUnderlying(m_Flags & GPUBufferFlag::Dynamic));
+		CM_ENGINE_ASSERT(pContext.Get() != nullptr);
+
+		/* Already mapped, (mapping twice is an error in D3D11) */
+		if (mP_Mapped != nullptr)
+			return mP_Mapped;
+
+		D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+
+		HRESULT hr = pContext->Map(mP_Buffer.Get(), 0, mapType, 0, &mappedResource);
+
+		if (FAILED(hr))
+			return nullptr;
+
+		mP_Mapped = mappedResource.pData;
+		return mP_Mapped;
+	}
+
+	void GPUBufferBasic::Unmap(const ComPtr<ID3D11DeviceContext>& pContext) noexcept
+	{
+		if (mP_Mapped == nullptr)
+			return;
+
+		pContext->Unmap(mP_Buffer.Get(), 0);
+		mP_Mapped = nullptr;
+	}
+
 	VertexBuffer::VertexBuffer(GPUBufferFlag flags) noexcept
 		: GPUBufferBasic(GPUBufferType::Vertex, flags)
 	{
@@ -227,4 +261,58 @@ namespace CMEngine::Platform::WinImpl
 			CM_ENGINE_ASSERT(false);
 		}
 	}
+
+	StructuredBuffer::StructuredBuffer(UINT strideBytes, GPUBufferFlag flags) noexcept
+		: GPUBufferBasic(GPUBufferType::Structured, flags, 0, D3D11_RESOURCE_MISC_BUFFER_STRUCTURED, strideBytes),
+		  m_StrideBytes(strideBytes)
+	{
+	}
+
+	void StructuredBuffer::Create(const void* pData, size_t numBytes, const ComPtr<ID3D11Device>& pDevice) noexcept
+	{
+		CM_ENGINE_ASSERT(m_StrideBytes != 0);
+		CM_ENGINE_ASSERT(numBytes % m_StrideBytes == 0);
+
+		mP_View.Reset();
+
+		/* GPUBufferBasic::Release clears the stride... */
+		m_Desc.StructureByteStride = m_StrideBytes;
+
+		GPUBufferBasic::Create(pData, numBytes, pDevice);
+
+		CD3D11_SHADER_RESOURCE_VIEW_DESC viewDesc(
+			mP_Buffer.Get(),
+			DXGI_FORMAT_UNKNOWN, /* Required for structured buffers. */
+			0, /* First element */
+			static_cast<UINT>(numBytes / m_StrideBytes)
+		);
+
+		HRESULT hr = pDevice->CreateShaderResourceView(mP_Buffer.Get(), &viewDesc, &mP_View);
+
+		CM_ENGINE_ASSERT(!FAILED(hr));
+	}
+
+	void StructuredBuffer::Release() noexcept
+	{
+		mP_View.Reset();
+		GPUBufferBasic::Release();
+	}
+
+	void StructuredBuffer::Upload(const ComPtr<ID3D11DeviceContext>& pContext) const noexcept
+	{
+		CM_ENGINE_ASSERT(IsCreated());
+		CM_ENGINE_ASSERT(m_Register < S_TOTAL_REGISTERS);
+
+		constexpr UINT NumViews = 1;
+
+		pContext->PSSetShaderResources(m_Register, NumViews, mP_View.GetAddressOf());
+	}
+
+	void StructuredBuffer::ClearUpload(const ComPtr<ID3D11DeviceContext>& pContext) const noexcept
+	{
+		constexpr UINT NumViews = 1;
+		ID3D11ShaderResourceView* pNullView = nullptr;
+
+		pContext->PSSetShaderResources(m_Register, NumViews, &pNullView);
+	}
 }
\ No newline at end of file
@@ -27,9 +27,16 @@ namespace CMEngine::Platform::WinImpl
 
 		virtual void Update(const void* pData, size_t numBytes, const ComPtr<ID3D11DeviceContext>& pContext) noexcept = 0;
 
+		/* Only valid for Dynamic buffers, returns nullptr on failure. */
+		virtual [[nodiscard]] void* Map(D3D11_MAP mapType, const ComPtr<ID3D11DeviceContext>& pContext) noexcept = 0;
+		virtual void Unmap(const ComPtr<ID3D11DeviceContext>& pContext) noexcept = 0;
+
 		virtual [[nodiscard]] bool IsCreated() const noexcept = 0;
 		virtual operator bool() const noexcept = 0;
 
+		/* Returns the size in bytes of the created buffer, or 0 if it hasn't been created. */
+		virtual [[nodiscard]] size_t SizeBytes() const noexcept = 0;
+
 		virtual [[nodiscard]] bool HasFlag(GPUBufferFlag flag) const noexcept = 0;
 
 		inline static constexpr [[nodiscard]] D3D11_BIND_FLAG TypeToBindFlags(GPUBufferType type) noexcept;
@@ -59,15 +66,23 @@ namespace CMEngine::Platform::WinImpl
 
 		virtual void Update(const void* pData, size_t numBytes, const ComPtr<ID3D11DeviceContext>& pContext) noexcept override;
 
+		virtual [[nodiscard]] void* Map(D3D11_MAP mapType, const ComPtr<ID3D11DeviceContext>& pContext) noexcept override;
+		virtual void Unmap(const ComPtr<ID3D11DeviceContext>& pContext) noexcept override;
+
 		inline virtual [[nodiscard]] bool IsCreated() const noexcept override { return mP_Buffer.Get() != nullptr; }
 		inline virtual operator bool() const noexcept override { return IsCreated(); }
 
+		inline virtual [[nodiscard]] size_t SizeBytes() const noexcept override { return IsCreated() ? m_Desc.ByteWidth : 0; }
+		inline virtual [[nodiscard]] uint32_t Revision() const noexcept override { return m_Revision; }
+
 		inline constexpr virtual [[nodiscard]] bool HasFlag(GPUBufferFlag flag) const noexcept override { return FlagUnderlying(m_Flags & flag); }
 	protected:
 		GPUBufferType m_Type = GPUBufferType::Invalid;
 		GPUBufferFlag m_Flags = GPUBufferFlag::Unspecified;
 		CD3D11_BUFFER_DESC m_Desc = {};
 		ComPtr<ID3D11Buffer> mP_Buffer;
+		void* mP_Mapped = nullptr; /* Only while mapped through Map. */
+		uint32_t m_Revision = 0;
 	};
 
 	class VertexBuffer : public GPUBufferBasic
@@ -143,6 +158,31 @@ namespace CMEngine::Platform::WinImpl
 		UINT m_RegisterSlot = 0;
 	};
 
+	/* A read-only StructuredBuffer<T> bound to the pixel shader stage through a shader resource view.
+	 * The view is re-created alongside the buffer, so it always covers every element. */
+	class StructuredBuffer : public GPUBufferBasic
+	{
+	public:
+		StructuredBuffer(UINT strideBytes, GPUBufferFlag flags = GPUBufferFlag::Default) noexcept;
+		~StructuredBuffer() = default;
+
+		virtual void Create(const void* pData, size_t numBytes, const ComPtr<ID3D11Device>& pDevice) noexcept override;
+		virtual void Release() noexcept override;
+
+		virtual void Upload(const ComPtr<ID3D11DeviceContext>& pContext) const noexcept override;
+		virtual void ClearUpload(const ComPtr<ID3D11DeviceContext>& pContext) const noexcept override;
+
+		inline void SetRegister(UINT slot) noexcept { m_Register = slot; }
+
+		inline [[nodiscard]] UINT Stride() const noexcept { return m_StrideBytes; }
+		inline [[nodiscard]] UINT Register() const noexcept { return m_Register; }
+	private:
+		static constexpr UINT S_TOTAL_REGISTERS = D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT;
+		ComPtr<ID3D11ShaderResourceView> mP_View;
+		UINT m_StrideBytes = 0;
+		UINT m_Register = 0;
+	};
+
 	inline constexpr [[nodiscard]] D3D11_BIND_FLAG IGPUBuffer::TypeToBindFlags(GPUBufferType type) noexcept
 	{
 		switch (type)
@@ -156,6 +196,8 @@ namespace CMEngine::Platform::WinImpl
 			return D3D11_BIND_INDEX_BUFFER;
 		case GPUBufferType::Constant:
 			return D3D11_BIND_CONSTANT_BUFFER;
+		case GPUBufferType::Structured:
+			return D3D11_BIND_SHADER_RESOURCE;
 		}
 	}
 
@@ -218,14 +218,154 @@ namespace CMEngine::Platform::WinImpl
 		std::cout << '\n';
 	}
 
-	[[nodiscard]] Resource<ITexture> Graphics::CreateTexture(std::span<std::byte> data) noexcept
+	[[nodiscard]] Resource<ITexture> Graphics::CreateTexture(std::span<const std::byte> data) noexcept
 	{
 		Resource<Texture> texture = std::make_unique<Texture>();
 
-		texture->Create(data, mP_Device);
+		if (!texture->Create(data, mP_Device))
+		{
+			spdlog::warn(
+				"(WinImpl_Graphics) [CreateTexture] Internal warning: Attempted to create a texture from data that either "
+				"couldn't be decoded, or wasn't a single 2D texture of a supported format. (RGBA8, BC1, BC3 or BC5)"
+			);
+
+			return nullptr;
+		}
+
 		return texture;
 	}
 
+	/* Returns false (after warning) if any of @slices isn't a single 2D Texture of @layout's size, format and mip count. */
+	static [[nodiscard]] bool ToTextureSlices(
+		std::span<const ITexture* const> slices,
+		const ITexture& layout,
+		std::string_view funcName,
+		std::vector<const Texture*>& outTextures
+	) noexcept
+	{
+		outTextures.clear();
+		outTextures.reserve(slices.size());
+
+		for (const ITexture* pSlice : slices)
+		{
+			const Texture* pTexture = dynamic_cast<const Texture*>(pSlice);
+
+			if (!pTexture || pTexture->NumSlices() != 1)
+			{
+				spdlog::warn(
+					"(WinImpl_Graphics) [{}] Internal warning: Attempted to create a texture array from a slice "
+					"that was either nullptr, not of type derived from ITexture or IDXUploadable, or a texture array itself.",
+					funcName
+				);
+
+				return false;
+			}
+
+			if (pTexture->Width() != layout.Width() ||
+				pTexture->Height() != layout.Height())
+			{
+				spdlog::warn(
+					"(WinImpl_Graphics) [{}] Internal warning: Attempted to create a texture array from slices of different sizes. "
+					"Expected: {}x{}, Slice: {}x{}",
+					funcName, layout.Width(), layout.Height(), pTexture->Width(), pTexture->Height()
+				);
+
+				return false;
+			}
+
+			if (pTexture->Format() != layout.Format() ||
+				pTexture->NumMips() != layout.NumMips())
+			{
+				spdlog::warn(
+					"(WinImpl_Graphics) [{}] Internal warning: Attempted to create a texture array from slices of different formats, "
+					"or mip counts. Expected: {} mips of format {}, Slice: {} mips of format {}",
+					funcName, layout.NumMips(), (uint32_t)layout.Format(), pTexture->NumMips(), (uint32_t)pTexture->Format()
+				);
+
+				return false;
+			}
+
+			outTextures.emplace_back(pTexture);
+		}
+
+		return true;
+	}
+
+	[[nodiscard]] Resource<ITexture> Graphics::CreateTextureArray(
+		const ITexture& layout,
+		uint32_t capacity,
+		const ITexture* pPrevious
+	) noexcept
+	{
+		const ITexture* pLayout = &layout;
+		std::vector<const Texture*> textures;
+
+		if (!ToTextureSlices(std::span(&pLayout, 1), layout, "CreateTextureArray", textures))
+			return nullptr;
+
+		const Texture* pPreviousArray = dynamic_cast<const Texture*>(pPrevious);
+
+		if (pPrevious &&
+			(!pPreviousArray ||
+			pPreviousArray->Width() != layout.Width() ||
+			pPreviousArray->Height() != layout.Height() ||
+			pPreviousArray->Format() != layout.Format()))
+		{
+			spdlog::warn(
+				"(WinImpl_Graphics) [CreateTextureArray] Internal warning: Attempted to create a texture array from a previous array "
+				"that was either not of type derived from ITexture or IDXUploadable, or of a different size or format than the layout."
+			);
+
+			return nullptr;
+		}
+
+		if (capacity > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION)
+		{
+			spdlog::warn(
+				"(WinImpl_Graphics) [CreateTextureArray] Internal warning: Attempted to create a texture array of more slices than D3D11 allows. "
+				"Capacity: {}, Max: {}",
+				capacity, D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION
+			);
+
+			return nullptr;
+		}
+
+		Resource<Texture> texture = std::make_unique<Texture>();
+
+		texture->CreateArray(*textures.front(), capacity, pPreviousArray, mP_Device, mP_Context);
+		return texture;
+	}
+
+	[[nodiscard]] bool Graphics::CopyTextureArraySlices(
+		const Resource<ITexture>& array,
+		uint32_t firstSlice,
+		std::span<const ITexture* const> slices
+	) noexcept
+	{
+		Texture* pArray = dynamic_cast<Texture*>(array.get());
+
+		if (!pArray)
+		{
+			spdlog::warn(
+				"(WinImpl_Graphics) [CopyTextureArraySlices] Internal warning: Attempted to copy into a texture array "
+				"that was either nullptr, or not of type derived from ITexture or IDXUploadable."
+			);
+
+			return false;
+		}
+
+		if (slices.empty())
+			return true;
+
+		std::vector<const Texture*> textures;
+
+		if (!ToTextureSlices(slices, *slices.front(), "CopyTextureArraySlices", textures))
+			return false;
+
+		/* Not a warning, running out of room is expected, and the caller just creates a bigger array... */
+		return pArray->CopySlices(firstSlice, textures, mP_Device, mP_Context);
+	}
+
 	void Graphics::BindTexture(
 		const Resource<ITexture>& texture
 	) noexcept
@@ -245,7 +385,7 @@ namespace CMEngine::Platform::WinImpl
 		pTexture->Upload(mP_Context);
 	}
 
-	[[nodiscard]] Resource<IBuffer> Graphics::CreateBuffer(GPUBufferType type, GPUBufferFlag flags) noexcept
+	[[nodiscard]] Resource<IBuffer> Graphics::CreateBuffer(GPUBufferType type, GPUBufferFlag flags, uint32_t structureStrideBytes) noexcept
 	{
 		switch (type)
 		{
@@ -258,6 +398,14 @@ namespace CMEngine::Platform::WinImpl
 			return Resource<IndexBuffer>(new IndexBuffer(flags));
 		case GPUBufferType::Constant:
 			return Resource<ConstantBuffer>(new ConstantBuffer(flags));
+		case GPUBufferType::Structured:
+			if (structureStrideBytes == 0)
+			{
+				spdlog::warn("(WinImpl_Graphics) [CreateBuffer] Internal warning: Attempted to create a structured buffer without a structure stride.");
+				return Resource<IBuffer>(nullptr);
+			}
+
+			return Resource<StructuredBuffer>(new StructuredBuffer(structureStrideBytes, flags));
 		}
 	}
 
@@ -271,12 +419,58 @@ namespace CMEngine::Platform::WinImpl
 			return;
 		}
 
-		if (pDerived->IsCreated() && pDerived->HasFlag(GPUBufferFlag::Dynamic))
+		/* Dynamic buffers are only mapped if the new data fits, otherwise they're re-created at the new size. */
+		if (pDerived->IsCreated() &&
+			pDerived->HasFlag(GPUBufferFlag::Dynamic) &&
+			numBytes <= pDerived->SizeBytes())
 			pDerived->Update(pData, numBytes, mP_Context);
 		else
 			pDerived->Create(pData, numBytes, mP_Device);
 	}
 
+	void Graphics::ReserveBuffer(const Resource<IBuffer>& buffer, size_t numBytes) noexcept
+	{
+		IGPUBuffer* pDerived = dynamic_cast<IGPUBuffer*>(buffer.get());
+
+		if (!pDerived || !pDerived->HasFlag(GPUBufferFlag::Dynamic))
+		{
+			spdlog::warn("(WinImpl_Graphics) [ReserveBuffer] Internal warning: Attempted to reserve an object that was either nullptr, or not a Dynamic IGPUBuffer.");
+			return;
+		}
+
+		pDerived->Create(nullptr, numBytes, mP_Device);
+	}
+
+	[[nodiscard]] void* Graphics::MapBuffer(const Resource<IBuffer>& buffer, BufferMapMode mode) noexcept
+	{
+		IGPUBuffer* pDerived = dynamic_cast<IGPUBuffer*>(buffer.get());
+
+		if (!pDerived || !pDerived->IsCreated() || !pDerived->HasFlag(GPUBufferFlag::Dynamic))
+		{
+			spdlog::warn("(WinImpl_Graphics) [MapBuffer] Internal warning: Attempted to map an object that was either nullptr, not created, or not a Dynamic IGPUBuffer.");
+			return nullptr;
+		}
+
+		D3D11_MAP mapType = mode == BufferMapMode::NoOverwrite ?
+			D3D11_MAP_WRITE_NO_OVERWRITE :
+			D3D11_MAP_WRITE_DISCARD;
+
+		return pDerived->Map(mapType, mP_Context);
+	}
+
+	void Graphics::UnmapBuffer(const Resource<IBuffer>& buffer) noexcept
+	{
+		IGPUBuffer* pDerived = dynamic_cast<IGPUBuffer*>(buffer.get());
+
+		if (!pDerived)
+		{
+			spdlog::warn("(WinImpl_Graphics) [UnmapBuffer] Internal warning: Attempted to unmap an object that was either nullptr, or not of type derived from IGPUBuffer.");
+			return;
+		}
+
+		pDerived->Unmap(mP_Context);
+	}
+
 	void Graphics::BindVertexBuffer(const Resource<IBuffer>& buffer, uint32_t strideBytes, uint32_t offsetBytes, uint32_t slot) noexcept
 	{
 		VertexBuffer* pDerivedVB = dynamic_cast<VertexBuffer*>(buffer.get());
@@ -338,6 +532,20 @@ namespace CMEngine::Platform::WinImpl
 		pDerivedCB->Upload(mP_Context);
 	}
 
+	void Graphics::BindStructuredBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		StructuredBuffer* pDerivedSB = dynamic_cast<StructuredBuffer*>(buffer.get());
+
+		if (!pDerivedSB)
+		{
+			spdlog::warn("(WinImpl_Graphics) [BindStructuredBufferPS] Internal warning: Attempted to bind a buffer instance that was either nullptr, or not of type StructuredBuffer.");
+			return;
+		}
+
+		pDerivedSB->SetRegister(slot);
+		pDerivedSB->Upload(mP_Context);
+	}
+
 	[[nodiscard]] ShaderID Graphics::GetShader(std::wstring_view shaderName) noexcept
 	{
 		return m_ShaderRegistry.QueryID(shaderName.data());
@@ -348,6 +556,28 @@ namespace CMEngine::Platform::WinImpl
 		m_ShaderRegistry.BindShader(id, mP_Context);
 	}
 
+	void Graphics::BindBlendMode(BlendMode mode) noexcept
+	{
+		constexpr UINT SampleMask = 0xFFFFFFFF;
+		constexpr UINT StencilRef = 1;
+
+		switch (mode)
+		{
+		case BlendMode::Opaque:
+			mP_Context->OMSetBlendState(nullptr, nullptr, SampleMask);
+			mP_Context->OMSetDepthStencilState(mP_DSS_DepthWrite.Get(), StencilRef);
+			return;
+		case BlendMode::AlphaBlend:
+			mP_Context->OMSetBlendState(mP_BS_AlphaBlend.Get(), nullptr, SampleMask);
+			mP_Context->OMSetDepthStencilState(mP_DSS_DepthRead.Get(), StencilRef);
+			return;
+		case BlendMode::Unspecified: [[fallthrough]];
+		default:
+			spdlog::warn("(WinImpl_Graphics) [BindBlendMode] Internal warning: Attempted to bind an unspecified blend mode.");
+			return;
+		}
+	}
+
 	[[nodiscard]] ShaderID Graphics::LastVS() const noexcept
 	{
 		return m_ShaderRegistry.LastVS();
@@ -442,6 +672,7 @@ namespace CMEngine::Platform::WinImpl
 
 		InitDWrite();
 
+		CreateBlendStates();
 		CreateViews();
 		BindViews();
 
@@ -476,6 +707,43 @@ namespace CMEngine::Platform::WinImpl
 		ImGui::DestroyContext();
 	}
 
+	void Graphics::CreateBlendStates() noexcept
+	{
+		D3D11_DEPTH_STENCIL_DESC dsDesc = {};
+		dsDesc.DepthEnable = true;
+		dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+		dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
+
+		HRESULT hr = mP_Device->CreateDepthStencilState(&dsDesc, &mP_DSS_DepthWrite);
+
+		if (FAILED(hr))
+			spdlog::critical("(WinImpl_Graphics) Internal error: Failed to create depth stencil state. Error code: {}", hr);
+
+		/* Blended geometry is still hidden behind opaque geometry, but mustn't hide what's blended behind it. */
+		dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+
+		hr = mP_Device->CreateDepthStencilState(&dsDesc, &mP_DSS_DepthRead);
+
+		if (FAILED(hr))
+			spdlog::critical("(WinImpl_Graphics) Internal error: Failed to create read-only depth stencil state. Error code: {}", hr);
+
+		D3D11_BLEND_DESC blendDesc = {};
+		D3D11_RENDER_TARGET_BLEND_DESC& target = blendDesc.RenderTarget[0];
+		target.BlendEnable = true;
+		target.SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		target.DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+		target.BlendOp = D3D11_BLEND_OP_ADD;
+		target.SrcBlendAlpha = D3D11_BLEND_ONE;
+		target.DestBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
+		target.BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		target.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+
+		hr = mP_Device->CreateBlendState(&blendDesc, &mP_BS_AlphaBlend);
+
+		if (FAILED(hr))
+			spdlog::critical("(WinImpl_Graphics) Internal error: Failed to create alpha blend state. Error code: {}", hr);
+	}
+
 	void Graphics::CreateViews() noexcept
 	{
 		ComPtr<ID3D11Texture2D> pBackBuffer;
@@ -489,18 +757,7 @@ namespace CMEngine::Platform::WinImpl
 		if (FAILED(hr))
 			spdlog::critical("(WinImpl_Graphics) Internal error: Failed to create render target view. Error code: {}", hr);
 
-		D3D11_DEPTH_STENCIL_DESC dsDesc = {};
-		dsDesc.DepthEnable = true;
-		dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-		dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
-
-		ComPtr<ID3D11DepthStencilState> pDSState;
-		hr = mP_Device->CreateDepthStencilState(&dsDesc, &pDSState);
-
-		if (FAILED(hr))
-			spdlog::critical("(WinImpl_Graphics) Internal error: Failed to create depth stencil state. Error code: {}", hr);
-
-		mP_Context->OMSetDepthStencilState(pDSState.Get(), 1);
+		mP_Context->OMSetDepthStencilState(mP_DSS_DepthWrite.Get(), 1);
 
 		D3D11_TEXTURE2D_DESC backBufferSurfaceDesc = {};
 		pBackBuffer->GetDesc(&backBufferSurfaceDesc);
@@ -565,6 +822,7 @@ namespace CMEngine::Platform::WinImpl
 		mP_Context->Flush();
 
 		m_ShaderRegistry.ClearBound();
+		++m_StateEpoch;
 
 		ReleaseViews();
 
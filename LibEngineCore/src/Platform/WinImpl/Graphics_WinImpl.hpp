@@ -90,7 +90,19 @@ namespace CMEngine::Platform::WinImpl
 		) noexcept;
 
 		virtual [[nodiscard]] Resource<ITexture> CreateTexture(
-			std::span<std::byte> data
+			std::span<const std::byte> data
+		) noexcept override;
+
+		virtual [[nodiscard]] Resource<ITexture> CreateTextureArray(
+			const ITexture& layout,
+			uint32_t capacity,
+			const ITexture* pPrevious = nullptr
+		) noexcept override;
+
+		virtual [[nodiscard]] bool CopyTextureArraySlices(
+			const Resource<ITexture>& array,
+			uint32_t firstSlice,
+			std::span<const ITexture* const> slices
 		) noexcept override;
 
 		virtual void BindTexture(
@@ -99,7 +111,8 @@ namespace CMEngine::Platform::WinImpl
 
 		virtual [[nodiscard]] Resource<IBuffer> CreateBuffer(
 			GPUBufferType type, 
-			GPUBufferFlag flags = GPUBufferFlag::Default
+			GPUBufferFlag flags = GPUBufferFlag::Default,
+			uint32_t structureStrideBytes = 0
 		) noexcept override;
 
 		virtual void SetBuffer(
@@ -108,6 +121,20 @@ namespace CMEngine::Platform::WinImpl
 			size_t numBytes
 		) noexcept override;
 
+		virtual void ReserveBuffer(
+			const Resource<IBuffer>& buffer,
+			size_t numBytes
+		) noexcept override;
+
+		virtual [[nodiscard]] void* MapBuffer(
+			const Resource<IBuffer>& buffer,
+			BufferMapMode mode
+		) noexcept override;
+
+		virtual void UnmapBuffer(
+			const Resource<IBuffer>& buffer
+		) noexcept override;
+
 		virtual void BindVertexBuffer(
 			const Resource<IBuffer>& buffer,
 			uint32_t strideBytes,
@@ -131,8 +158,17 @@ namespace CMEngine::Platform::WinImpl
 			uint32_t slot
 		) noexcept override;
 
-		[[nodiscard]] ShaderID GetShader(std::wstring_view shaderName) noexcept;
-		void BindShader(ShaderID id) noexcept;
+		virtual void BindStructuredBufferPS(
+			const Resource<IBuffer>& buffer,
+			uint32_t slot
+		) noexcept override;
+
+		virtual [[nodiscard]] ShaderID GetShader(std::wstring_view shaderName) noexcept override;
+		virtual void BindShader(ShaderID id) noexcept override;
+
+		virtual void BindBlendMode(BlendMode mode) noexcept override;
+
+		inline virtual [[nodiscard]] uint32_t StateEpoch() const noexcept override { return m_StateEpoch; }
 
 		[[nodiscard]] ShaderID LastVS() const noexcept;
 		[[nodiscard]] ShaderID LastPS() const noexcept;
@@ -140,6 +176,9 @@ namespace CMEngine::Platform::WinImpl
 		void Init() noexcept;
 		void Shutdown() noexcept;
 
+		/* Blend and depth stencil states for each BlendMode. */
+		void CreateBlendStates() noexcept;
+
 		/* (Views in this context refer to RTV's and DSV's on the swap chain) */
 		void CreateViews() noexcept;
 		void BindViews() noexcept;
@@ -167,6 +206,9 @@ namespace CMEngine::Platform::WinImpl
 		ComPtr<IDXGISwapChain> mP_SwapChain;
 		ComPtr<ID3D11RenderTargetView> mP_RTV;
 		ComPtr<ID3D11DepthStencilView> mP_DSV;
+		ComPtr<ID3D11DepthStencilState> mP_DSS_DepthWrite; /* BlendMode::Opaque */
+		ComPtr<ID3D11DepthStencilState> mP_DSS_DepthRead;  /* BlendMode::AlphaBlend */
+		ComPtr<ID3D11BlendState> mP_BS_AlphaBlend;
 		ComPtr<IDXGIDebug> mP_DebugInterface;
 		ComPtr<IDXGIInfoQueue> mP_InfoQueue;
 		ComPtr<ID2D1Factory> mP_D2D_Factory;
@@ -178,6 +220,7 @@ namespace CMEngine::Platform::WinImpl
 		static constexpr UINT S_PRESENT_SYNC_INTERVAL_VSYNC = 1;
 		UINT m_PresentSyncInterval = S_PRESENT_SYNC_INTERVAL_VSYNC;
 		UINT m_PresentFlags = 0;
+		uint32_t m_StateEpoch = 0;
 		bool m_LoadedDebugLayer = false;
 	};
 
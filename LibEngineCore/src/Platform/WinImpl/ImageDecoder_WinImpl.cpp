@@ -0,0 +1,112 @@
+#include "PCH.hpp"
+#include "Platform/WinImpl/ImageDecoder_WinImpl.hpp"
+#include "Platform/WinImpl/Types_WinImpl.hpp"
+
+namespace CMEngine::Platform::WinImpl
+{
+	static [[nodiscard]] bool DecodeWIC(std::span<const std::byte> encoded, DecodedImage& outImage) noexcept
+	{
+		ComPtr<IWICImagingFactory> pFactory;
+		HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pFactory));
+
+		if (FAILED(hr))
+			return false;
+
+		ComPtr<IWICStream> pStream;
+		hr = pFactory->CreateStream(&pStream);
+
+		if (FAILED(hr))
+			return false;
+
+		/* WIC only ever reads through the stream, despite the signature. */
+		hr = pStream->InitializeFromMemory(
+			reinterpret_cast<BYTE*>(const_cast<std::byte*>(encoded.data())),
+			static_cast<DWORD>(encoded.size())
+		);
+
+		if (FAILED(hr))
+			return false;
+
+		ComPtr<IWICBitmapDecoder> pDecoder;
+		hr = pFactory->CreateDecoderFromStream(pStream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, &pDecoder);
+
+		if (FAILED(hr))
+			return false;
+
+		ComPtr<IWICBitmapFrameDecode> pFrame;
+		hr = pDecoder->GetFrame(0, &pFrame);
+
+		if (FAILED(hr))
+			return false;
+
+		UINT width = 0;
+		UINT height = 0;
+		hr = pFrame->GetSize(&width, &height);
+
+		if (FAILED(hr) || width == 0 || height == 0)
+			return false;
+
+		/* Matches WIC_LOADER_FORCE_RGBA32, so cooked textures come out the same as ones decoded at runtime. */
+		ComPtr<IWICFormatConverter> pConverter;
+		hr = pFactory->CreateFormatConverter(&pConverter);
+
+		if (FAILED(hr))
+			return false;
+
+		hr = pConverter->Initialize(
+			pFrame.Get(),
+			GUID_WICPixelFormat32bppRGBA,
+			WICBitmapDitherTypeNone,
+			nullptr, /* palette */
+			0.0, /* alpha threshold */
+			WICBitmapPaletteTypeMedianCut
+		);
+
+		if (FAILED(hr))
+			return false;
+
+		size_t rowPitch = static_cast<size_t>(width) * 4;
+		size_t sizeBytes = rowPitch * height;
+
+		if (sizeBytes > std::numeric_limits<UINT>::max())
+			return false;
+
+		outImage.Pixels.resize(sizeBytes);
+
+		hr = pConverter->CopyPixels(
+			nullptr, /* rect, (all of it) */
+			static_cast<UINT>(rowPitch),
+			static_cast<UINT>(sizeBytes),
+			outImage.Pixels.data()
+		);
+
+		if (FAILED(hr))
+			return false;
+
+		outImage.Width = width;
+		outImage.Height = height;
+		return true;
+	}
+
+	[[nodiscard]] bool ImageDecoder::Decode(std::span<const std::byte> encoded, DecodedImage& outImage) noexcept
+	{
+		outImage = DecodedImage();
+
+		if (encoded.empty() || encoded.size() > std::numeric_limits<DWORD>::max())
+			return false;
+
+		/* Decoding may well happen on a worker thread, where COM hasn't been initialized yet... */
+		HRESULT hrCOM = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+		bool uninitializeCOM = SUCCEEDED(hrCOM);
+
+		bool decoded = DecodeWIC(encoded, outImage);
+
+		if (uninitializeCOM)
+			CoUninitialize();
+
+		if (!decoded)
+			outImage = DecodedImage();
+
+		return decoded;
+	}
+}
\ No newline at end of file
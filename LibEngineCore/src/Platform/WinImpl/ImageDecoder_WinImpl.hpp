@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Platform/Core/IImageDecoder.hpp"
+
+namespace CMEngine::Platform::WinImpl
+{
+	/* Decodes through WIC, the same decoders CreateWICTextureFromMemory uses. */
+	class ImageDecoder : public IImageDecoder
+	{
+	public:
+		ImageDecoder() = default;
+		~ImageDecoder() = default;
+	public:
+		virtual [[nodiscard]] bool Decode(std::span<const std::byte> encoded, DecodedImage& outImage) noexcept override;
+	};
+}
\ No newline at end of file
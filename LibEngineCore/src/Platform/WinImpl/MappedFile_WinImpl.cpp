@@ -0,0 +1,78 @@
+#include "PCH.hpp"
+#include "Platform/WinImpl/MappedFile_WinImpl.hpp"
+
+namespace CMEngine::Platform::WinImpl
+{
+	MappedFile::~MappedFile() noexcept
+	{
+		Close();
+	}
+
+	[[nodiscard]] bool MappedFile::Open(const std::filesystem::path& path) noexcept
+	{
+		Close();
+
+		m_File = CreateFileW(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr
+		);
+
+		if (m_File == INVALID_HANDLE_VALUE)
+		{
+			m_File = nullptr;
+			return false;
+		}
+
+		LARGE_INTEGER fileSize = {};
+
+		/* Empty files can't be mapped... */
+		if (!GetFileSizeEx(m_File, &fileSize) || fileSize.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		m_Mapping = CreateFileMappingW(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (m_Mapping == nullptr)
+		{
+			spdlog::warn("(WinImpl_MappedFile) Internal warning: Failed to create file mapping. Error: {}", GetLastError());
+			Close();
+			return false;
+		}
+
+		mP_View = static_cast<const std::byte*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+
+		if (mP_View == nullptr)
+		{
+			spdlog::warn("(WinImpl_MappedFile) Internal warning: Failed to map view of file. Error: {}", GetLastError());
+			Close();
+			return false;
+		}
+
+		m_SizeBytes = static_cast<size_t>(fileSize.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close() noexcept
+	{
+		if (mP_View != nullptr)
+			UnmapViewOfFile(mP_View);
+
+		if (m_Mapping != nullptr)
+			CloseHandle(m_Mapping);
+
+		if (m_File != nullptr)
+			CloseHandle(m_File);
+
+		mP_View = nullptr;
+		m_Mapping = nullptr;
+		m_File = nullptr;
+		m_SizeBytes = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Platform/Core/IMappedFile.hpp"
+#include "Platform/WinImpl/PlatformOSFwd_WinImpl.hpp"
+
+namespace CMEngine::Platform::WinImpl
+{
+	class MappedFile : public IMappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() noexcept;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+	public:
+		virtual [[nodiscard]] bool Open(const std::filesystem::path& path) noexcept override;
+		virtual void Close() noexcept override;
+
+		inline virtual [[nodiscard]] bool IsOpen() const noexcept override { return mP_View != nullptr; }
+		inline virtual [[nodiscard]] std::span<const std::byte> Bytes() const noexcept override { return std::span<const std::byte>(mP_View, m_SizeBytes); }
+	private:
+		HANDLE m_File = nullptr;
+		HANDLE m_Mapping = nullptr;
+		const std::byte* mP_View = nullptr;
+		size_t m_SizeBytes = 0;
+	};
+}
\ No newline at end of file
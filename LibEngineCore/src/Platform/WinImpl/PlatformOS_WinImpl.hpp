@@ -60,6 +60,10 @@
 #include <DirectXMath.h>
 
 #include "WICTextureLoader.h"
+#include "DDSTextureLoader.h"
+
+/* (IWICImagingFactory) */
+#include <wincodec.h>
 
 /* (CoCreateGuid) */
 #include <combaseapi.h>
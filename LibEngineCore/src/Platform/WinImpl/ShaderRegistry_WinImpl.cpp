@@ -10,6 +10,9 @@ namespace CMEngine::Platform::WinImpl
 
 	void ShaderRegistry::CreateShaders(const ComPtr<ID3D11Device>& pDevice) noexcept
 	{
+		/* Sized by every registered name rather than what was loaded, as a missing .cso leaves a gap in the indices. */
+		m_ShaderLookup.assign(m_NextShaderIndex, S_INVALID_LOOKUP);
+
 		for (const ShaderData& data : m_ShaderData)
 		{
 			HRESULT hr = S_OK;
@@ -32,7 +35,10 @@ namespace CMEngine::Platform::WinImpl
 				);
 
 				if (!FAILED(hr))
+				{
+					m_ShaderLookup[data.ID.Index] = static_cast<uint32_t>(m_VertexShaders.size());
 					m_VertexShaders.emplace_back(data.ID, pShader);
+				}
 
 				break;
 			}
@@ -47,7 +53,10 @@ namespace CMEngine::Platform::WinImpl
 				);
 
 				if (!FAILED(hr))
+				{
+					m_ShaderLookup[data.ID.Index] = static_cast<uint32_t>(m_PixelShaders.size());
 					m_PixelShaders.emplace_back(data.ID, pShader);
+				}
 
 				break;
 			}
@@ -61,33 +70,26 @@ namespace CMEngine::Platform::WinImpl
 
 	void ShaderRegistry::BindShader(ShaderID id, const ComPtr<ID3D11DeviceContext>& pContext) noexcept
 	{
-		switch (id.Type)
+		uint32_t lookupIndex = LookupIndex(id);
+
+		if (lookupIndex == S_INVALID_LOOKUP)
 		{
-		default: [[fallthrough]];
-		case ShaderType::Invalid: [[fallthrough]];
-		case ShaderType::Compute:
 			spdlog::warn("(ShaderRegistry) [BindShader] Attempted to bind an invalid or unregistered ShaderType.");
-			break;
-		case ShaderType::Vertex:
-			for (const VertexShader& vertexShader : m_VertexShaders)
-				if (vertexShader.ID.AssignedType == id.AssignedType)
-				{
-					vertexShader.Bind(pContext);
-					break;
-				}
+			return;
+		}
 
+		switch (id.Type)
+		{
+		case ShaderType::Vertex:
+			m_VertexShaders[lookupIndex].Bind(pContext);
 			m_LastVS = id;
 			break;
 		case ShaderType::Pixel:
-			for (const PixelShader& pixelShader : m_PixelShaders)
-				if (pixelShader.ID.AssignedType == id.AssignedType)
-				{
-					pixelShader.Bind(pContext);
-					break;
-				}
-
+			m_PixelShaders[lookupIndex].Bind(pContext);
 			m_LastPS = id;
 			break;
+		default:
+			break;
 		}
 	}
 
@@ -109,12 +111,29 @@ namespace CMEngine::Platform::WinImpl
 
 	[[nodiscard]] const ShaderData* ShaderRegistry::Retrieve(ShaderID id) const noexcept
 	{
-		if (id >= m_ShaderData.size())
+		if (id.Index >= m_ShaderData.size())
 			return nullptr;
 
 		return &m_ShaderData[id.Index];
 	}
 
+	[[nodiscard]] uint32_t ShaderRegistry::LookupIndex(ShaderID id) const noexcept
+	{
+		if (id.Index >= m_ShaderLookup.size())
+			return S_INVALID_LOOKUP;
+
+		switch (id.Type)
+		{
+		case ShaderType::Vertex:
+		case ShaderType::Pixel:
+			return m_ShaderLookup[id.Index];
+		case ShaderType::Invalid: [[fallthrough]];
+		case ShaderType::Compute: [[fallthrough]];
+		default:
+			return S_INVALID_LOOKUP;
+		}
+	}
+
 	void ShaderRegistry::LoadShaders() noexcept
 	{
 		if (!std::filesystem::exists(CM_SHADERS_SHADER_DIRECTORY))
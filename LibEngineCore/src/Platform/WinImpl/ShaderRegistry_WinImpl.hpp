@@ -82,7 +82,11 @@ namespace CMEngine::Platform::WinImpl
 		inline [[nodiscard]] ShaderID LastPS() const noexcept { return m_LastPS; }
 	private:
 		void LoadShaders() noexcept;
+
+		/* Returns the index into m_VertexShaders or m_PixelShaders (depending on id.Type), or S_INVALID_LOOKUP. */
+		[[nodiscard]] uint32_t LookupIndex(ShaderID id) const noexcept;
 	private:
+		static constexpr uint32_t S_INVALID_LOOKUP = ~static_cast<uint32_t>(0);
 		static constexpr std::string_view S_COMPILED_SHADER_EXT = ".cso";
 		static constexpr std::wstring_view S_COMPILED_SHADER_EXTW = L".cso";
 		ShaderID m_LastVS;
@@ -92,8 +96,12 @@ namespace CMEngine::Platform::WinImpl
 		std::vector<VertexShader> m_VertexShaders;
 		std::vector<PixelShader> m_PixelShaders;
 		std::vector<ShaderData> m_ShaderData;
+		std::vector<uint32_t> m_ShaderLookup; /* Indexed by ShaderID::Index, so binds don't have to scan the shader lists. */
 		std::unordered_map<std::wstring, ShaderID> m_ShaderNames = {
 			{ { L"Gltf_Basic_VS" }, { m_NextShaderIndex++, ShaderType::Vertex, AssignedShaderType::Gltf_Basic_VS } },
+			{ { L"Gltf_Compact_VS" }, { m_NextShaderIndex++, ShaderType::Vertex, AssignedShaderType::Gltf_Compact_VS } },
+			{ { L"Gltf_Basic_Quantized_VS" }, { m_NextShaderIndex++, ShaderType::Vertex, AssignedShaderType::Gltf_Basic_Quantized_VS } },
+			{ { L"Gltf_Compact_Quantized_VS" }, { m_NextShaderIndex++, ShaderType::Vertex, AssignedShaderType::Gltf_Compact_Quantized_VS } },
 			{ { L"Gltf_Basic_PS" }, { m_NextShaderIndex++, ShaderType::Pixel,  AssignedShaderType::Gltf_Basic_PS } },
 			{ { L"Gltf_Texture_PS" }, { m_NextShaderIndex++, ShaderType::Pixel,  AssignedShaderType::Gltf_Texture_PS } },
 			{ { L"Quad_VS" }, { m_NextShaderIndex++, ShaderType::Vertex, AssignedShaderType::Quad_VS } },
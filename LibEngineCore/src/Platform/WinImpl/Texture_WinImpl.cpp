@@ -8,21 +8,231 @@ namespace CMEngine::Platform::WinImpl
 	{
 	}
 
-	void Texture::Create(
+	[[nodiscard]] bool Texture::Create(
 		std::span<const std::byte> data,
 		const ComPtr<ID3D11Device>& pDevice
 	) noexcept
 	{
-		HRESULT hr = DirectX::CreateWICTextureFromMemory(
-			pDevice.Get(),
-			data.data(),
-			data.size(),
-			&mP_Texture,
-			&mP_TextureView
-		);
+		constexpr uint32_t DDSMagic = 0x20534444; /* "DDS " */
+
+		uint32_t magic = 0;
+
+		if (data.size() >= sizeof(magic))
+			std::memcpy(&magic, data.data(), sizeof(magic));
+
+		HRESULT hr = S_OK;
+
+		/* Cooked, already block compressed and mipped... */
+		if (magic == DDSMagic)
+			hr = DirectX::CreateDDSTextureFromMemoryEx(
+				pDevice.Get(),
+				reinterpret_cast<const uint8_t*>(data.data()),
+				data.size(),
+				0, /* max size, (only limited by the feature level) */
+				D3D11_USAGE_DEFAULT,
+				D3D11_BIND_SHADER_RESOURCE,
+				0, /* cpu access flags */
+				0, /* misc flags */
+				DirectX::DDS_LOADER_DEFAULT,
+				&mP_Texture,
+				&mP_TextureView
+			);
+		/* Otherwise always decoded as RGBA8, so any two textures of the same size can be copied into the same texture array. */
+		else
+			hr = DirectX::CreateWICTextureFromMemoryEx(
+				pDevice.Get(),
+				reinterpret_cast<const uint8_t*>(data.data()),
+				data.size(),
+				0, /* max size, (only limited by the feature level) */
+				D3D11_USAGE_DEFAULT,
+				D3D11_BIND_SHADER_RESOURCE,
+				0, /* cpu access flags */
+				0, /* misc flags */
+				DirectX::WIC_LOADER_FORCE_RGBA32,
+				&mP_Texture,
+				&mP_TextureView
+			);
+
+		if (FAILED(hr))
+			return false;
+
+		/* Cubemaps, volumes and arrays are all valid DDS files, but can't be a slice of a texture array... */
+		ComPtr<ID3D11Texture2D> pTexture2D;
+		hr = mP_Texture.As(&pTexture2D);
+
+		if (FAILED(hr))
+			return false;
+
+		D3D11_TEXTURE2D_DESC desc = {};
+		pTexture2D->GetDesc(&desc);
+
+		m_Format = DXGIToTexture(desc.Format);
+
+		/* Nor can formats TextureTable has no TextureFormat for, (ex. BC7) as it pages by format. */
+		if (desc.ArraySize != 1 || m_Format == TextureFormat::Unknown)
+			return false;
+
+		m_Width = desc.Width;
+		m_Height = desc.Height;
+		m_NumSlices = 1;
+		m_NumMips = desc.MipLevels;
+
+		CreateSampler(pDevice);
+		return true;
+	}
+
+	void Texture::CreateArray(
+		const Texture& layout,
+		uint32_t capacity,
+		const Texture* pPrevious,
+		const ComPtr<ID3D11Device>& pDevice,
+		const ComPtr<ID3D11DeviceContext>& pContext
+	) noexcept
+	{
+		uint32_t numPrevious = pPrevious ? pPrevious->m_NumSlices : 0;
+
+		m_Width = layout.m_Width;
+		m_Height = layout.m_Height;
+		m_NumSlices = 0;
+		m_SliceCapacity = std::max({ capacity, numPrevious, 1u });
+		m_Format = layout.m_Format;
+
+		CM_ENGINE_ASSERT(m_SliceCapacity <= D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION);
+
+		/* Decoded at runtime, (RGBA8 without mips, see Create) so the mips are generated here. */
+		m_GeneratesMips = m_Format == TextureFormat::RGBA8 && layout.m_NumMips == 1;
+
+		D3D11_TEXTURE2D_DESC desc = {};
+		desc.Width = m_Width;
+		desc.Height = m_Height;
+		desc.ArraySize = m_SliceCapacity;
+		desc.Format = TextureToDXGI(m_Format);
+		desc.SampleDesc.Count = 1;
+		desc.Usage = D3D11_USAGE_DEFAULT;
+
+		if (m_GeneratesMips)
+		{
+			desc.MipLevels = 0; /* Full mip chain, generated as slices are copied in. */
+			desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET; /* GenerateMips requires it can be rendered to. */
+			desc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
+		}
+		else
+		{
+			/* Block compressed formats can't be rendered to anyway, the cooked mips are copied instead. */
+			desc.MipLevels = layout.m_NumMips;
+			desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		}
+
+		ComPtr<ID3D11Texture2D> pArray;
+		HRESULT hr = pDevice->CreateTexture2D(&desc, nullptr, &pArray);
+
+		CM_ENGINE_ASSERT(!FAILED(hr));
+
+		/* Resolves the number of mips... */
+		pArray->GetDesc(&desc);
+		m_NumMips = desc.MipLevels;
+
+		/* Slices nothing was copied into are never sampled, so the view can cover the whole capacity up front. */
+		D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
+		viewDesc.Format = desc.Format;
+		viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+		viewDesc.Texture2DArray.MostDetailedMip = 0;
+		viewDesc.Texture2DArray.MipLevels = static_cast<UINT>(-1); /* Every mip from MostDetailedMip. */
+		viewDesc.Texture2DArray.FirstArraySlice = 0;
+		viewDesc.Texture2DArray.ArraySize = m_SliceCapacity;
+
+		hr = pDevice->CreateShaderResourceView(pArray.Get(), &viewDesc, &mP_TextureView);
 
 		CM_ENGINE_ASSERT(!FAILED(hr));
 
+		/* The previous array's slices already have all of their mips, so are copied whole, on the GPU. */
+		if (pPrevious)
+		{
+			CM_ENGINE_ASSERT(pPrevious->m_Width == m_Width && pPrevious->m_Height == m_Height);
+			CM_ENGINE_ASSERT(pPrevious->m_Format == m_Format && pPrevious->m_NumMips == m_NumMips);
+
+			for (uint32_t slice = 0; slice < numPrevious; ++slice)
+				for (uint32_t mip = 0; mip < m_NumMips; ++mip)
+					pContext->CopySubresourceRegion(
+						pArray.Get(),
+						D3D11CalcSubresource(mip, slice, m_NumMips),
+						0, 0, 0, /* dst x, y, z */
+						pPrevious->mP_Texture.Get(),
+						D3D11CalcSubresource(mip, slice, pPrevious->m_NumMips),
+						nullptr /* src box, (all of it) */
+					);
+
+			m_NumSlices = numPrevious;
+		}
+
+		mP_Texture = pArray;
+
+		CreateSampler(pDevice);
+	}
+
+	[[nodiscard]] bool Texture::CopySlices(
+		uint32_t firstSlice,
+		std::span<const Texture* const> slices,
+		const ComPtr<ID3D11Device>& pDevice,
+		const ComPtr<ID3D11DeviceContext>& pContext
+	) noexcept
+	{
+		uint32_t numSliceMips = m_GeneratesMips ? 1 : m_NumMips;
+
+		if (static_cast<size_t>(firstSlice) + slices.size() > m_SliceCapacity)
+			return false;
+
+		for (const Texture* pSlice : slices)
+			if (pSlice->m_NumSlices != 1 ||
+				pSlice->m_Width != m_Width ||
+				pSlice->m_Height != m_Height ||
+				pSlice->m_Format != m_Format ||
+				pSlice->m_NumMips != numSliceMips)
+				return false;
+
+		if (slices.empty())
+			return true;
+
+		uint32_t slice = firstSlice;
+
+		/* Copied on the GPU, the decoded pixels never come back to the CPU. */
+		for (const Texture* pSlice : slices)
+		{
+			for (uint32_t mip = 0; mip < numSliceMips; ++mip)
+				pContext->CopySubresourceRegion(
+					mP_Texture.Get(),
+					D3D11CalcSubresource(mip, slice, m_NumMips),
+					0, 0, 0, /* dst x, y, z */
+					pSlice->mP_Texture.Get(),
+					D3D11CalcSubresource(mip, 0, numSliceMips),
+					nullptr /* src box, (all of it) */
+				);
+
+			++slice;
+		}
+
+		m_NumSlices = std::max(m_NumSlices, slice);
+
+		if (!m_GeneratesMips)
+			return true;
+
+		/* Only of the copied slices, through a view of just them, as every other slice's mips are already generated. */
+		D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc = {};
+		mP_TextureView->GetDesc(&viewDesc);
+		viewDesc.Texture2DArray.FirstArraySlice = firstSlice;
+		viewDesc.Texture2DArray.ArraySize = static_cast<UINT>(slices.size());
+
+		ComPtr<ID3D11ShaderResourceView> pSlicesView;
+		HRESULT hr = pDevice->CreateShaderResourceView(mP_Texture.Get(), &viewDesc, &pSlicesView);
+
+		CM_ENGINE_ASSERT(!FAILED(hr));
+
+		pContext->GenerateMips(pSlicesView.Get());
+		return true;
+	}
+
+	void Texture::CreateSampler(const ComPtr<ID3D11Device>& pDevice) noexcept
+	{
 		/* Used if D3D11_TEXTURE_ADDRESS_BORDER is provided for AddressU, AddressV, or AddressW. */
 		constexpr FLOAT BorderColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
@@ -39,7 +249,9 @@ namespace CMEngine::Platform::WinImpl
 			D3D11_FLOAT32_MAX /* max LOD, no upper limit on LOD */
 		);
 
-		CM_ENGINE_ASSERT(pDevice->CreateSamplerState(&sampDesc, mP_Sampler.GetAddressOf()) == S_OK);
+		HRESULT hr = pDevice->CreateSamplerState(&sampDesc, mP_Sampler.GetAddressOf());
+
+		CM_ENGINE_ASSERT(!FAILED(hr));
 	}
 
 	void Texture::SetResourceSlot(uint32_t slot) noexcept
@@ -11,16 +11,47 @@ namespace CMEngine::Platform::WinImpl
 		Texture() noexcept;
 		~Texture() = default;
 
-		void Create(
+		/* @data is either a DDS file, (as written by Asset::CookTexture) uploaded as is with all of it's mips,
+		 *   or any other image WIC can decode, which is decoded to RGBA8 without mips.
+		 * Returns false if it can't be decoded, or isn't a single 2D texture of a known TextureFormat. */
+		[[nodiscard]] bool Create(
 			std::span<const std::byte> data,
 			const ComPtr<ID3D11Device>& pDevice
 		) noexcept;
 
+		/* An empty texture array with room for @capacity slices of @layout's size and format, (a 2D texture made by Create)
+		 *   filled by CopySlices. Slices without mips get a full mip chain generated on the GPU, otherwise their mips are copied.
+		 *   Every slice of @pPrevious, (an array made by CreateArray of the same layout) if not nullptr, is copied in first. */
+		void CreateArray(
+			const Texture& layout,
+			uint32_t capacity,
+			const Texture* pPrevious,
+			const ComPtr<ID3D11Device>& pDevice,
+			const ComPtr<ID3D11DeviceContext>& pContext
+		) noexcept;
+
+		/* Copies @slices into consecutive slices from @firstSlice. Returns false if they don't all fit, or any
+		 *   isn't a 2D texture of the array's layout, without copying anything. */
+		[[nodiscard]] bool CopySlices(
+			uint32_t firstSlice,
+			std::span<const Texture* const> slices,
+			const ComPtr<ID3D11Device>& pDevice,
+			const ComPtr<ID3D11DeviceContext>& pContext
+		) noexcept;
+
 		void SetResourceSlot(uint32_t slot) noexcept;
 		void SetSamplerSlot(uint32_t slot) noexcept;
 
 		virtual void Upload(const ComPtr<ID3D11DeviceContext>& pContext) const noexcept override;
 		virtual void ClearUpload(const ComPtr<ID3D11DeviceContext>& pContext) const noexcept override;
+
+		inline virtual [[nodiscard]] uint32_t Width() const noexcept override { return m_Width; }
+		inline virtual [[nodiscard]] uint32_t Height() const noexcept override { return m_Height; }
+		inline virtual [[nodiscard]] uint32_t NumSlices() const noexcept override { return m_NumSlices; }
+		inline virtual [[nodiscard]] uint32_t NumMips() const noexcept override { return m_NumMips; }
+		inline virtual [[nodiscard]] TextureFormat Format() const noexcept override { return m_Format; }
+	private:
+		void CreateSampler(const ComPtr<ID3D11Device>& pDevice) noexcept;
 	private:
 		ComPtr<ID3D11Resource> mP_Texture;
 		ComPtr<ID3D11ShaderResourceView> mP_TextureView;
@@ -28,5 +59,12 @@ namespace CMEngine::Platform::WinImpl
 		ComPtr<ID3D11SamplerState> mP_Sampler;
 		uint32_t m_ResourceSlot = 0;
 		uint32_t m_SamplerSlot = 0;
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_NumSlices = 0; /* Of a texture array, one past the last slice copied into so far. */
+		uint32_t m_SliceCapacity = 0; /* Of a texture array, see CreateArray. */
+		uint32_t m_NumMips = 0;
+		TextureFormat m_Format = TextureFormat::Unknown;
+		bool m_GeneratesMips = false; /* Of a texture array, whose slices are copied in without mips. */
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Platform/Core/InputElement.hpp"
+#include "Platform/Core/ITexture.hpp"
 #include "Types.hpp"
 
 #include <spdlog/spdlog.h>
@@ -16,6 +17,8 @@ namespace CMEngine::Platform::WinImpl
 	inline constexpr [[nodiscard]] size_t BytesOfFormat(DXGI_FORMAT format) noexcept;
 	inline constexpr [[nodiscard]] DXGI_FORMAT DataToDXGI(DataFormat format) noexcept;
 	inline constexpr [[nodiscard]] D3D11_INPUT_CLASSIFICATION InputClassToD3D11(InputClass inputClass) noexcept;
+	inline constexpr [[nodiscard]] DXGI_FORMAT TextureToDXGI(TextureFormat format) noexcept;
+	inline constexpr [[nodiscard]] TextureFormat DXGIToTexture(DXGI_FORMAT format) noexcept;
 
 	inline constexpr [[nodiscard]] size_t BytesOfFormat(DXGI_FORMAT format) noexcept
 	{
@@ -127,10 +130,20 @@ namespace CMEngine::Platform::WinImpl
 		case DataFormat::Float32x2:   return DXGI_FORMAT_R32G32_FLOAT;
 		case DataFormat::Float32x3:   return DXGI_FORMAT_R32G32B32_FLOAT;
 		case DataFormat::Float32x4:   return DXGI_FORMAT_R32G32B32A32_FLOAT;
+
+		case DataFormat::Float16x2:   return DXGI_FORMAT_R16G16_FLOAT;
+		case DataFormat::Float16x4:   return DXGI_FORMAT_R16G16B16A16_FLOAT;
+
+		case DataFormat::UNorm16x2:   return DXGI_FORMAT_R16G16_UNORM;
+		case DataFormat::UNorm16x4:   return DXGI_FORMAT_R16G16B16A16_UNORM;
+
+		case DataFormat::SNorm16x2:   return DXGI_FORMAT_R16G16_SNORM;
+		case DataFormat::SNorm16x4:   return DXGI_FORMAT_R16G16B16A16_SNORM;
 					 
 		/* It is up to the caller to know that this is a matrix format, as there is no 
 		  corresponding DXGI_FORMAT. The data format for each row is returned. */
-		case DataFormat::Mat4:	      return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		case DataFormat::Mat4:	      [[fallthrough]];
+		case DataFormat::Mat3x4:      return DXGI_FORMAT_R32G32B32A32_FLOAT;
 
 		default:
 			spdlog::warn("(WinImpl::DataToDXGI) Unsupported or unimplemented DataFormat was provided: {}", (uint32_t)format);
@@ -150,4 +163,33 @@ namespace CMEngine::Platform::WinImpl
 		case InputClass::PerInstance: return D3D11_INPUT_PER_INSTANCE_DATA;
 		}
 	}
+
+	inline constexpr [[nodiscard]] DXGI_FORMAT TextureToDXGI(TextureFormat format) noexcept
+	{
+		switch (format)
+		{
+		case TextureFormat::RGBA8: return DXGI_FORMAT_R8G8B8A8_UNORM;
+		case TextureFormat::BC1:   return DXGI_FORMAT_BC1_UNORM;
+		case TextureFormat::BC3:   return DXGI_FORMAT_BC3_UNORM;
+		case TextureFormat::BC5:   return DXGI_FORMAT_BC5_UNORM;
+		default:                   return DXGI_FORMAT_UNKNOWN;
+		}
+	}
+
+	/* sRGB formats (which WIC picks for images tagged as sRGB) map to the same TextureFormat, as copying them
+	 *   into a UNORM texture array is fine, both being of the same typeless format. */
+	inline constexpr [[nodiscard]] TextureFormat DXGIToTexture(DXGI_FORMAT format) noexcept
+	{
+		switch (format)
+		{
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: [[fallthrough]];
+		case DXGI_FORMAT_R8G8B8A8_UNORM:      return TextureFormat::RGBA8;
+		case DXGI_FORMAT_BC1_UNORM_SRGB:      [[fallthrough]];
+		case DXGI_FORMAT_BC1_UNORM:           return TextureFormat::BC1;
+		case DXGI_FORMAT_BC3_UNORM_SRGB:      [[fallthrough]];
+		case DXGI_FORMAT_BC3_UNORM:           return TextureFormat::BC3;
+		case DXGI_FORMAT_BC5_UNORM:           return TextureFormat::BC5;
+		default:                              return TextureFormat::Unknown;
+		}
+	}
 }
\ No newline at end of file
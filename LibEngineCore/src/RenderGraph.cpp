@@ -0,0 +1,351 @@
+#include "PCH.hpp"
+#include "RenderGraph.hpp"
+#include "Log.hpp"
+
+#include <queue>
+
+namespace CMEngine::Renderer
+{
+	static void AppendUnique(std::vector<uint32_t>& values, uint32_t value) noexcept
+	{
+		if (std::find(values.begin(), values.end(), value) == values.end())
+			values.emplace_back(value);
+	}
+
+	RenderGraphBuilder::RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) noexcept
+		: m_Graph(graph),
+		  m_PassIndex(passIndex)
+	{
+	}
+
+	[[nodiscard]] RenderGraphResource RenderGraphBuilder::CreateBuffer(std::string_view name, const RenderGraphBufferDesc& desc) noexcept
+	{
+		RenderGraphResource resource = { (uint32_t)m_Graph.m_Resources.size() };
+
+		RenderGraph::ResourceNode& node = m_Graph.m_Resources.emplace_back();
+		node.Name = name;
+		node.Desc = desc;
+
+		return resource;
+	}
+
+	RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource) noexcept
+	{
+		CM_ENGINE_ASSERT(resource.Index < m_Graph.m_Resources.size());
+
+		AppendUnique(m_Graph.m_Passes[m_PassIndex].Reads, resource.Index);
+		return resource;
+	}
+
+	RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource) noexcept
+	{
+		CM_ENGINE_ASSERT(resource.Index < m_Graph.m_Resources.size());
+
+		AppendUnique(m_Graph.m_Passes[m_PassIndex].Writes, resource.Index);
+		return resource;
+	}
+
+	void RenderGraphBuilder::SetSideEffects() noexcept
+	{
+		m_Graph.m_Passes[m_PassIndex].HasSideEffects = true;
+	}
+
+	RenderGraphContext::RenderGraphContext(const RenderGraph& graph, IGraphics& graphics) noexcept
+		: m_Graph(graph),
+		  m_Graphics(graphics)
+	{
+	}
+
+	[[nodiscard]] const Resource<IBuffer>& RenderGraphContext::GetBuffer(RenderGraphResource resource) const noexcept
+	{
+		static const Resource<IBuffer> S_Null;
+
+		CM_ENGINE_ASSERT(resource.Index < m_Graph.m_Resources.size());
+
+		uint32_t physical = m_Graph.m_Resources[resource.Index].Physical;
+
+		if (physical == RenderGraphResource::S_InvalidIndex)
+			return S_Null;
+
+		return m_Graph.m_PhysicalBuffers[physical].Buffer;
+	}
+
+	RenderGraph::RenderGraph(IGraphics& graphics) noexcept
+		: m_Graphics(graphics)
+	{
+	}
+
+	[[nodiscard]] RenderGraphResource RenderGraph::Import(std::string_view name) noexcept
+	{
+		RenderGraphResource resource = { (uint32_t)m_Resources.size() };
+
+		ResourceNode& node = m_Resources.emplace_back();
+		node.Name = name;
+		node.IsImported = true;
+
+		m_IsDirty = true;
+		return resource;
+	}
+
+	void RenderGraph::AddPass(std::string_view name, const SetupFunc& setup, ExecuteFunc execute) noexcept
+	{
+		uint32_t passIndex = (uint32_t)m_Passes.size();
+
+		PassNode& pass = m_Passes.emplace_back();
+		pass.Name = name;
+		pass.Execute = std::move(execute);
+
+		RenderGraphBuilder builder(*this, passIndex);
+		setup(builder);
+
+		m_IsDirty = true;
+	}
+
+	void RenderGraph::Execute() noexcept
+	{
+		if (m_IsDirty)
+			Compile();
+
+		RenderGraphContext context(*this, m_Graphics);
+
+		for (uint32_t passIndex : m_Order)
+			if (m_Passes[passIndex].Execute)
+				m_Passes[passIndex].Execute(context);
+	}
+
+	void RenderGraph::Compile() noexcept
+	{
+		BuildDependencies();
+		CullPasses();
+		SortPasses();
+		AliasTransients();
+
+		m_Stats.NumPasses = (uint32_t)m_Passes.size();
+		m_Stats.NumCulledPasses = (uint32_t)(m_Passes.size() - m_Order.size());
+		++m_Stats.NumCompiles;
+
+		m_IsDirty = false;
+	}
+
+	void RenderGraph::BuildDependencies() noexcept
+	{
+		/* Of each resource's current version, (i.e. since it's last write) walking passes in the order they were added. */
+		std::vector<uint32_t> lastWriters(m_Resources.size(), RenderGraphResource::S_InvalidIndex);
+		std::vector<std::vector<uint32_t>> readers(m_Resources.size());
+
+		for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex)
+		{
+			PassNode& pass = m_Passes[passIndex];
+
+			pass.Dependencies.clear();
+			pass.OrderAfter.clear();
+
+			/* A read of something the pass also writes is part of that write... */
+			for (uint32_t resource : pass.Reads)
+			{
+				if (std::find(pass.Writes.begin(), pass.Writes.end(), resource) != pass.Writes.end())
+					continue;
+
+				/* (Imported resources can be read without ever being written) */
+				if (lastWriters[resource] != RenderGraphResource::S_InvalidIndex)
+					AppendUnique(pass.Dependencies, lastWriters[resource]);
+				else if (!m_Resources[resource].IsImported)
+					CM_ENGINE_LOG_WARN(
+						"(RenderGraph) Internal warning: Pass reads a transient before any pass writes it. Pass: {}, Resource: {}",
+						pass.Name, m_Resources[resource].Name
+					);
+
+				AppendUnique(readers[resource], passIndex);
+			}
+
+			/* ...which runs after the previous write, and after everything that read the version it replaces. */
+			for (uint32_t resource : pass.Writes)
+			{
+				if (lastWriters[resource] != RenderGraphResource::S_InvalidIndex)
+					AppendUnique(pass.Dependencies, lastWriters[resource]);
+
+				for (uint32_t reader : readers[resource])
+					if (reader != passIndex)
+						AppendUnique(pass.OrderAfter, reader);
+
+				lastWriters[resource] = passIndex;
+				readers[resource].clear();
+			}
+		}
+	}
+
+	void RenderGraph::CullPasses() noexcept
+	{
+		std::vector<uint32_t> stack;
+
+		for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex)
+		{
+			PassNode& pass = m_Passes[passIndex];
+
+			bool writesImported = std::any_of(
+				pass.Writes.begin(),
+				pass.Writes.end(),
+				[&](uint32_t resource) { return m_Resources[resource].IsImported; }
+			);
+
+			pass.IsCulled = !(pass.HasSideEffects || writesImported);
+
+			if (!pass.IsCulled)
+				stack.emplace_back(passIndex);
+		}
+
+		/* Everything a kept pass depends on is kept too... */
+		while (!stack.empty())
+		{
+			uint32_t passIndex = stack.back();
+			stack.pop_back();
+
+			for (uint32_t dependency : m_Passes[passIndex].Dependencies)
+				if (m_Passes[dependency].IsCulled)
+				{
+					m_Passes[dependency].IsCulled = false;
+					stack.emplace_back(dependency);
+				}
+		}
+	}
+
+	void RenderGraph::SortPasses() noexcept
+	{
+		m_Order.clear();
+
+		std::vector<uint32_t> numPending(m_Passes.size(), 0);
+		std::vector<std::vector<uint32_t>> dependents(m_Passes.size());
+
+		for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex)
+		{
+			if (m_Passes[passIndex].IsCulled)
+				continue;
+
+			for (uint32_t dependency : m_Passes[passIndex].Dependencies)
+			{
+				++numPending[passIndex];
+				dependents[dependency].emplace_back(passIndex);
+			}
+
+			/* Overwriting a version doesn't keep it's readers, (see CullPasses) so they're only waited on if something else did. */
+			for (uint32_t reader : m_Passes[passIndex].OrderAfter)
+				if (!m_Passes[reader].IsCulled)
+				{
+					++numPending[passIndex];
+					dependents[reader].emplace_back(passIndex);
+				}
+		}
+
+		/* Kahn's algorithm, always taking the earliest added pass that's ready. */
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+
+		for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex)
+			if (!m_Passes[passIndex].IsCulled && numPending[passIndex] == 0)
+				ready.push(passIndex);
+
+		while (!ready.empty())
+		{
+			uint32_t passIndex = ready.top();
+			ready.pop();
+
+			m_Order.emplace_back(passIndex);
+
+			for (uint32_t dependent : dependents[passIndex])
+				if (--numPending[dependent] == 0)
+					ready.push(dependent);
+		}
+
+		size_t numKept = std::count_if(m_Passes.begin(), m_Passes.end(), [](const PassNode& pass) { return !pass.IsCulled; });
+
+		if (m_Order.size() == numKept)
+			return;
+
+		CM_ENGINE_LOG_WARN(
+			"(RenderGraph) Internal warning: Passes have a cyclic dependency, and will run in the order they were added instead."
+		);
+
+		m_Order.clear();
+		for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex)
+			if (!m_Passes[passIndex].IsCulled)
+				m_Order.emplace_back(passIndex);
+	}
+
+	void RenderGraph::AliasTransients() noexcept
+	{
+		constexpr uint32_t Unused = RenderGraphResource::S_InvalidIndex;
+
+		/* Lifetime of each transient, as the first and last position in m_Order using it. */
+		std::vector<uint32_t> firstUse(m_Resources.size(), Unused);
+		std::vector<uint32_t> lastUse(m_Resources.size(), 0);
+
+		for (uint32_t position = 0; position < m_Order.size(); ++position)
+		{
+			const PassNode& pass = m_Passes[m_Order[position]];
+
+			auto use = [&](uint32_t resource)
+			{
+				firstUse[resource] = std::min(firstUse[resource], position);
+				lastUse[resource] = std::max(lastUse[resource], position);
+			};
+
+			std::for_each(pass.Reads.begin(), pass.Reads.end(), use);
+			std::for_each(pass.Writes.begin(), pass.Writes.end(), use);
+		}
+
+		std::vector<uint32_t> transients;
+
+		for (uint32_t resource = 0; resource < m_Resources.size(); ++resource)
+		{
+			m_Resources[resource].Physical = Unused;
+
+			if (!m_Resources[resource].IsImported && firstUse[resource] != Unused)
+				transients.emplace_back(resource);
+		}
+
+		std::sort(
+			transients.begin(),
+			transients.end(),
+			[&](uint32_t lhs, uint32_t rhs) { return firstUse[lhs] < firstUse[rhs]; }
+		);
+
+		for (PhysicalBuffer& physical : m_PhysicalBuffers)
+			physical.IsAssigned = false;
+
+		/* Greedily hand each transient the first compatible buffer that's free by the time it's first used... */
+		for (uint32_t resource : transients)
+		{
+			ResourceNode& node = m_Resources[resource];
+
+			auto it = std::find_if(
+				m_PhysicalBuffers.begin(),
+				m_PhysicalBuffers.end(),
+				[&](const PhysicalBuffer& physical)
+				{
+					return physical.Desc == node.Desc &&
+						(!physical.IsAssigned || physical.LastUse < firstUse[resource]);
+				}
+			);
+
+			if (it == m_PhysicalBuffers.end())
+			{
+				PhysicalBuffer& physical = m_PhysicalBuffers.emplace_back();
+				physical.Desc = node.Desc;
+				physical.Buffer = m_Graphics.CreateBuffer(node.Desc.Type, node.Desc.Flags, node.Desc.StructureStrideBytes);
+
+				it = m_PhysicalBuffers.end() - 1;
+			}
+
+			it->IsAssigned = true;
+			it->LastUse = lastUse[resource];
+
+			node.Physical = (uint32_t)std::distance(m_PhysicalBuffers.begin(), it);
+		}
+
+		m_Stats.NumTransients = (uint32_t)transients.size();
+		m_Stats.NumPhysicalBuffers = (uint32_t)std::count_if(
+			m_PhysicalBuffers.begin(),
+			m_PhysicalBuffers.end(),
+			[](const PhysicalBuffer& physical) { return physical.IsAssigned; }
+		);
+	}
+}
\ No newline at end of file
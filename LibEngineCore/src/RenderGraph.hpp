@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Platform/Core/IGraphics.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CMEngine::Renderer
+{
+	/* Handle to a resource of a RenderGraph, only valid for the graph that declared it. */
+	struct RenderGraphResource
+	{
+		static constexpr uint32_t S_InvalidIndex = ~static_cast<uint32_t>(0);
+
+		uint32_t Index = S_InvalidIndex;
+
+		inline [[nodiscard]] bool IsValid() const noexcept { return Index != S_InvalidIndex; }
+	};
+
+	/* Transient buffers can only share an IBuffer if their descs are equal. */
+	struct RenderGraphBufferDesc
+	{
+		GPUBufferType Type = GPUBufferType::Invalid;
+		GPUBufferFlag Flags = GPUBufferFlag::Default;
+		uint32_t StructureStrideBytes = 0; /* Only used for GPUBufferType::Structured. */
+
+		inline [[nodiscard]] bool operator==(const RenderGraphBufferDesc& other) const noexcept
+		{
+			return Type == other.Type &&
+				Flags == other.Flags &&
+				StructureStrideBytes == other.StructureStrideBytes;
+		}
+	};
+
+	struct RenderGraphStats
+	{
+		uint32_t NumPasses = 0;
+		uint32_t NumCulledPasses = 0;
+		uint32_t NumTransients = 0;     /* Used by at least one pass that wasn't culled. */
+		uint32_t NumPhysicalBuffers = 0; /* Backing every transient, as of the last compile. */
+		uint32_t NumCompiles = 0;       /* Since construction. */
+	};
+
+	class RenderGraph;
+
+	/* Records the reads and writes of a single pass, only usable within it's setup. */
+	class RenderGraphBuilder
+	{
+		friend class RenderGraph;
+	public:
+		/* Declares a buffer that only lives from the first to the last pass using it, (in execution order)
+		 *   and is therefore undefined at the start of the first pass, which must write it. */
+		[[nodiscard]] RenderGraphResource CreateBuffer(std::string_view name, const RenderGraphBufferDesc& desc) noexcept;
+
+		/* Both return @resource, for convenience. */
+		RenderGraphResource Read(RenderGraphResource resource) noexcept;
+		RenderGraphResource Write(RenderGraphResource resource) noexcept;
+
+		/* The pass is never culled, even if nothing reads what it writes. */
+		void SetSideEffects() noexcept;
+	private:
+		RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) noexcept;
+	private:
+		RenderGraph& m_Graph;
+		uint32_t m_PassIndex = 0;
+	};
+
+	/* Handed to a pass's execute callback. */
+	class RenderGraphContext
+	{
+		friend class RenderGraph;
+	public:
+		/* nullptr for imported resources, which the pass reaches through whatever owns them. */
+		[[nodiscard]] const Resource<IBuffer>& GetBuffer(RenderGraphResource resource) const noexcept;
+
+		inline [[nodiscard]] IGraphics& Graphics() const noexcept { return m_Graphics; }
+	private:
+		RenderGraphContext(const RenderGraph& graph, IGraphics& graphics) noexcept;
+	private:
+		const RenderGraph& m_Graph;
+		IGraphics& m_Graphics;
+	};
+
+	/* Orders passes by the resources they read and write, culls passes whose writes are never used, and lets
+	 *   transient buffers with non-overlapping lifetimes share a single IBuffer.
+	 *
+	 * Passes are added once, not every frame. Adding a pass or importing a resource changes the graph's topology,
+	 *   which is only recompiled by the next Execute. Passes writing the same resource run in the order they
+	 *   were added, and a pass that only reads a resource runs after the last pass added before it that writes it,
+	 *   and before the next one. (so every write starts a new version of the resource) Any other order is free,
+	 *   and ties keep the order passes were added in.
+	 *
+	 * Only passes writing an imported resource, (ex. the back buffer) or with side effects, are kept,
+	 *   along with every pass they depend on. Everything goes through IGraphics, so the graph behaves the same
+	 *   on any implementation of it. */
+	class RenderGraph
+	{
+		friend class RenderGraphBuilder;
+		friend class RenderGraphContext;
+	public:
+		using SetupFunc = std::function<void(RenderGraphBuilder&)>;
+		using ExecuteFunc = std::function<void(RenderGraphContext&)>;
+
+		RenderGraph(IGraphics& graphics) noexcept;
+		~RenderGraph() = default;
+	public:
+		/* Declares a resource owned outside of the graph. Writing one is what keeps a pass from being culled. */
+		[[nodiscard]] RenderGraphResource Import(std::string_view name) noexcept;
+
+		/* @setup is called immediately, to declare the pass's reads and writes. */
+		void AddPass(std::string_view name, const SetupFunc& setup, ExecuteFunc execute) noexcept;
+
+		/* Compiles the graph if it's topology has changed, then executes every pass that wasn't culled. */
+		void Execute() noexcept;
+
+		/* Of the last compile. */
+		inline [[nodiscard]] const RenderGraphStats& Stats() const noexcept { return m_Stats; }
+	private:
+		struct ResourceNode
+		{
+			std::string Name;
+			RenderGraphBufferDesc Desc;
+			uint32_t Physical = RenderGraphResource::S_InvalidIndex; /* Into m_PhysicalBuffers, if used. */
+			bool IsImported = false;
+		};
+
+		struct PassNode
+		{
+			std::string Name;
+			ExecuteFunc Execute;
+			std::vector<uint32_t> Reads;
+			std::vector<uint32_t> Writes;
+			std::vector<uint32_t> Dependencies; /* Passes that must run first. */
+			std::vector<uint32_t> OrderAfter; /* Readers of what the pass overwrites, which only run first if they're kept. */
+			bool HasSideEffects = false;
+			bool IsCulled = false;
+		};
+
+		struct PhysicalBuffer
+		{
+			RenderGraphBufferDesc Desc;
+			Resource<IBuffer> Buffer;
+			uint32_t LastUse = 0; /* Order index of the last pass using it, while compiling. */
+			bool IsAssigned = false;
+		};
+
+		void Compile() noexcept;
+		void BuildDependencies() noexcept;
+		void CullPasses() noexcept;
+		void SortPasses() noexcept;
+		void AliasTransients() noexcept;
+	private:
+		IGraphics& m_Graphics;
+		std::vector<ResourceNode> m_Resources;
+		std::vector<PassNode> m_Passes;
+		std::vector<uint32_t> m_Order; /* Passes that weren't culled, in execution order. */
+		std::vector<PhysicalBuffer> m_PhysicalBuffers; /* Kept across compiles, so a recompile doesn't re-create them. */
+		RenderGraphStats m_Stats;
+		bool m_IsDirty = false;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "PCH.hpp"
+#include "RenderQueue.hpp"
+#include "CPUFeatures.hpp"
+#include "AVX2Kernels.hpp"
+
+#include <bit>
+
+namespace CMEngine::Renderer
+{
+	/* Flips every bit of negative floats, and only the sign bit of positive ones, so they order as unsigned integers. */
+	static [[nodiscard]] uint32_t DepthToKey(float depth) noexcept
+	{
+		uint32_t bits = std::bit_cast<uint32_t>(depth);
+		uint32_t mask = (uint32_t)((int32_t)bits >> 31) | 0x80000000u;
+
+		return bits ^ mask;
+	}
+
+	void DepthSorter::SetCamera(const CameraMatrices& matrices) noexcept
+	{
+		/* View is stored transposed, so it's third row is the z column of the row-vector view matrix. */
+		DirectX::XMFLOAT4X4 view;
+		DirectX::XMStoreFloat4x4(&view, matrices.View);
+
+		m_ViewZ = { view.m[2][0], view.m[2][1], view.m[2][2], view.m[2][3] };
+		m_HasCamera = true;
+	}
+
+	void DepthSorter::Compute(std::span<const float> centerX, std::span<const float> centerY, std::span<const float> centerZ) noexcept
+	{
+		CM_ENGINE_ASSERT(centerX.size() == centerY.size() && centerX.size() == centerZ.size());
+
+		m_Count = centerX.size();
+		m_Depths.resize(m_Count);
+		m_Keys.resize(m_Count);
+
+		size_t i = 0;
+
+#if defined(ENGINE_CORE_ENABLE_AVX2)
+		static_assert(S_LaneWidth == AVX2::G_LaneWidth);
+
+		if (CPUSupportsAVX2())
+		{
+			i = AVX2::ComputeDepthKeys(&m_ViewZ.x, centerX.data(), centerY.data(), centerZ.data(), m_Count, m_Depths.data(), m_Keys.data());
+		}
+#endif
+
+		/* Remainder, (or everything without AVX2) */
+		for (; i < m_Count; ++i)
+		{
+			float depth = m_ViewZ.x * centerX[i] + m_ViewZ.y * centerY[i] + m_ViewZ.z * centerZ[i] + m_ViewZ.w;
+
+			m_Depths[i] = depth;
+			m_Keys[i] = DepthToKey(depth);
+		}
+	}
+}
\ No newline at end of file
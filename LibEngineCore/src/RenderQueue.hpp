@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Asset/Asset.hpp"
+#include "Component.hpp"
+#include "Math.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace CMEngine::Renderer
+{
+	/* Queues are drawn in order. */
+	enum class RenderQueue : uint8_t
+	{
+		Opaque,     /* Sorted front-to-back within each batch, for early depth rejection. */
+		Transparent /* Sorted back-to-front across every instance, and blended. */
+	};
+
+	inline constexpr [[nodiscard]] RenderQueue SelectRenderQueue(const Asset::MaterialData& data) noexcept
+	{
+		return data.BaseColor.a() < 1.0f ? RenderQueue::Transparent : RenderQueue::Opaque;
+	}
+
+	struct RenderQueueStats
+	{
+		uint32_t NumOpaque = 0;
+		uint32_t NumTransparent = 0;
+		uint32_t NumTransparentRuns = 0; /* Consecutive transparent instances that could be drawn together. */
+	};
+
+	/* Computes the camera-space depth of instances, and turns them into integer sort keys.
+	 *
+	 * Depths are taken from world-space centers that are already laid out as SoA, (ex. by FrustumCuller)
+	 *   so 8 depths and keys are computed at a time on CPUs with AVX2. A key is the depth's bit pattern, adjusted so
+	 *   that comparing keys as unsigned integers orders them the same as the depths. */
+	class DepthSorter
+	{
+	public:
+		DepthSorter() = default;
+		~DepthSorter() = default;
+	public:
+		/* NOTE: Expects the matrices as stored in CameraMatrices, (transposed for HLSL) */
+		void SetCamera(const CameraMatrices& matrices) noexcept;
+
+		/* Replaces the previous keys with those of every center. All spans must be the same size. */
+		void Compute(std::span<const float> centerX, std::span<const float> centerY, std::span<const float> centerZ) noexcept;
+
+		inline [[nodiscard]] float Depth(size_t index) const noexcept { return m_Depths[index]; }
+
+		/* Ascending keys are front-to-back, and their complement back-to-front. */
+		inline [[nodiscard]] uint32_t FrontToBackKey(size_t index) const noexcept { return m_Keys[index]; }
+		inline [[nodiscard]] uint32_t BackToFrontKey(size_t index) const noexcept { return ~m_Keys[index]; }
+
+		inline [[nodiscard]] size_t Count() const noexcept { return m_Count; }
+		inline [[nodiscard]] bool HasCamera() const noexcept { return m_HasCamera; }
+	private:
+		static constexpr size_t S_LaneWidth = 8;
+		DirectX::XMFLOAT4 m_ViewZ = {}; /* The view matrix's z column, so depth = dot(m_ViewZ, (p, 1)) */
+		std::vector<float> m_Depths;
+		std::vector<uint32_t> m_Keys;
+		size_t m_Count = 0;
+		bool m_HasCamera = false;
+	};
+}
\ No newline at end of file
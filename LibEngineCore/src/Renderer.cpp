@@ -8,9 +8,21 @@ namespace CMEngine::Renderer
 	Renderer::Renderer(ECS::ECS& ecs, AGraphics& graphics, Asset::AssetManager& assetManager) noexcept
 		: m_ECS(ecs),
 		  m_Graphics(graphics),
-		  m_BatchRenderer(m_ECS, m_Graphics, assetManager)
+		  m_StateCache(m_Graphics),
+		  m_UploadRing(m_Graphics, GPUBufferType::Vertex),
+		  m_BatchRenderer(m_ECS, m_Graphics, m_StateCache, m_UploadRing, assetManager),
+		  m_RenderGraph(m_Graphics)
 	{
 		m_CB_CameraProj = m_Graphics.CreateBuffer(GPUBufferType::Constant, GPUBufferFlag::Dynamic);
+
+		/* The swap chain's back buffer is owned by the graphics implementation... */
+		m_RG_BackBuffer = m_RenderGraph.Import("BackBuffer");
+
+		m_RenderGraph.AddPass(
+			"Batches",
+			[this](RenderGraphBuilder& builder) { builder.Write(m_RG_BackBuffer); },
+			[this](RenderGraphContext&) { m_BatchRenderer.Flush(); }
+		);
 	}
 
 	Renderer::~Renderer() noexcept
@@ -19,6 +31,8 @@ namespace CMEngine::Renderer
 
 	void Renderer::StartFrame(const Color4& clearColor) noexcept
 	{
+		m_StateCache.BeginFrame();
+		m_UploadRing.BeginFrame();
 		m_Graphics.Clear(clearColor);
 	}
 
@@ -30,12 +44,16 @@ namespace CMEngine::Renderer
 	void Renderer::SetCamera(const CameraComponent& camera) noexcept
 	{
 		m_Graphics.SetBuffer(m_CB_CameraProj, &camera.Matrices, sizeof(camera.Matrices));
-		m_Graphics.BindConstantBufferVS(m_CB_CameraProj, S_CB_CameraProj_Register);
+		m_StateCache.BindConstantBufferVS(m_CB_CameraProj, S_CB_CameraProj_Register);
+
+		m_BatchRenderer.SetCamera(camera);
 	}
 
 	void Renderer::Flush() noexcept
 	{
-		m_BatchRenderer.Flush();
+		/* Everything uploaded this frame has to be unmapped before it's drawn... */
+		m_UploadRing.Commit();
+		m_RenderGraph.Execute();
 	}
 
 	[[nodiscard]] bool Renderer::ImGuiWindow(const std::string_view& label) noexcept
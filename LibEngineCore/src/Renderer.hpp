@@ -4,6 +4,9 @@
 #include "Asset/AssetManager.hpp"
 #include "Platform.hpp"
 #include "BatchRenderer.hpp"
+#include "StateCache.hpp"
+#include "UploadRing.hpp"
+#include "RenderGraph.hpp"
 
 #include <array>
 #include <vector>
@@ -22,6 +25,7 @@ namespace CMEngine::Renderer
 
 		void SetCamera(const CameraComponent& camera) noexcept;
 
+		/* Executes the render graph, (compiling it first if passes were added since) */
 		void Flush() noexcept;
 
 		[[nodiscard]] bool ImGuiWindow(const std::string_view& label) noexcept;
@@ -29,11 +33,21 @@ namespace CMEngine::Renderer
 		void ImGuiText(const std::string_view& text) noexcept;
 
 		inline [[nodiscard]] BatchRenderer& GetBatchRenderer() noexcept { return m_BatchRenderer; }
+		inline [[nodiscard]] const StateCache& GetStateCache() const noexcept { return m_StateCache; }
+		inline [[nodiscard]] const UploadRing& GetUploadRing() const noexcept { return m_UploadRing; }
+
+		/* Passes drawing to the screen must write GetBackBuffer(), or they're culled. */
+		inline [[nodiscard]] RenderGraph& GetRenderGraph() noexcept { return m_RenderGraph; }
+		inline [[nodiscard]] RenderGraphResource GetBackBuffer() const noexcept { return m_RG_BackBuffer; }
 	private:
 		static constexpr uint32_t S_CB_CameraProj_Register = 0;
 		ECS::ECS& m_ECS;
 		AGraphics& m_Graphics; /* TODO: Technically, the renderer should own the GPU context, but idc rn... */
+		StateCache m_StateCache; /* Must be declared before m_BatchRenderer. */
+		UploadRing m_UploadRing; /* Per-frame vertex data, (ex. instances) must also be declared before m_BatchRenderer. */
 		BatchRenderer m_BatchRenderer;
+		RenderGraph m_RenderGraph;
+		RenderGraphResource m_RG_BackBuffer;
 		Resource<IBuffer> m_CB_CameraProj;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "PCH.hpp"
+#include "StateCache.hpp"
+
+namespace CMEngine::Renderer
+{
+	[[nodiscard]] uint32_t StateCacheStats::TotalIssued() const noexcept
+	{
+		return std::accumulate(Issued.begin(), Issued.end(), 0u);
+	}
+
+	[[nodiscard]] uint32_t StateCacheStats::TotalElided() const noexcept
+	{
+		return std::accumulate(Elided.begin(), Elided.end(), 0u);
+	}
+
+	StateCache::StateCache(IGraphics& graphics) noexcept
+		: m_Graphics(graphics),
+		  m_Epoch(graphics.StateEpoch())
+	{
+	}
+
+	void StateCache::BeginFrame() noexcept
+	{
+		m_LastFrameStats = m_FrameStats;
+		m_FrameStats = StateCacheStats();
+	}
+
+	void StateCache::Invalidate() noexcept
+	{
+		m_VertexBuffers.fill(BoundBuffer());
+		m_ConstantBuffersVS.fill(BoundBuffer());
+		m_ConstantBuffersPS.fill(BoundBuffer());
+		m_StructuredBuffersPS.fill(BoundBuffer());
+		m_IndexBuffer = BoundBuffer();
+		m_IndexFormat = DataFormat::Unspecified;
+		mP_InputLayout = nullptr;
+		mP_Texture = nullptr;
+		m_VertexShader = ShaderID();
+		m_PixelShader = ShaderID();
+		m_BlendMode = BlendMode::Unspecified;
+	}
+
+	void StateCache::BindVertexBuffer(const Resource<IBuffer>& buffer, uint32_t strideBytes, uint32_t offsetBytes, uint32_t slot) noexcept
+	{
+		CheckEpoch();
+
+		/* Out of tracked range, always forward... */
+		if (slot >= S_MaxVertexBufferSlots)
+		{
+			(void)Issue(StateKind::VertexBuffer, true);
+			m_Graphics.BindVertexBuffer(buffer, strideBytes, offsetBytes, slot);
+			return;
+		}
+
+		BoundBuffer& bound = m_VertexBuffers[slot];
+
+		if (!Issue(StateKind::VertexBuffer, BufferChanged(bound, buffer.get(), strideBytes, offsetBytes)))
+			return;
+
+		m_Graphics.BindVertexBuffer(buffer, strideBytes, offsetBytes, slot);
+		StoreBuffer(bound, buffer.get(), strideBytes, offsetBytes);
+	}
+
+	void StateCache::BindIndexBuffer(const Resource<IBuffer>& buffer, DataFormat indexFormat, uint32_t startIndex) noexcept
+	{
+		CheckEpoch();
+
+		bool changed = BufferChanged(m_IndexBuffer, buffer.get(), 0, startIndex) ||
+			indexFormat != m_IndexFormat;
+
+		if (!Issue(StateKind::IndexBuffer, changed))
+			return;
+
+		m_Graphics.BindIndexBuffer(buffer, indexFormat, startIndex);
+		StoreBuffer(m_IndexBuffer, buffer.get(), 0, startIndex);
+		m_IndexFormat = indexFormat;
+	}
+
+	void StateCache::BindInputLayout(const Resource<IInputLayout>& inputLayout) noexcept
+	{
+		CheckEpoch();
+
+		if (!Issue(StateKind::InputLayout, inputLayout.get() != mP_InputLayout))
+			return;
+
+		m_Graphics.BindInputLayout(inputLayout);
+		mP_InputLayout = inputLayout.get();
+	}
+
+	void StateCache::BindShader(ShaderID id) noexcept
+	{
+		CheckEpoch();
+
+		ShaderID* pBound = nullptr;
+
+		switch (id.Type)
+		{
+		case ShaderType::Vertex:
+			pBound = &m_VertexShader;
+			break;
+		case ShaderType::Pixel:
+			pBound = &m_PixelShader;
+			break;
+		default:
+			/* Let the backend report it... */
+			m_Graphics.BindShader(id);
+			return;
+		}
+
+		if (!Issue(StateKind::Shader, !(*pBound == id)))
+			return;
+
+		m_Graphics.BindShader(id);
+		*pBound = id;
+	}
+
+	void StateCache::BindTexture(const Resource<ITexture>& texture) noexcept
+	{
+		CheckEpoch();
+
+		if (!Issue(StateKind::Texture, texture.get() != mP_Texture))
+			return;
+
+		m_Graphics.BindTexture(texture);
+		mP_Texture = texture.get();
+	}
+
+	void StateCache::BindConstantBufferVS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		CheckEpoch();
+
+		if (slot >= S_MaxConstantBufferSlots)
+		{
+			(void)Issue(StateKind::ConstantBuffer, true);
+			m_Graphics.BindConstantBufferVS(buffer, slot);
+			return;
+		}
+
+		BoundBuffer& bound = m_ConstantBuffersVS[slot];
+
+		if (!Issue(StateKind::ConstantBuffer, BufferChanged(bound, buffer.get(), 0, 0)))
+			return;
+
+		m_Graphics.BindConstantBufferVS(buffer, slot);
+		StoreBuffer(bound, buffer.get(), 0, 0);
+	}
+
+	void StateCache::BindConstantBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		CheckEpoch();
+
+		if (slot >= S_MaxConstantBufferSlots)
+		{
+			(void)Issue(StateKind::ConstantBuffer, true);
+			m_Graphics.BindConstantBufferPS(buffer, slot);
+			return;
+		}
+
+		BoundBuffer& bound = m_ConstantBuffersPS[slot];
+
+		if (!Issue(StateKind::ConstantBuffer, BufferChanged(bound, buffer.get(), 0, 0)))
+			return;
+
+		m_Graphics.BindConstantBufferPS(buffer, slot);
+		StoreBuffer(bound, buffer.get(), 0, 0);
+	}
+
+	void StateCache::BindStructuredBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept
+	{
+		CheckEpoch();
+
+		if (slot >= S_MaxStructuredBufferSlots)
+		{
+			(void)Issue(StateKind::StructuredBuffer, true);
+			m_Graphics.BindStructuredBufferPS(buffer, slot);
+			return;
+		}
+
+		BoundBuffer& bound = m_StructuredBuffersPS[slot];
+
+		/* A re-created structured buffer also has a new view, which Revision covers. */
+		if (!Issue(StateKind::StructuredBuffer, BufferChanged(bound, buffer.get(), 0, 0)))
+			return;
+
+		m_Graphics.BindStructuredBufferPS(buffer, slot);
+		StoreBuffer(bound, buffer.get(), 0, 0);
+	}
+
+	void StateCache::BindBlendMode(BlendMode mode) noexcept
+	{
+		CheckEpoch();
+
+		if (!Issue(StateKind::BlendMode, mode != m_BlendMode))
+			return;
+
+		m_Graphics.BindBlendMode(mode);
+		m_BlendMode = mode;
+	}
+
+	void StateCache::CheckEpoch() noexcept
+	{
+		uint32_t epoch = m_Graphics.StateEpoch();
+
+		if (epoch == m_Epoch)
+			return;
+
+		Invalidate();
+		m_Epoch = epoch;
+	}
+
+	[[nodiscard]] bool StateCache::Issue(StateKind kind, bool changed) noexcept
+	{
+		size_t index = static_cast<size_t>(kind);
+
+		if (changed)
+			++m_FrameStats.Issued[index];
+		else
+			++m_FrameStats.Elided[index];
+
+		return changed;
+	}
+
+	[[nodiscard]] bool StateCache::BufferChanged(const BoundBuffer& bound, const IBuffer* pBuffer, uint32_t strideBytes, uint32_t offsetBytes) noexcept
+	{
+		/* Nothing bound yet, or unbinding... */
+		if (pBuffer == nullptr || bound.pBuffer == nullptr)
+			return true;
+
+		return bound.pBuffer != pBuffer ||
+			bound.Revision != pBuffer->Revision() ||
+			bound.StrideBytes != strideBytes ||
+			bound.OffsetBytes != offsetBytes;
+	}
+
+	void StateCache::StoreBuffer(BoundBuffer& bound, const IBuffer* pBuffer, uint32_t strideBytes, uint32_t offsetBytes) noexcept
+	{
+		bound.pBuffer = pBuffer;
+		bound.Revision = pBuffer != nullptr ? pBuffer->Revision() : 0;
+		bound.StrideBytes = strideBytes;
+		bound.OffsetBytes = offsetBytes;
+	}
+}
\ No newline at end of file
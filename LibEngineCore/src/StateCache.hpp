@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Platform/Core/IGraphics.hpp"
+
+#include <cstdint>
+#include <array>
+
+namespace CMEngine::Renderer
+{
+	enum class StateKind : uint8_t
+	{
+		VertexBuffer,
+		IndexBuffer,
+		InputLayout,
+		Shader,
+		Texture,
+		ConstantBuffer,
+		StructuredBuffer,
+		BlendMode,
+		Total
+	};
+
+	inline constexpr [[nodiscard]] const char* StateKindToString(StateKind kind) noexcept
+	{
+		switch (kind)
+		{
+		case StateKind::VertexBuffer:     return "VertexBuffer";
+		case StateKind::IndexBuffer:      return "IndexBuffer";
+		case StateKind::InputLayout:      return "InputLayout";
+		case StateKind::Shader:           return "Shader";
+		case StateKind::Texture:          return "Texture";
+		case StateKind::ConstantBuffer:   return "ConstantBuffer";
+		case StateKind::StructuredBuffer: return "StructuredBuffer";
+		case StateKind::BlendMode:        return "BlendMode";
+		default:                          return "Invalid";
+		}
+	}
+
+	struct StateCacheStats
+	{
+		static constexpr size_t S_NumKinds = static_cast<size_t>(StateKind::Total);
+
+		std::array<uint32_t, S_NumKinds> Issued = {};
+		std::array<uint32_t, S_NumKinds> Elided = {};
+
+		inline [[nodiscard]] uint32_t NumIssued(StateKind kind) const noexcept { return Issued[static_cast<size_t>(kind)]; }
+		inline [[nodiscard]] uint32_t NumElided(StateKind kind) const noexcept { return Elided[static_cast<size_t>(kind)]; }
+		[[nodiscard]] uint32_t TotalIssued() const noexcept;
+		[[nodiscard]] uint32_t TotalElided() const noexcept;
+	};
+
+	/* Sits in front of IGraphics, remembering what is currently bound per slot,
+	 *   and drops any bind that wouldn't change anything before it reaches the backend.
+	 *
+	 * Buffers are compared by both identity and IBuffer::Revision, since a re-created buffer
+	 *   has to be re-bound. Everything is forgotten once IGraphics::StateEpoch changes.
+	 *
+	 * NOTE: Anything bound directly through IGraphics bypasses the cache, so mixing the two
+	 *   for the same slot requires calling Invalidate afterwards. */
+	class StateCache
+	{
+	public:
+		StateCache(IGraphics& graphics) noexcept;
+		~StateCache() = default;
+	public:
+		/* Rolls the current frame's counters into LastFrameStats. */
+		void BeginFrame() noexcept;
+
+		/* Forgets all bound state, so the next bind of every kind is issued. */
+		void Invalidate() noexcept;
+
+		void BindVertexBuffer(const Resource<IBuffer>& buffer, uint32_t strideBytes, uint32_t offsetBytes, uint32_t slot) noexcept;
+		void BindIndexBuffer(const Resource<IBuffer>& buffer, DataFormat indexFormat, uint32_t startIndex) noexcept;
+		void BindInputLayout(const Resource<IInputLayout>& inputLayout) noexcept;
+		void BindShader(ShaderID id) noexcept;
+		void BindTexture(const Resource<ITexture>& texture) noexcept;
+		void BindConstantBufferVS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept;
+		void BindConstantBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept;
+		void BindStructuredBufferPS(const Resource<IBuffer>& buffer, uint32_t slot) noexcept;
+		void BindBlendMode(BlendMode mode) noexcept;
+
+		inline [[nodiscard]] const StateCacheStats& FrameStats() const noexcept { return m_FrameStats; }
+		inline [[nodiscard]] const StateCacheStats& LastFrameStats() const noexcept { return m_LastFrameStats; }
+	private:
+		struct BoundBuffer
+		{
+			const IBuffer* pBuffer = nullptr;
+			uint32_t Revision = 0;
+			uint32_t StrideBytes = 0;
+			uint32_t OffsetBytes = 0;
+		};
+
+		void CheckEpoch() noexcept;
+
+		/* Returns true (and counts the bind as issued) if the bind has to reach the backend. */
+		[[nodiscard]] bool Issue(StateKind kind, bool changed) noexcept;
+
+		[[nodiscard]] static bool BufferChanged(const BoundBuffer& bound, const IBuffer* pBuffer, uint32_t strideBytes, uint32_t offsetBytes) noexcept;
+		static void StoreBuffer(BoundBuffer& bound, const IBuffer* pBuffer, uint32_t strideBytes, uint32_t offsetBytes) noexcept;
+	private:
+		static constexpr uint32_t S_MaxVertexBufferSlots = 16; /* D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT is 32, but nothing uses more than 2. */
+		static constexpr uint32_t S_MaxConstantBufferSlots = 14; /* D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT */
+		static constexpr uint32_t S_MaxStructuredBufferSlots = 16; /* Of D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT's 128. */
+		IGraphics& m_Graphics;
+		std::array<BoundBuffer, S_MaxVertexBufferSlots> m_VertexBuffers = {};
+		std::array<BoundBuffer, S_MaxConstantBufferSlots> m_ConstantBuffersVS = {};
+		std::array<BoundBuffer, S_MaxConstantBufferSlots> m_ConstantBuffersPS = {};
+		std::array<BoundBuffer, S_MaxStructuredBufferSlots> m_StructuredBuffersPS = {};
+		BoundBuffer m_IndexBuffer = {};
+		DataFormat m_IndexFormat = DataFormat::Unspecified;
+		const IInputLayout* mP_InputLayout = nullptr;
+		const ITexture* mP_Texture = nullptr;
+		ShaderID m_VertexShader;
+		ShaderID m_PixelShader;
+		BlendMode m_BlendMode = BlendMode::Unspecified;
+		StateCacheStats m_FrameStats;
+		StateCacheStats m_LastFrameStats;
+		uint32_t m_Epoch = 0;
+	};
+}
\ No newline at end of file
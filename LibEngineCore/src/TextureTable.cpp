@@ -0,0 +1,193 @@
+#include "PCH.hpp"
+#include "TextureTable.hpp"
+#include "Log.hpp"
+
+namespace CMEngine::Renderer
+{
+	TextureTable::TextureTable(IGraphics& graphics, Asset::AssetManager& assetManager) noexcept
+		: m_Graphics(graphics),
+		  m_AssetManager(assetManager)
+	{
+	}
+
+	[[nodiscard]] TextureSlot TextureTable::Register(Asset::AssetID textureID) noexcept
+	{
+		if (auto it = m_Slots.find(textureID); it != m_Slots.end())
+			return it->second;
+
+		ConstView<Asset::Texture> textureAsset;
+		m_AssetManager.GetTexture(textureID, textureAsset);
+
+		if (textureAsset.Null())
+			return TextureSlot();
+
+		Resource<ITexture> texture = m_Graphics.CreateTexture(textureAsset->Bytes());
+
+		/* Decoded (or failed to) straight from the mapped file, which isn't needed anymore... */
+		m_AssetManager.ReleaseTextureData(textureID);
+
+		/* Remember the failure, so the texture isn't decoded again every submission... */
+		if (!texture)
+		{
+			m_Slots.emplace(textureID, TextureSlot());
+			return TextureSlot();
+		}
+
+		uint32_t width = texture->Width();
+		uint32_t height = texture->Height();
+		uint32_t numMips = texture->NumMips();
+		TextureFormat format = texture->Format();
+
+		/* Released slices are reused first, otherwise any page of this layout that still has room... */
+		auto hasRoom = [&](const Page& page)
+			{
+				return page.Width == width &&
+					page.Height == height &&
+					page.NumMips == numMips &&
+					page.Format == format &&
+					(!page.FreeSlices.empty() || page.NumSlices < S_MaxSlicesPerPage);
+			};
+
+		auto pageIt = std::find_if(m_Pages.begin(), m_Pages.end(), [&](const Page& page) { return hasRoom(page) && !page.FreeSlices.empty(); });
+
+		if (pageIt == m_Pages.end())
+			pageIt = std::find_if(m_Pages.begin(), m_Pages.end(), hasRoom);
+
+		if (pageIt == m_Pages.end())
+			pageIt = std::find_if(m_Pages.begin(), m_Pages.end(), [](const Page& page) { return page.Width == 0; });
+
+		if (pageIt == m_Pages.end())
+		{
+			if (m_Pages.size() >= TextureSlot::S_InvalidPage)
+			{
+				CM_ENGINE_LOG_WARN(
+					"(TextureTable) Internal warning: Texture table is full, the texture is ignored. Max pages: {}",
+					TextureSlot::S_InvalidPage
+				);
+
+				return TextureSlot();
+			}
+
+			m_Pages.emplace_back();
+			pageIt = std::prev(m_Pages.end());
+		}
+
+		Page& page = *pageIt;
+
+		if (page.Width == 0)
+		{
+			page.Width = width;
+			page.Height = height;
+			page.NumMips = numMips;
+			page.Format = format;
+		}
+
+		TextureSlot slot;
+		slot.Page = static_cast<uint16_t>(std::distance(m_Pages.begin(), pageIt));
+
+		if (!page.FreeSlices.empty())
+		{
+			slot.Slice = page.FreeSlices.back();
+			page.FreeSlices.pop_back();
+		}
+		else
+			slot.Slice = static_cast<uint16_t>(page.NumSlices++);
+
+		++page.NumTextures;
+		page.Pending.emplace_back(PendingSlice{ slot.Slice, std::move(texture) });
+
+		m_Slots.emplace(textureID, slot);
+		return slot;
+	}
+
+	void TextureTable::Release(Asset::AssetID textureID) noexcept
+	{
+		auto it = m_Slots.find(textureID);
+
+		if (it == m_Slots.end())
+			return;
+
+		TextureSlot slot = it->second;
+		m_Slots.erase(it);
+
+		/* Failed to decode, never had a page... */
+		if (!slot.IsValid())
+			return;
+
+		Page& page = m_Pages[slot.Page];
+
+		std::erase_if(page.Pending, [&](const PendingSlice& pending) { return pending.Slice == slot.Slice; });
+
+		if (--page.NumTextures > 0)
+		{
+			page.FreeSlices.emplace_back(slot.Slice);
+			return;
+		}
+
+		/* Kept in m_Pages, as the other slots' page indices have to stay valid... */
+		page = Page();
+	}
+
+	void TextureTable::Update() noexcept
+	{
+		std::vector<const ITexture*> slices;
+
+		for (Page& page : m_Pages)
+		{
+			if (page.Pending.empty())
+				continue;
+
+			/* Out of room, the old array's slices are copied into a new one on the GPU... */
+			if (!page.Array || page.NumSlices > page.Capacity)
+			{
+				uint32_t capacity = std::max(S_MinPageCapacity, page.Capacity * 2);
+
+				while (capacity < page.NumSlices)
+					capacity *= 2;
+
+				capacity = std::min(capacity, S_MaxSlicesPerPage);
+
+				Resource<ITexture> array = m_Graphics.CreateTextureArray(*page.Pending.front().Texture, capacity, page.Array.get());
+
+				/* Already warned about, the old array is kept, and the pending textures are dropped rather than retried every frame... */
+				if (!array)
+				{
+					page.Pending.clear();
+					continue;
+				}
+
+				page.Array = std::move(array);
+				page.Capacity = capacity;
+
+				++m_NumRebuilds;
+			}
+
+			/* Reused slices can be anywhere, so each run of consecutive slices is copied in at once... */
+			std::sort(
+				page.Pending.begin(),
+				page.Pending.end(),
+				[](const PendingSlice& lhs, const PendingSlice& rhs) { return lhs.Slice < rhs.Slice; }
+			);
+
+			for (size_t first = 0; first < page.Pending.size();)
+			{
+				size_t last = first + 1;
+
+				while (last < page.Pending.size() && page.Pending[last].Slice == page.Pending[last - 1].Slice + 1)
+					++last;
+
+				slices.clear();
+				for (size_t i = first; i < last; ++i)
+					slices.emplace_back(page.Pending[i].Texture.get());
+
+				/* Only fails on textures of another layout, which Register never pages together... */
+				(void)m_Graphics.CopyTextureArraySlices(page.Array, page.Pending[first].Slice, slices);
+
+				first = last;
+			}
+
+			/* Copied into the array, so they'd otherwise just be a second copy of each texture in VRAM... */
+			page.Pending.clear();
+		}
+	}
+}
\ No newline at end of file
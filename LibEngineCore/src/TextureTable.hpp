@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Platform/Core/IGraphics.hpp"
+#include "Asset/AssetManager.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+namespace CMEngine::Renderer
+{
+	/* Where a registered texture is sampled from, slice Slice of page Page's texture array. */
+	struct TextureSlot
+	{
+		static constexpr uint16_t S_InvalidPage = ~static_cast<uint16_t>(0);
+
+		uint16_t Page = S_InvalidPage;
+		uint16_t Slice = 0;
+
+		inline [[nodiscard]] bool IsValid() const noexcept { return Page != S_InvalidPage; }
+	};
+
+	/* Packs textures into texture arrays, one (or more, once full) per texture size, so instances that
+	 *   only differ by texture can be drawn together, each indexing it's own slice. Cooked textures
+	 *   (see Asset::CookTexture) are only ever paged with others of the same format and mip count.
+	 *
+	 * Each texture is decoded once on registration, and only kept until the next Update copies it into it's page.
+	 *   A page's array has room for more slices than it holds, (doubling each time it's outgrown) so adding a texture
+	 *   usually only copies that texture, and otherwise only the old array's slices on the GPU.
+	 *
+	 * Released textures free their slice for the next texture of the same layout, and a page without any textures
+	 *   left releases it's array, to be reused by whichever layout needs a page next. */
+	class TextureTable
+	{
+	public:
+		TextureTable(IGraphics& graphics, Asset::AssetManager& assetManager) noexcept;
+		~TextureTable() = default;
+	public:
+		/* Returns the texture's slot, adding it if it isn't already present. The slot can be used straight away,
+		 *   but the page is only rebuilt on the next Update. Returns an invalid slot if the texture doesn't exist. */
+		[[nodiscard]] TextureSlot Register(Asset::AssetID textureID) noexcept;
+
+		/* Frees the texture's slot, (if registered) so it shouldn't be sampled from anymore. Registering it again
+		 *   decodes it again. */
+		void Release(Asset::AssetID textureID) noexcept;
+
+		/* Copies every texture added since the last call into it's page's array, recreating it if it's out of room. */
+		void Update() noexcept;
+
+		/* nullptr until the page is first built. */
+		inline [[nodiscard]] const Resource<ITexture>& GetPage(uint16_t page) const noexcept { return m_Pages[page].Array; }
+
+		inline [[nodiscard]] size_t NumTextures() const noexcept { return m_Slots.size(); } /* Including any that failed to decode. */
+		inline [[nodiscard]] size_t NumPages() const noexcept { return m_Pages.size(); } /* Including unused ones. */
+		inline [[nodiscard]] uint32_t NumRebuilds() const noexcept { return m_NumRebuilds; }
+	private:
+		struct PendingSlice
+		{
+			uint32_t Slice = 0;
+			Resource<ITexture> Texture; /* Decoded, but not yet copied into the page's array. */
+		};
+
+		/* Unused (of no layout) while Width is 0. */
+		struct Page
+		{
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+			uint32_t NumMips = 0;
+			TextureFormat Format = TextureFormat::Unknown;
+			uint32_t NumSlices = 0; /* One past the last slice ever handed out, including pending ones. */
+			uint32_t NumTextures = 0; /* Slots currently in the page. */
+			uint32_t Capacity = 0; /* Of Array. */
+			std::vector<uint16_t> FreeSlices; /* Below NumSlices, of released textures. */
+			std::vector<PendingSlice> Pending;
+			Resource<ITexture> Array;
+		};
+	private:
+		static constexpr uint32_t S_MaxSlicesPerPage = 2048; /* D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION */
+		static constexpr uint32_t S_MinPageCapacity = 8;
+		IGraphics& m_Graphics;
+		Asset::AssetManager& m_AssetManager;
+		std::vector<Page> m_Pages;
+		std::unordered_map<Asset::AssetID, TextureSlot> m_Slots;
+		uint32_t m_NumRebuilds = 0; /* Of a page's array, since construction. */
+	};
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "PCH.hpp"
+#include "ThreadPool.hpp"
+#include "Macros.hpp"
+
+namespace CMEngine
+{
+	ThreadPool::ThreadPool(uint32_t numThreads) noexcept
+	{
+		CM_ENGINE_ASSERT(numThreads != 0);
+
+		m_Threads.reserve(numThreads);
+
+		for (uint32_t i = 0; i < numThreads; ++i)
+			m_Threads.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	ThreadPool::~ThreadPool() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+			m_Jobs.clear();
+		}
+
+		m_JobAvailable.notify_all();
+
+		for (std::thread& thread : m_Threads)
+			thread.join();
+	}
+
+	void ThreadPool::Submit(std::function<void()> job) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Jobs.emplace_back(std::move(job));
+		}
+
+		m_JobAvailable.notify_one();
+	}
+
+	[[nodiscard]] uint32_t ThreadPool::DefaultThreadCount() noexcept
+	{
+		/* hardware_concurrency may return 0 if it can't be determined... */
+		uint32_t numHardwareThreads = std::thread::hardware_concurrency();
+
+		return numHardwareThreads > 1 ? numHardwareThreads - 1 : 1;
+	}
+
+	void ThreadPool::WorkerLoop() noexcept
+	{
+		while (true)
+		{
+			std::function<void()> job;
+
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_JobAvailable.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+
+				if (m_Stopping)
+					return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CMEngine
+{
+	/* A fixed set of worker threads, running submitted jobs in the order they were submitted.
+	 *
+	 * For long running background work, (ex. asset loading) as opposed to std::execution::par,
+	 *   which is used for short parallel loops that the caller waits on.
+	 *
+	 * NOTE: Jobs still queued on destruction are dropped, but jobs already running are waited on. */
+	class ThreadPool
+	{
+	public:
+		ThreadPool(uint32_t numThreads = DefaultThreadCount()) noexcept;
+		~ThreadPool() noexcept;
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+	public:
+		void Submit(std::function<void()> job) noexcept;
+
+		inline [[nodiscard]] uint32_t NumThreads() const noexcept { return static_cast<uint32_t>(m_Threads.size()); }
+
+		/* Every hardware thread but the caller's, (at least 1) */
+		static [[nodiscard]] uint32_t DefaultThreadCount() noexcept;
+	private:
+		void WorkerLoop() noexcept;
+	private:
+		std::vector<std::thread> m_Threads;
+		std::deque<std::function<void()>> m_Jobs;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		bool m_Stopping = false;
+	};
+}
\ No newline at end of file
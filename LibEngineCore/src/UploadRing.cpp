@@ -0,0 +1,119 @@
+#include "PCH.hpp"
+#include "UploadRing.hpp"
+#include "Log.hpp"
+
+#include <bit>
+
+namespace CMEngine::Renderer
+{
+	UploadRing::UploadRing(IGraphics& graphics, GPUBufferType type, size_t capacityBytes) noexcept
+		: m_Graphics(graphics),
+		  m_CapacityBytes(capacityBytes)
+	{
+		CM_ENGINE_ASSERT(capacityBytes != 0);
+
+		m_Buffer = m_Graphics.CreateBuffer(type, GPUBufferFlag::Dynamic);
+		m_Graphics.ReserveBuffer(m_Buffer, m_CapacityBytes);
+
+		m_FrameStats.CapacityBytes = m_CapacityBytes;
+	}
+
+	void UploadRing::BeginFrame() noexcept
+	{
+		/* Anything still mapped is the previous frame's, which is done writing... */
+		Commit();
+
+		if (m_RequiredBytes != 0)
+			Grow();
+
+		++m_Frame;
+
+		/* The frame that last used this slot is S_FramesInFlight frames old, so the GPU is done with it. */
+		size_t& retired = m_FrameBytes[m_Frame % S_FramesInFlight];
+		m_UsedBytes -= retired;
+		retired = 0;
+
+		m_LastFrameStats = m_FrameStats;
+		m_FrameStats = UploadRingStats();
+		m_FrameStats.NumGrows = m_LastFrameStats.NumGrows;
+		m_FrameStats.CapacityBytes = m_CapacityBytes;
+	}
+
+	[[nodiscard]] UploadAllocation UploadRing::Allocate(size_t numBytes, size_t alignmentBytes) noexcept
+	{
+		CM_ENGINE_ASSERT(numBytes != 0);
+		CM_ENGINE_ASSERT(std::has_single_bit(alignmentBytes));
+
+		size_t offset = (m_Head + alignmentBytes - 1) & ~(alignmentBytes - 1);
+
+		/* Doesn't fit before the end, so the rest of the buffer is skipped and counted towards this frame... */
+		if (offset + numBytes > m_CapacityBytes)
+			offset = 0;
+
+		size_t paddingBytes = offset >= m_Head ? offset - m_Head : m_CapacityBytes - m_Head;
+		size_t totalBytes = paddingBytes + numBytes;
+
+		/* Would overwrite something the GPU may still be reading... */
+		if (m_UsedBytes + totalBytes > m_CapacityBytes)
+		{
+			++m_FrameStats.NumOverflows;
+			m_RequiredBytes = std::max(m_RequiredBytes, numBytes);
+			return UploadAllocation();
+		}
+
+		if (mP_Mapped == nullptr)
+		{
+			BufferMapMode mode = m_NeedsDiscard ? BufferMapMode::Discard : BufferMapMode::NoOverwrite;
+			mP_Mapped = static_cast<std::byte*>(m_Graphics.MapBuffer(m_Buffer, mode));
+
+			if (mP_Mapped == nullptr)
+			{
+				CM_ENGINE_LOG_WARN("(UploadRing) Internal warning: Failed to map the ring's buffer.");
+				return UploadAllocation();
+			}
+
+			m_NeedsDiscard = false;
+			++m_FrameStats.NumMaps;
+		}
+
+		m_Head = offset + numBytes;
+		m_UsedBytes += totalBytes;
+		m_FrameBytes[m_Frame % S_FramesInFlight] += totalBytes;
+
+		++m_FrameStats.NumAllocations;
+		m_FrameStats.AllocatedBytes += totalBytes;
+
+		UploadAllocation allocation;
+		allocation.pData = mP_Mapped + offset;
+		allocation.OffsetBytes = static_cast<uint32_t>(offset);
+		allocation.SizeBytes = static_cast<uint32_t>(numBytes);
+
+		return allocation;
+	}
+
+	void UploadRing::Commit() noexcept
+	{
+		if (mP_Mapped == nullptr)
+			return;
+
+		m_Graphics.UnmapBuffer(m_Buffer);
+		mP_Mapped = nullptr;
+	}
+
+	void UploadRing::Grow() noexcept
+	{
+		/* A re-created buffer is a new resource, so nothing in flight is affected and the ring starts over. */
+		size_t capacityBytes = std::bit_ceil(std::max(m_CapacityBytes * 2, m_RequiredBytes));
+
+		m_Graphics.ReserveBuffer(m_Buffer, capacityBytes);
+
+		m_CapacityBytes = capacityBytes;
+		m_Head = 0;
+		m_UsedBytes = 0;
+		m_RequiredBytes = 0;
+		m_FrameBytes.fill(0);
+		m_NeedsDiscard = true;
+
+		++m_FrameStats.NumGrows;
+	}
+}
\ No newline at end of file
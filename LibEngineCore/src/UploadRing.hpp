@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Platform/Core/IGraphics.hpp"
+
+#include <cstdint>
+#include <array>
+
+namespace CMEngine::Renderer
+{
+	/* A sub-allocation of an UploadRing, only writable until the ring is committed. */
+	struct UploadAllocation
+	{
+		void* pData = nullptr;
+		uint32_t OffsetBytes = 0;
+		uint32_t SizeBytes = 0;
+
+		inline [[nodiscard]] bool IsValid() const noexcept { return pData != nullptr; }
+	};
+
+	struct UploadRingStats
+	{
+		uint32_t NumAllocations = 0;
+		uint32_t NumMaps = 0;
+		uint32_t NumOverflows = 0; /* Allocations that didn't fit, which grows the ring next frame. */
+		uint32_t NumGrows = 0;     /* Since construction. */
+		size_t AllocatedBytes = 0; /* Including alignment and wrap padding. */
+		size_t CapacityBytes = 0;
+	};
+
+	/* A single Dynamic buffer that per-frame data is packed into, and bound by offset.
+	 *
+	 * Every allocation of a frame is written through one mapping, (D3D11_MAP_WRITE_NO_OVERWRITE on WinImpl)
+	 *   instead of discarding a whole buffer per upload. The GPU is assumed to trail the CPU by at most
+	 *   S_FramesInFlight - 1 frames, so a frame's allocations are only reused S_FramesInFlight BeginFrame's later.
+	 *
+	 * An allocation that doesn't fit fails rather than overwriting anything in flight, and the ring is
+	 *   re-created large enough for it on the next BeginFrame. */
+	class UploadRing
+	{
+	public:
+		UploadRing(IGraphics& graphics, GPUBufferType type, size_t capacityBytes = S_DefaultCapacityBytes) noexcept;
+		~UploadRing() = default;
+	public:
+		/* Retires the oldest frame's allocations, and rolls the current frame's counters into LastFrameStats. */
+		void BeginFrame() noexcept;
+
+		/* Returns an invalid allocation if @numBytes doesn't fit. @alignmentBytes must be a power of 2. */
+		[[nodiscard]] UploadAllocation Allocate(size_t numBytes, size_t alignmentBytes = S_DefaultAlignmentBytes) noexcept;
+
+		/* Unmaps the ring. Must be called after a frame's allocations are written, and before anything reading them is drawn. */
+		void Commit() noexcept;
+
+		inline [[nodiscard]] const Resource<IBuffer>& Buffer() const noexcept { return m_Buffer; }
+
+		inline [[nodiscard]] const UploadRingStats& FrameStats() const noexcept { return m_FrameStats; }
+		inline [[nodiscard]] const UploadRingStats& LastFrameStats() const noexcept { return m_LastFrameStats; }
+	public:
+		static constexpr size_t S_DefaultCapacityBytes = 4 * 1024 * 1024;
+		static constexpr size_t S_DefaultAlignmentBytes = 16;
+		static constexpr uint32_t S_FramesInFlight = 4; /* DXGI's default maximum frame latency of 3, plus the frame being recorded. */
+	private:
+		void Grow() noexcept;
+	private:
+		IGraphics& m_Graphics;
+		Resource<IBuffer> m_Buffer;
+		std::array<size_t, S_FramesInFlight> m_FrameBytes = {}; /* Bytes each in-flight frame occupies, indexed by frame % S_FramesInFlight. */
+		std::byte* mP_Mapped = nullptr;
+		size_t m_CapacityBytes = 0;
+		size_t m_Head = 0;
+		size_t m_UsedBytes = 0; /* Of every in-flight frame. */
+		size_t m_RequiredBytes = 0; /* Of the largest overflowing allocation this frame. */
+		uint64_t m_Frame = 0;
+		UploadRingStats m_FrameStats;
+		UploadRingStats m_LastFrameStats;
+		bool m_NeedsDiscard = true; /* The first map of a (re-)created buffer discards. */
+	};
+}
\ No newline at end of file
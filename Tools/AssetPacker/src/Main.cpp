@@ -0,0 +1,336 @@
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetPack.hpp"
+#include "Asset/CookedMesh.hpp"
+
+#include <assimp/Importer.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Packs an asset directory into a single .cmpak, (see AssetPack.hpp) which the engine mounts with AssetManager::MountPack.
+ *
+ * Models are cooked into .cmmesh's first, (see CookedMesh.hpp) and with --cook-textures images are cooked into .dds's,
+ *   (see TextureCooker.hpp) both kept under their source's path so loads don't have to change. Everything else is packed as is.
+ *
+ * --benchmark instead loads everything in the directory twice from loose files, and then twice from the pack.
+ *   The first pass is only cold if the OS's file cache has been flushed before running it. */
+
+namespace CMEngine::Tools
+{
+	inline constexpr std::wstring_view G_WorkingDirectoryName = L"AssetPacker";
+
+	/* What WIC can decode. (see ImageDecoder_WinImpl.hpp) */
+	inline constexpr std::string_view G_TextureExtensions[] = { ".png", ".jpg", ".jpeg", ".bmp", ".tif", ".tiff", ".gif" };
+
+	enum class FileKind : uint8_t
+	{
+		Other,
+		Model,
+		CookedModel,
+		Texture,
+		CookedTexture
+	};
+
+	struct PackerArgs
+	{
+		std::filesystem::path AssetDirectory;
+		std::filesystem::path PackPath;
+		Asset::ImportOptions Options;
+		bool Compress = false;
+		bool CookTextures = false;
+		bool IsBenchmark = false;
+	};
+
+	struct PackerFile
+	{
+		std::filesystem::path Path;
+		std::filesystem::path Key;
+		FileKind Kind = FileKind::Other;
+	};
+
+	static void PrintUsage() noexcept
+	{
+		std::cout <<
+			"Usage: AssetPacker <asset directory> <output .cmpak> [options]\n"
+			"       AssetPacker --benchmark <asset directory> <.cmpak> [model options]\n"
+			"\n"
+			"  --compress           LZ4 compress every file, (each is only kept compressed if that's smaller)\n"
+			"  --cook-textures      Cook images into mipped, block compressed .dds's before packing them.\n"
+			"\n"
+			"Model options, (models are cooked with these, so they're fixed once packed)\n"
+			"  --no-optimize        See ImportOptions::OptimizeMeshes.\n"
+			"  --no-lods            See ImportOptions::GenerateLODs.\n"
+			"  --build-meshlets     See ImportOptions::BuildMeshlets.\n"
+			"  --quantize-vertices  See ImportOptions::QuantizeVertices.\n";
+	}
+
+	static [[nodiscard]] bool ParseArgs(int argc, char** argv, PackerArgs& outArgs) noexcept
+	{
+		std::vector<std::string_view> positional;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+
+			if (arg == "--benchmark")
+				outArgs.IsBenchmark = true;
+			else if (arg == "--compress")
+				outArgs.Compress = true;
+			else if (arg == "--cook-textures")
+				outArgs.CookTextures = true;
+			else if (arg == "--no-optimize")
+				outArgs.Options.OptimizeMeshes = false;
+			else if (arg == "--no-lods")
+				outArgs.Options.GenerateLODs = false;
+			else if (arg == "--build-meshlets")
+				outArgs.Options.BuildMeshlets = true;
+			else if (arg == "--quantize-vertices")
+				outArgs.Options.QuantizeVertices = true;
+			else if (arg.starts_with("--"))
+			{
+				std::cout << std::format("Unknown option: {}\n", arg);
+				return false;
+			}
+			else
+				positional.emplace_back(arg);
+		}
+
+		if (positional.size() != 2)
+			return false;
+
+		outArgs.AssetDirectory = positional[0];
+		outArgs.PackPath = positional[1];
+
+		return true;
+	}
+
+	static [[nodiscard]] FileKind ClassifyFile(const std::filesystem::path& path, const Assimp::Importer& importer) noexcept
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+		if (extension.empty())
+			return FileKind::Other;
+		else if (path.extension() == Asset::G_CookedMeshExtension)
+			return FileKind::CookedModel;
+		else if (path.extension() == Asset::G_CookedTextureExtension)
+			return FileKind::CookedTexture;
+		else if (std::find(std::begin(G_TextureExtensions), std::end(G_TextureExtensions), extension) != std::end(G_TextureExtensions))
+			return FileKind::Texture;
+		else if (importer.IsExtensionSupported(extension))
+			return FileKind::Model;
+
+		return FileKind::Other;
+	}
+
+	/* Sorted by path, so the same directory always packs the same. */
+	static [[nodiscard]] std::vector<PackerFile> CollectFiles(const std::filesystem::path& assetDirectory) noexcept
+	{
+		std::vector<PackerFile> files;
+		Assimp::Importer importer;
+		std::error_code error;
+
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(assetDirectory, error))
+		{
+			if (!entry.is_regular_file(error) || entry.path().extension() == Asset::G_AssetPackExtension)
+				continue;
+
+			PackerFile& file = files.emplace_back();
+			file.Path = entry.path();
+			file.Key = entry.path().lexically_relative(assetDirectory);
+			file.Kind = ClassifyFile(entry.path(), importer);
+		}
+
+		std::sort(files.begin(), files.end(), [](const PackerFile& a, const PackerFile& b) { return a.Key < b.Key; });
+		return files;
+	}
+
+	static [[nodiscard]] int Pack(const PackerArgs& args, const std::vector<PackerFile>& files) noexcept
+	{
+		std::error_code error;
+		std::filesystem::path workingDirectory = std::filesystem::temp_directory_path(error) / G_WorkingDirectoryName;
+		std::filesystem::create_directories(workingDirectory, error);
+
+		if (error)
+		{
+			std::cout << std::format("Failed to create working directory. Path: {}\n", workingDirectory.generic_string());
+			return 1;
+		}
+
+		Asset::AssetManager assetManager;
+		std::vector<Asset::PackSource> sources;
+		sources.reserve(files.size());
+
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			const PackerFile& file = files[i];
+
+			Asset::PackSource& source = sources.emplace_back();
+			source.Key = file.Key;
+			source.FilePath = file.Path;
+			source.Compress = args.Compress;
+
+			Asset::Result result = Asset::ResultType::Succeeded;
+
+			/* Cooked under their index, as different directories may well hold files of the same name... */
+			if (file.Kind == FileKind::Model)
+			{
+				source.FilePath = workingDirectory / std::to_string(i);
+				source.FilePath += Asset::G_CookedMeshExtension;
+				result = assetManager.CookModel(file.Path, source.FilePath, args.Options);
+			}
+			else if (file.Kind == FileKind::Texture && args.CookTextures)
+			{
+				source.FilePath = workingDirectory / std::to_string(i);
+				source.FilePath += Asset::G_CookedTextureExtension;
+				result = assetManager.CookTexture(file.Path, source.FilePath);
+			}
+
+			if (!result)
+			{
+				std::cout << std::format("Failed to cook file. Path: {}, Result: {}\n", file.Path.generic_string(), result.ToStringView());
+				return 1;
+			}
+
+			std::cout << std::format("Packing {}\n", file.Key.generic_string());
+		}
+
+		bool isWritten = Asset::WritePack(args.PackPath, sources);
+		std::filesystem::remove_all(workingDirectory, error);
+
+		if (!isWritten)
+		{
+			std::cout << std::format("Failed to write pack. Path: {}\n", args.PackPath.generic_string());
+			return 1;
+		}
+
+		std::cout << std::format(
+			"Packed {} files into {}. ({} bytes)\n",
+			sources.size(), args.PackPath.generic_string(), std::filesystem::file_size(args.PackPath, error)
+		);
+
+		return 0;
+	}
+
+	struct BenchmarkPass
+	{
+		double Millis = 0.0;
+		uint32_t NumLoaded = 0;
+		uint64_t NumBytes = 0; /* Of textures. */
+	};
+
+	/* Loads every model and texture once, touching every page of each texture as uploading it would. */
+	static [[nodiscard]] BenchmarkPass LoadAll(Asset::AssetManager& assetManager, const PackerArgs& args, const std::vector<PackerFile>& files) noexcept
+	{
+		BenchmarkPass pass;
+		volatile uint8_t sink = 0;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (const PackerFile& file : files)
+		{
+			Asset::AssetID id;
+
+			if (file.Kind == FileKind::Model || file.Kind == FileKind::CookedModel)
+			{
+				if (!assetManager.LoadModel(file.Path, id, args.Options))
+					continue;
+			}
+			else if (file.Kind == FileKind::Texture || file.Kind == FileKind::CookedTexture)
+			{
+				if (!assetManager.LoadTexture(file.Path, id))
+					continue;
+
+				ConstView<Asset::Texture> texture;
+				assetManager.GetTexture(id, texture);
+
+				std::span<const std::byte> bytes = texture->Bytes();
+
+				for (size_t offset = 0; offset < bytes.size(); offset += 4096)
+					sink = sink + static_cast<uint8_t>(bytes[offset]);
+
+				pass.NumBytes += bytes.size();
+			}
+			else
+				continue;
+
+			assetManager.Release(id);
+			++pass.NumLoaded;
+		}
+
+		pass.Millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return pass;
+	}
+
+	static [[nodiscard]] int Benchmark(const PackerArgs& args, const std::vector<PackerFile>& files) noexcept
+	{
+		constexpr std::string_view PassNames[] = { "Loose, first pass ", "Loose, second pass", "Pack, first pass  ", "Pack, second pass " };
+		BenchmarkPass passes[4];
+
+		{
+			Asset::AssetManager assetManager;
+			passes[0] = LoadAll(assetManager, args, files);
+			passes[1] = LoadAll(assetManager, args, files);
+
+			Asset::DerivedDataStats stats = assetManager.DerivedData().Stats();
+
+			std::cout << std::format(
+				"Loose models load through the DerivedDataCache, (Hits: {}, Misses: {}) so misses are imported from source.\n",
+				stats.NumHits, stats.NumMisses
+			);
+		}
+
+		{
+			Asset::AssetManager assetManager;
+
+			if (!assetManager.MountPack(args.PackPath, args.AssetDirectory))
+			{
+				std::cout << std::format("Failed to mount pack. Path: {}\n", args.PackPath.generic_string());
+				return 1;
+			}
+
+			passes[2] = LoadAll(assetManager, args, files);
+			passes[3] = LoadAll(assetManager, args, files);
+		}
+
+		for (size_t i = 0; i < std::size(passes); ++i)
+			std::cout << std::format(
+				"{} : {:9.3f} ms, ({} assets, {} texture bytes)\n",
+				PassNames[i], passes[i].Millis, passes[i].NumLoaded, passes[i].NumBytes
+			);
+
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace CMEngine::Tools;
+
+	PackerArgs args;
+
+	if (!ParseArgs(argc, argv, args))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::error_code error;
+	args.AssetDirectory = std::filesystem::absolute(args.AssetDirectory, error).lexically_normal();
+
+	if (!std::filesystem::is_directory(args.AssetDirectory, error))
+	{
+		std::cout << std::format("Asset directory doesn't exist. Path: {}\n", args.AssetDirectory.generic_string());
+		return 1;
+	}
+
+	std::vector<PackerFile> files = CollectFiles(args.AssetDirectory);
+
+	return args.IsBenchmark ? Benchmark(args, files) : Pack(args, files);
+}
\ No newline at end of file
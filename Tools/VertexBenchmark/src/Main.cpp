@@ -0,0 +1,191 @@
+#include "Asset/VertexInterleave.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <vector>
+
+/* Measures InterleaveVertices, (see VertexInterleave.hpp) against the per-vertex loop the importer used before it,
+ *   on random position, normal and texcoord streams laid out as assimp stores them. Both outputs are compared first.
+ *
+ * Each is timed writing into a destination that's already been written to, (how fast the loop itself is) and into
+ *   a freshly allocated one, (as the importer does, where first-touch page faults usually dominate) the best of
+ *   every iteration kept. */
+
+namespace CMEngine::Tools
+{
+	inline constexpr size_t G_DefaultNumVertices = 1'000'000;
+	inline constexpr uint32_t G_DefaultNumIterations = 20;
+
+	struct BenchmarkArgs
+	{
+		size_t NumVertices = G_DefaultNumVertices;
+		uint32_t NumIterations = G_DefaultNumIterations;
+	};
+
+	/* 3 floats per vertex, each. */
+	struct VertexStreams
+	{
+		std::vector<float> Positions;
+		std::vector<float> Normals;
+		std::vector<float> TexCoords;
+	};
+
+	static void PrintUsage() noexcept
+	{
+		std::cout <<
+			"Usage: VertexBenchmark [options]\n"
+			"\n"
+			"  --vertices <count>    Vertices interleaved per iteration. (1000000 by default)\n"
+			"  --iterations <count>  Of each case, the fastest is reported. (20 by default)\n";
+	}
+
+	template <typename Ty>
+	static [[nodiscard]] bool ParseNumber(std::string_view arg, Ty& outValue) noexcept
+	{
+		auto [pEnd, error] = std::from_chars(arg.data(), arg.data() + arg.size(), outValue);
+		return error == std::errc() && pEnd == arg.data() + arg.size() && outValue > 0;
+	}
+
+	static [[nodiscard]] bool ParseArgs(int argc, char** argv, BenchmarkArgs& outArgs) noexcept
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+			std::string_view value = i + 1 < argc ? argv[i + 1] : std::string_view();
+
+			if (arg == "--vertices" && ParseNumber(value, outArgs.NumVertices))
+				++i;
+			else if (arg == "--iterations" && ParseNumber(value, outArgs.NumIterations))
+				++i;
+			else
+			{
+				std::cout << std::format("Unknown or malformed option: {}\n", arg);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static [[nodiscard]] VertexStreams MakeStreams(size_t numVertices) noexcept
+	{
+		VertexStreams streams;
+		std::mt19937 generator(0x5EED);
+		std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+		for (std::vector<float>* pStream : { &streams.Positions, &streams.Normals, &streams.TexCoords })
+		{
+			pStream->resize(numVertices * 3);
+			std::generate(pStream->begin(), pStream->end(), [&]() { return distribution(generator); });
+		}
+
+		return streams;
+	}
+
+	/* What ModelImporterImpl::LoadVertices did before InterleaveVertices. */
+	static void InterleaveVerticesPerVertex(const VertexStreams& streams, std::vector<Asset::Vertex>& outVertices) noexcept
+	{
+		size_t numVertices = streams.Positions.size() / 3;
+
+		outVertices.clear();
+		outVertices.reserve(numVertices);
+
+		for (size_t i = 0; i < numVertices; ++i)
+		{
+			const float* pPos = streams.Positions.data() + i * 3;
+			const float* pNormal = streams.Normals.data() + i * 3;
+			const float* pTexCoord = streams.TexCoords.data() + i * 3;
+
+			outVertices.emplace_back(
+				Float3(pPos[0], pPos[1], pPos[2]),
+				Float3(pNormal[0], pNormal[1], pNormal[2]),
+				Float2(pTexCoord[0], pTexCoord[1])
+			);
+		}
+	}
+
+	static void InterleaveVerticesSIMD(const VertexStreams& streams, std::vector<Asset::Vertex>& outVertices) noexcept
+	{
+		outVertices.resize(streams.Positions.size() / 3);
+
+		Asset::InterleaveVertices(
+			streams.Positions.data(),
+			streams.Normals.data(),
+			streams.TexCoords.data(),
+			outVertices
+		);
+	}
+
+	/* Returns the fastest iteration, in millions of vertices per second. */
+	template <typename InterleaveFunc>
+	static [[nodiscard]] double Measure(const VertexStreams& streams, uint32_t numIterations, bool isWarm, InterleaveFunc&& interleave) noexcept
+	{
+		size_t numVertices = streams.Positions.size() / 3;
+		double bestSeconds = std::numeric_limits<double>::max();
+
+		std::vector<Asset::Vertex> vertices;
+
+		if (isWarm)
+			interleave(streams, vertices);
+
+		for (uint32_t i = 0; i < numIterations; ++i)
+		{
+			if (!isWarm)
+				std::vector<Asset::Vertex>().swap(vertices);
+
+			auto start = std::chrono::steady_clock::now();
+			interleave(streams, vertices);
+			auto end = std::chrono::steady_clock::now();
+
+			bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(end - start).count());
+		}
+
+		return static_cast<double>(numVertices) / bestSeconds / 1e6;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace CMEngine::Tools;
+	using CMEngine::Asset::Vertex;
+
+	BenchmarkArgs args;
+
+	if (!ParseArgs(argc, argv, args))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	VertexStreams streams = MakeStreams(args.NumVertices);
+
+	std::vector<Vertex> expected;
+	std::vector<Vertex> actual;
+	InterleaveVerticesPerVertex(streams, expected);
+	InterleaveVerticesSIMD(streams, actual);
+
+	if (std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(Vertex)) != 0)
+	{
+		std::cout << "InterleaveVertices doesn't match the per-vertex loop.\n";
+		return 1;
+	}
+
+	std::cout << std::format("{} vertices, best of {} iterations, in M vertices/s:\n", args.NumVertices, args.NumIterations);
+
+	for (bool isWarm : { true, false })
+		std::cout << std::format(
+			"  {} : InterleaveVertices {:7.1f}, per-vertex loop {:7.1f}\n",
+			isWarm ? "Written destination  " : "Allocated destination",
+			Measure(streams, args.NumIterations, isWarm, InterleaveVerticesSIMD),
+			Measure(streams, args.NumIterations, isWarm, InterleaveVerticesPerVertex)
+		);
+
+	return 0;
+}
\ No newline at end of file
@@ -8,4 +8,13 @@
 #define CM_NORMAL   float3
 
 /* Common datatype for texture coordinates. */
-#define CM_TEXCOORD float2
\ No newline at end of file
+#define CM_TEXCOORD float2
+
+/* Common datatype for material table entries. (Must match Asset::MaterialData) */
+struct CM_MaterialData
+{
+    float4 BaseColor;
+    float Metallic;
+    float Roughness;
+    float2 Padding;
+};
\ No newline at end of file
@@ -6,14 +6,11 @@ struct PSInput
     CM_POSITION WorldPos : TEXCOORD0;
     CM_NORMAL Normal : TEXCOORD1;
     CM_TEXCOORD TexCoord : TEXCOORD2;
+    nointerpolation uint MaterialIndex : TEXCOORD3;
 };
 
-cbuffer MaterialCB : register(b0)
-{
-    float4 BaseColor;
-    float Metallic;
-    float Roughness;
-};
+/* Every material in use, indexed per instance. (t0 is reserved for textures) */
+StructuredBuffer<CM_MaterialData> g_Materials : register(t1);
 
 // cbuffer CameraCB : register(b1)
 // {
@@ -37,7 +34,9 @@ float4 main( PSInput input ) : SV_Target
     // float3 N = normalize(input.Normal);
     // float3 V = normalize(CameraPos - input.WorldPos);
 
-    float3 color = BaseColor.rgb;
+    CM_MaterialData material = g_Materials[input.MaterialIndex];
+
+    float3 color = material.BaseColor.rgb;
 
     /* Simple Lambert diffuse
     for (int i = 0; i < NumLights; i++)
@@ -47,5 +46,5 @@ float4 main( PSInput input ) : SV_Target
         color += diff * Lights[i].Color;
     } */
 
-    return float4(color, BaseColor.a);
+    return float4(color, material.BaseColor.a);
 }
@@ -0,0 +1,4 @@
+// Gltf_Basic_Quantized_VS.hlsl
+/* Gltf_Basic_VS, reading Asset::QuantizedVertex's instead. */
+#define CM_QUANTIZED_VERTICES
+#include "Gltf_Basic_VS.hlsl"
\ No newline at end of file
@@ -0,0 +1,92 @@
+// Gltf_Common_VS.hlsl
+/* Shared by every Gltf_*_VS variant, which only differ in how they decode their instance data.
+ *   Defining CM_QUANTIZED_VERTICES before including switches the vertex inputs to Asset::QuantizedVertex. */
+#include "Common.hlsl"
+
+#ifdef CM_QUANTIZED_VERTICES
+    /* unorm16x4 within the mesh's AABB, which is folded into the instance transform. */
+    #define CM_VERTEX_POSITION float4
+
+    /* Octahedral snorm16x2 */
+    #define CM_VERTEX_NORMAL float2
+#else
+    #define CM_VERTEX_POSITION CM_POSITION
+    #define CM_VERTEX_NORMAL CM_NORMAL
+#endif
+
+/* UVs are float16 when quantized, but the input assembler already widens them. */
+#define CM_VERTEX_TEXCOORD CM_TEXCOORD
+
+struct VSOutput
+{
+    CM_POSITION WorldPos : TEXCOORD0;
+    CM_NORMAL Normal : TEXCOORD1;
+    CM_TEXCOORD TexCoord : TEXCOORD2;
+    nointerpolation uint MaterialIndex : TEXCOORD3;
+    nointerpolation uint TextureSlice : TEXCOORD4;
+    CM_POSITION_H PositionH : SV_Position; // (homogenous clip space)
+};
+
+cbuffer CB_CameraProj : register(b0)
+{
+    /* NOTE: THE ORDER OF THIS IS SUPERRRR IMPORTANT, MUST MATCH C++ SIDE OR COMPUTER WILL GO BOOM!!! */
+    column_major float4x4 View;
+    column_major float4x4 Projection;
+};
+
+CM_POSITION DecodePosition(CM_POSITION position)
+{
+    return position;
+}
+
+CM_POSITION DecodePosition(float4 position)
+{
+    return position.xyz;
+}
+
+CM_NORMAL DecodeNormal(CM_NORMAL normal)
+{
+    return normal;
+}
+
+/* Must match DecodeOctahedral in VertexQuantization.cpp */
+CM_NORMAL DecodeNormal(float2 encoded)
+{
+    float3 normal = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = saturate(-normal.z);
+
+    normal.xy += (normal.xy >= 0.0f) ? -t : t; // Per component
+    return normalize(normal);
+}
+
+/* @modelMatrix is the first three rows of the (column major) model matrix, as the last is always (0, 0, 0, 1). */
+VSOutput TransformVertex(
+    CM_POSITION position,
+    CM_NORMAL normal,
+    CM_TEXCOORD texCoord,
+    float3x4 modelMatrix,
+    uint materialIndex,
+    uint textureSlice
+)
+{
+    VSOutput output;
+
+    /* Transform position in world space.
+     * 
+     * Note: Matrix * Vector is valid if the Matrix is column major. If the matrix is row major,
+     *   the correct order is Vector * Matrix.
+     */
+    output.WorldPos = mul(modelMatrix, float4(position, 1.0f)); // Column major
+
+    /* Transform normal in world space. (Ignores translation, and assumes uniform scaling) */
+    output.Normal = normalize(mul((float3x3)modelMatrix, normal));
+
+    output.TexCoord = texCoord;
+    output.MaterialIndex = materialIndex;
+    output.TextureSlice = textureSlice;
+
+    output.PositionH = mul(float4(output.WorldPos, 1.0f), View);
+    output.PositionH = mul(output.PositionH, Projection);
+
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,4 @@
+// Gltf_Compact_Quantized_VS.hlsl
+/* Gltf_Compact_VS, reading Asset::QuantizedVertex's instead. */
+#define CM_QUANTIZED_VERTICES
+#include "Gltf_Compact_VS.hlsl"
\ No newline at end of file
@@ -0,0 +1,36 @@
+// Gltf_Compact_VS.hlsl
+#include "Gltf_Common_VS.hlsl"
+
+/* Must match CompactBatchInstance. */
+#define CM_INSTANCE_MATERIAL_BITS 24
+#define CM_INSTANCE_MATERIAL_MASK ((1u << CM_INSTANCE_MATERIAL_BITS) - 1u)
+
+struct VSInput
+{
+    CM_VERTEX_POSITION Position : POSITION;
+    CM_VERTEX_NORMAL Normal : NORMAL;
+    CM_VERTEX_TEXCOORD TexCoord : TEXCOORD0;
+    float4 Inst_Transform_0 : INST_TRANSFORM0;
+    float4 Inst_Transform_1 : INST_TRANSFORM1;
+    float4 Inst_Transform_2 : INST_TRANSFORM2;
+    uint Inst_MaterialFlags : INST_MATERIAL_FLAGS; /* Material index in the low 24 bits, flags in the high 8 bits. */
+    uint Inst_Texture : INST_TEXTURE;
+};
+
+VSOutput main( VSInput input )
+{
+    float3x4 modelMatrix = float3x4(
+        input.Inst_Transform_0,
+        input.Inst_Transform_1,
+        input.Inst_Transform_2
+    );
+
+    return TransformVertex(
+        DecodePosition(input.Position),
+        DecodeNormal(input.Normal),
+        input.TexCoord,
+        modelMatrix,
+        input.Inst_MaterialFlags & CM_INSTANCE_MATERIAL_MASK,
+        input.Inst_Texture
+    );
+}
\ No newline at end of file
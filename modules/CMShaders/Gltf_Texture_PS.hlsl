@@ -6,19 +6,20 @@ struct PSInput
     CM_POSITION WorldPos : TEXCOORD0;
     CM_NORMAL Normal : TEXCOORD1;
     CM_TEXCOORD TexCoord : TEXCOORD2;
+    nointerpolation uint MaterialIndex : TEXCOORD3;
+    nointerpolation uint TextureSlice : TEXCOORD4;
 };
 
-cbuffer MaterialCB : register(b0)
-{
-    float4 BaseColor;
-    float Metallic;
-    float Roughness;
-};
+/* Every material in use, indexed per instance. (t0 is reserved for textures) */
+StructuredBuffer<CM_MaterialData> g_Materials : register(t1);
 
-Texture2D g_Texture : register(t0);
+/* Every texture of the batch's size, indexed per instance. */
+Texture2DArray g_Textures : register(t0);
 SamplerState g_SamplerState : register(s0);
 
 float4 main( PSInput input ) : SV_Target
 {
-    return BaseColor * g_Texture.Sample(g_SamplerState, input.TexCoord);
+    CM_MaterialData material = g_Materials[input.MaterialIndex];
+
+    return material.BaseColor * g_Textures.Sample(g_SamplerState, float3(input.TexCoord, input.TextureSlice));
 }
\ No newline at end of file